@@ -0,0 +1,174 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \brief Times the vmap ray/triangle kernels on a random triangle soup.
+
+    The triangles are cut into leaves of the size the mesh BIH uses, every
+    ray is then tested against every leaf with the scalar and the SSE kernel
+    of VMAP::TrianglePack. Both have to report the same hits and distances.
+
+    Usage: vmap-bench [triangles=100000] [rays=1000] [leaf size=3]
+*/
+
+#include "TrianglePack.h"
+#include "WorldModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using G3D::Vector3;
+
+namespace
+{
+    /**
+     * @brief Range of the pack a mesh BIH leaf would cover
+     *
+     */
+    struct Leaf
+    {
+        uint32 first; /**< index of the first triangle in the pack */
+        uint32 count; /**< number of triangles from first on */
+    };
+
+    typedef bool (VMAP::TrianglePack::*Kernel)(const G3D::Ray&, uint32, uint32, float&) const;
+
+    /**
+     * @brief Runs every ray against every leaf, the closest distance of each ray ends in distances
+     *
+     * @return double seconds taken
+     */
+    double RunKernel(VMAP::TrianglePack const& pack, Kernel kernel, std::vector<G3D::Ray> const& rays,
+                     std::vector<Leaf> const& leaves, float maxDist, std::vector<float>& distances)
+    {
+        distances.assign(rays.size(), maxDist);
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rays.size(); ++r)
+        {
+            for (size_t l = 0; l < leaves.size(); ++l)
+            {
+                (pack.*kernel)(rays[r], leaves[l].first, leaves[l].count, distances[r]);
+            }
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void Report(char const* name, double seconds, uint64 tests, uint32 hits)
+    {
+        printf("%-7s %9.3f %12.1f %8u\n", name, seconds, tests / seconds / 1000000.0, hits);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 triangles = argc > 1 ? uint32(atoi(argv[1])) : 100000;
+    uint32 rayCount = argc > 2 ? uint32(atoi(argv[2])) : 1000;
+    uint32 leafSize = argc > 3 ? uint32(atoi(argv[3])) : 3;
+
+    if (!triangles || !rayCount || !leafSize)
+    {
+        printf("Usage: %s [triangles] [rays] [leaf size]\n", argv[0]);
+        return 1;
+    }
+
+    ///- small triangles spread over a 200 yard cube, about the size of a large WMO group
+    std::mt19937 rng(4334);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> edge(-2.0f, 2.0f);
+
+    std::vector<Vector3> vertices;
+    std::vector<VMAP::MeshTriangle> meshTriangles;
+    std::vector<uint32> order;
+    for (uint32 i = 0; i < triangles; ++i)
+    {
+        Vector3 v0(coord(rng), coord(rng), coord(rng));
+        vertices.push_back(v0);
+        vertices.push_back(v0 + Vector3(edge(rng), edge(rng), edge(rng)));
+        vertices.push_back(v0 + Vector3(edge(rng), edge(rng), edge(rng)));
+        meshTriangles.push_back(VMAP::MeshTriangle(i * 3, i * 3 + 1, i * 3 + 2));
+        order.push_back(i);
+    }
+
+    VMAP::TrianglePack pack;
+    pack.build(vertices, meshTriangles, order);
+
+    ///- leaves of 1 to leafSize triangles, the mesh BIH rarely fills all of them
+    std::vector<Leaf> leaves;
+    std::uniform_int_distribution<uint32> leafCount(1, leafSize);
+    for (uint32 first = 0; first < triangles;)
+    {
+        Leaf leaf = { first, std::min(leafCount(rng), triangles - first) };
+        leaves.push_back(leaf);
+        first += leaf.count;
+    }
+
+    std::vector<G3D::Ray> rays;
+    for (uint32 i = 0; i < rayCount; ++i)
+    {
+        Vector3 from(coord(rng), coord(rng), coord(rng));
+        Vector3 to(coord(rng), coord(rng), coord(rng));
+        rays.push_back(G3D::Ray::fromOriginAndDirection(from, (to - from).direction()));
+    }
+
+    uint64 tests = uint64(rayCount) * triangles;
+    printf("%u triangles in %u leaves, %u rays\n", triangles, uint32(leaves.size()), rayCount);
+    printf("kernel    seconds  Mtests/s     hits\n");
+
+    std::vector<float> scalar;
+    double seconds = RunKernel(pack, &VMAP::TrianglePack::IntersectRayScalar, rays, leaves, 1000.0f, scalar);
+    uint32 hits = 0;
+    for (size_t r = 0; r < scalar.size(); ++r)
+    {
+        hits += scalar[r] < 1000.0f ? 1 : 0;
+    }
+    Report("scalar", seconds, tests, hits);
+
+#ifdef VMAP_TRIANGLE_SSE
+    std::vector<float> sse;
+    seconds = RunKernel(pack, &VMAP::TrianglePack::IntersectRaySSE, rays, leaves, 1000.0f, sse);
+    uint32 mismatches = 0;
+    hits = 0;
+    for (size_t r = 0; r < sse.size(); ++r)
+    {
+        hits += sse[r] < 1000.0f ? 1 : 0;
+        mismatches += sse[r] != scalar[r] ? 1 : 0;
+    }
+    Report("sse", seconds, tests, hits);
+
+    if (mismatches)
+    {
+        printf("%u rays got a different distance from the SSE kernel\n", mismatches);
+        return 1;
+    }
+#else
+    printf("built without SSE2, only the scalar kernel is available\n");
+#endif
+
+    return 0;
+}
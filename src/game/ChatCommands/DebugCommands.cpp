@@ -37,6 +37,7 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "MapManager.h"
 
 /**********************************************************************
      CommandTable : debugCommandTable
@@ -878,6 +879,49 @@ bool ChatHandler::HandleDebugArenaCommand(char* /*args*/)
     return true;
 }
 
+/// Show the DB script scheduler state of every map that ran or has pending script steps
+bool ChatHandler::HandleDebugDbScriptsCommand(char* /*args*/)
+{
+    uint32 maps = 0;
+
+    MapManager::MapMapType const& mapList = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = mapList.begin(); itr != mapList.end(); ++itr)
+    {
+        Map* map = itr->second;
+        Map::ScriptScheduleStats const& stats = map->GetScriptScheduleStats();
+        if (!stats.executed && !map->GetScheduledScriptCount())
+        {
+            continue;
+        }
+
+        PSendSysMessage("Map %u instance %u: %u pending, " UI64FMTD " executed, lag avg " UI64FMTD " ms max %u ms",
+                        map->GetId(), map->GetInstanceId(), uint32(map->GetScheduledScriptCount()), stats.executed,
+                        stats.executed ? stats.totalLag / stats.executed : 0, stats.maxLag);
+        ++maps;
+    }
+
+    if (!maps)
+    {
+        SendSysMessage("No map has run DB scripts yet.");
+    }
+
+    return true;
+}
+
+/// Show how many packet buffers were taken from the per thread caches instead of the heap
+bool ChatHandler::HandleDebugPacketPoolCommand(char* /*args*/)
+{
+    ByteBufferPool::Stats stats;
+    ByteBufferPool::GetStats(stats);
+
+    PSendSysMessage("Packet buffers: " UI64FMTD " pooled allocations, " UI64FMTD " reused (%.1f%%), " UI64FMTD " over %u bytes",
+                    stats.allocations, stats.reused, stats.allocations ? stats.reused * 100.0 / stats.allocations : 0.0,
+                    stats.oversized, uint32(ByteBufferPool::MAX_BLOCK_SIZE));
+    PSendSysMessage("Cached: " UI64FMTD " blocks, " UI64FMTD " KB in %u threads, " UI64FMTD " blocks returned to the heap",
+                    stats.cachedBlocks, stats.cachedBytes / 1024, stats.threads, stats.released);
+    return true;
+}
+
 bool ChatHandler::HandleDebugSpellCheckCommand(char* /*args*/)
 {
     sLog.outString("Check expected in code spell properties base at table 'spell_check' content...");
@@ -440,6 +440,15 @@ void ChatHandler::HandleCharacterDeletedRestoreHelper(DeletedInfo const& delInfo
 
     CharacterDatabase.PExecute("UPDATE `characters` SET `name`='%s', `account`='%u', `deleteDate`=NULL, `deleteInfos_Name`=NULL, `deleteInfos_Account`=NULL WHERE `deleteDate` IS NOT NULL AND `guid` = %u",
                                delInfo.name.c_str(), delInfo.accountId, delInfo.lowguid);
+
+    ObjectGuid guid(HIGHGUID_PLAYER, delInfo.lowguid);
+    CharacterIdentity identity;
+    if (sObjectMgr.GetCharacterIdentity(guid, identity))
+    {
+        identity.name = delInfo.name;
+        identity.account = delInfo.accountId;
+        sObjectMgr.SetCharacterIdentity(guid, identity);
+    }
 }
 
 /**
@@ -648,6 +657,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, ObjectGuid player_guid, u
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE `characters` SET `level` = '%u', `xp` = 0 WHERE `guid` = '%u'", newlevel, player_guid.GetCounter());
+        sObjectMgr.SetCharacterIdentityLevel(player_guid, newlevel);
     }
 }
 
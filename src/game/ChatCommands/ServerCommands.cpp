@@ -29,6 +29,7 @@
 #include "SystemConfig.h"
 #include "BattleGroundMgr.h"
 #include "UpdateTime.h"
+#include "OpcodeStats.h"
 #include "revision.h"
 
  /**********************************************************************
@@ -81,6 +82,119 @@ bool ChatHandler::HandleServerMotdCommand(char* /*args*/)
     return true;
 }
 
+/// Packet processing class named by inplace|world|map, -1 if the name is none of them
+static int32 GetPacketProcessingByName(char const* name)
+{
+    for (int32 i = PROCESS_INPLACE; i <= PROCESS_THREADSAFE; ++i)
+    {
+        if (strcmp(name, GetPacketProcessingName(PacketProcessing(i))) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/// Show the opcodes with the most handler time, per packet processing class
+bool ChatHandler::HandleServerOpcodeStatsCommand(char* args)
+{
+    uint32 limit = 10;
+    int32 onlyProcessing = -1;
+
+    // [inplace|world|map] [count], a leading count followed by the class is accepted as well
+    if (ExtractUInt32(&args, limit))
+    {
+        if (char* processingName = ExtractLiteralArg(&args))
+        {
+            onlyProcessing = GetPacketProcessingByName(processingName);
+            if (onlyProcessing < 0)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        if (char* processingName = ExtractLiteralArg(&args))
+        {
+            onlyProcessing = GetPacketProcessingByName(processingName);
+            if (onlyProcessing < 0)
+            {
+                return false;
+            }
+        }
+
+        if (!ExtractOptUInt32(&args, limit, 10))
+        {
+            return false;
+        }
+    }
+
+    uint32 period = sOpcodeStats.GetPeriod();
+    PSendSysMessage("Opcode handler statistics for the last %s", secsToTimeString(period, TimeFormat::ShortText).c_str());
+
+    OpcodeStats::RowList rows;
+    for (int32 i = PROCESS_INPLACE; i <= PROCESS_THREADSAFE; ++i)
+    {
+        if (onlyProcessing >= 0 && onlyProcessing != i)
+        {
+            continue;
+        }
+
+        sOpcodeStats.GetRows(rows, i);
+
+        uint64 count = 0;
+        uint64 totalUs = 0;
+        for (OpcodeStats::RowList::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+        {
+            count += itr->count;
+            totalUs += itr->totalUs;
+        }
+
+        PSendSysMessage("[%s] %u opcodes, " UI64FMTD " calls, " UI64FMTD " ms", GetPacketProcessingName(PacketProcessing(i)),
+                        uint32(rows.size()), count, totalUs / 1000);
+
+        for (size_t j = 0; j < rows.size() && j < limit; ++j)
+        {
+            OpcodeStats::Row const& row = rows[j];
+            PSendSysMessage("  %-36s calls " UI64FMTD " (%.1f/s) total " UI64FMTD " ms avg " UI64FMTD " us max " UI64FMTD " us bytes " UI64FMTD,
+                            LookupOpcodeName(row.opcode), row.count, period ? double(row.count) / period : 0.0,
+                            row.totalUs / 1000, row.totalUs / row.count, row.maxUs, row.bytes);
+        }
+    }
+
+    return true;
+}
+
+/// Write the opcode handler statistics to a CSV file
+bool ChatHandler::HandleServerOpcodeStatsCsvCommand(char* args)
+{
+    char* filename = ExtractQuotedOrLiteralArg(&args);
+    if (!filename)
+    {
+        return false;
+    }
+
+    if (!sOpcodeStats.WriteCsv(filename))
+    {
+        PSendSysMessage("Could not open %s for writing", filename);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Opcode handler statistics written to %s", filename);
+    return true;
+}
+
+/// Clear the opcode handler statistics
+bool ChatHandler::HandleServerOpcodeStatsResetCommand(char* /*args*/)
+{
+    sOpcodeStats.Reset();
+    SendSysMessage("Opcode handler statistics cleared");
+    return true;
+}
+
 bool ChatHandler::HandleServerShutDownCancelCommand(char* /*args*/)
 {
     sWorld.ShutdownCancel();
@@ -149,16 +149,14 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid)
     }
     else
     {
-        //                                                      0       1
-        QueryResult* result = CharacterDatabase.PQuery("SELECT `name`, `class` FROM `characters` WHERE `guid`='%u'", playerGuid.GetCounter());
-        if (!result)
+        CharacterIdentity identity;
+        if (!sObjectMgr.GetCharacterIdentity(playerGuid, identity))
         {
             return false;
         }
 
-        plName = (*result)[0].GetCppString();
-        plClass = (*result)[1].GetUInt8();
-        delete result;
+        plName = identity.name;
+        plClass = identity.playerClass;
 
         // check if player already in arenateam of that size
         if (Player::GetArenaTeamIdFromDB(playerGuid, GetType()) != 0)
@@ -144,6 +144,21 @@ void Camera::Event_Moved()
     m_source->GetViewPoint().m_grid->AddWorldObject(this);
 }
 
+void Camera::Event_Relocated()
+{
+    m_gridRef.UpdatePosition(m_source->GetPositionX(), m_source->GetPositionY());
+}
+
+float Camera::GetPositionX() const
+{
+    return m_source->GetPositionX();
+}
+
+float Camera::GetPositionY() const
+{
+    return m_source->GetPositionY();
+}
+
 void Camera::UpdateVisibilityOf(WorldObject* target)
 {
     m_owner.UpdateVisibilityOf(m_source, target);
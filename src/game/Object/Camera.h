@@ -44,6 +44,9 @@ class Camera
         ~Camera();
 
         WorldObject* GetBody() { return m_source;}
+        // position of the viewpoint, cached by the grid cell the camera is linked into
+        float GetPositionX() const;
+        float GetPositionY() const;
         Player* GetOwner() { return &m_owner;}
 
         // set camera's view to any worldobject
@@ -68,6 +71,7 @@ class Camera
         void Event_AddedToWorld();
         void Event_RemovedFromWorld();
         void Event_Moved();
+        void Event_Relocated();
         void Event_ViewPointVisibilityChanged();
 
         Player& m_owner;
@@ -133,6 +137,11 @@ class ViewPoint
             CameraCall(&Camera::Event_Moved);
         }
 
+        void Event_Relocated()
+        {
+            CameraCall(&Camera::Event_Relocated);
+        }
+
         void Event_ViewPointVisibilityChanged()
         {
             CameraCall(&Camera::Event_ViewPointVisibilityChanged);
@@ -90,6 +90,7 @@ class Corpse : public WorldObject
         bool lootForBody;
 
         GridReference<Corpse>& GetGridRef() { return m_gridRef; }
+        void UpdateGridPosition() override { m_gridRef.UpdatePosition(GetPositionX(), GetPositionY()); WorldObject::UpdateGridPosition(); }
 
         bool IsExpired(time_t t) const;
     private:
@@ -227,7 +227,7 @@ void Creature::AddToWorld()
 #ifdef ENABLE_ELUNA
     if (!inWorld)
     {
-        sEluna->OnAddToWorld(this);
+        GetEluna()->OnAddToWorld(this);
     }
 #endif /* ENABLE_ELUNA */
 }
@@ -237,7 +237,7 @@ void Creature::RemoveFromWorld()
 #ifdef ENABLE_ELUNA
     if (IsInWorld())
     {
-        sEluna->OnRemoveFromWorld(this);
+        GetEluna()->OnRemoveFromWorld(this);
     }
 #endif /* ENABLE_ELUNA */
 
@@ -301,6 +301,8 @@ void Creature::RemoveCorpse()
         m_respawnTime = time(NULL) + respawnDelay;
     }
 
+    ScheduleRespawn();
+
     float x, y, z, o;
     GetRespawnCoord(x, y, z, &o);
     GetMap()->CreatureRelocation(this, x, y, z, o);
@@ -625,59 +627,8 @@ void Creature::Update(uint32 update_diff, uint32 diff)
             sLog.outError("Creature (GUIDLow: %u Entry: %u ) in wrong state: JUST_DEAD (1)", GetGUIDLow(), GetEntry());
             break;
         case DEAD:
-        {
-            if (m_respawnTime <= time(NULL) && (!m_isSpawningLinked || GetMap()->GetCreatureLinkingHolder()->CanSpawn(this)))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "Respawning...");
-                m_respawnTime = 0;
-                m_aggroDelay = sWorld.getConfig(CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY);
-                lootForPickPocketed = false;
-                lootForBody         = false;
-                lootForSkin         = false;
-
-                // Clear possible auras having IsDeathPersistent() attribute
-                RemoveAllAuras();
-
-                if (m_originalEntry != GetEntry())
-                {
-                    // need preserver gameevent state
-                    GameEventCreatureData const* eventData = sGameEventMgr.GetCreatureUpdateDataForActiveEvent(GetGUIDLow());
-                    UpdateEntry(m_originalEntry, TEAM_NONE, NULL, eventData);
-                }
-
-                CreatureInfo const* cinfo = GetCreatureInfo();
-
-                SelectLevel(cinfo);
-                UpdateAllStats();  // to be sure stats is correct regarding level of the creature
-                SetUInt32Value(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_NONE);
-                if (m_IsDeadByDefault)
-                {
-                    SetDeathState(JUST_DIED);
-                    SetHealth(0);
-                    i_motionMaster.Clear();
-                    clearUnitState(UNIT_STAT_ALL_STATE);
-                    LoadCreatureAddon(true);
-                }
-                else
-                {
-                    SetDeathState(JUST_ALIVED);
-                }
-
-                // Call AI respawn virtual function
-                if (AI())
-                {
-                    AI()->JustRespawned();
-                }
-
-                if (m_isCreatureLinkingTrigger)
-                {
-                    GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_RESPAWN, this);
-                }
-
-                GetMap()->Add(this);
-            }
+            // respawn is scheduled with the map, see Creature::RespawnIfDue()
             break;
-        }
         case CORPSE:
         {
             Unit::Update(update_diff, diff);
@@ -1846,6 +1797,12 @@ bool Creature::LoadFromDB(uint32 guidlow, Map* map)
 
     AIM_Initialize();
 
+    // pending respawn, dead by default or waiting for the linked master
+    if (m_deathState == DEAD)
+    {
+        ScheduleRespawn();
+    }
+
     // Creature Linking, Initial load is handled like respawn
     if (m_isCreatureLinkingTrigger && IsAlive())
     {
@@ -2089,6 +2046,94 @@ void Creature::Respawn()
             GetMap()->GetPersistentState()->SaveCreatureRespawnTime(GetGUIDLow(), 0);
         }
         m_respawnTime = time(NULL);                         // respawn at next tick
+        ScheduleRespawn();
+    }
+}
+
+void Creature::SetRespawnTime(uint32 respawn)
+{
+    m_respawnTime = respawn ? time(NULL) + respawn : 0;
+
+    if (m_deathState == DEAD)
+    {
+        ScheduleRespawn();
+    }
+}
+
+void Creature::RespawnIfDue()
+{
+    if (m_deathState != DEAD || IsPet())
+    {
+        return;
+    }
+
+    time_t now = time(NULL);
+    if (m_respawnTime > now)                                // respawn time changed after scheduling
+    {
+        GetMap()->ScheduleRespawn(GetObjectGuid(), m_respawnTime);
+        return;
+    }
+
+    if (m_isSpawningLinked && !GetMap()->GetCreatureLinkingHolder()->CanSpawn(this))
+    {
+        GetMap()->ScheduleRespawn(GetObjectGuid(), now + 1);
+        return;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "Respawning...");
+    m_respawnTime = 0;
+    m_aggroDelay = sWorld.getConfig(CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY);
+    lootForPickPocketed = false;
+    lootForBody         = false;
+    lootForSkin         = false;
+
+    // Clear possible auras having IsDeathPersistent() attribute
+    RemoveAllAuras();
+
+    if (m_originalEntry != GetEntry())
+    {
+        // need preserver gameevent state
+        GameEventCreatureData const* eventData = sGameEventMgr.GetCreatureUpdateDataForActiveEvent(GetGUIDLow());
+        UpdateEntry(m_originalEntry, TEAM_NONE, NULL, eventData);
+    }
+
+    CreatureInfo const* cinfo = GetCreatureInfo();
+
+    SelectLevel(cinfo);
+    UpdateAllStats();  // to be sure stats is correct regarding level of the creature
+    SetUInt32Value(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_NONE);
+    if (m_IsDeadByDefault)
+    {
+        SetDeathState(JUST_DIED);
+        SetHealth(0);
+        i_motionMaster.Clear();
+        clearUnitState(UNIT_STAT_ALL_STATE);
+        LoadCreatureAddon(true);
+    }
+    else
+    {
+        SetDeathState(JUST_ALIVED);
+    }
+
+    // Call AI respawn virtual function
+    if (AI())
+    {
+        AI()->JustRespawned();
+    }
+
+    if (m_isCreatureLinkingTrigger)
+    {
+        GetMap()->GetCreatureLinkingHolder()->DoCreatureLinkingEvent(LINKING_EVENT_RESPAWN, this);
+    }
+
+    GetMap()->Add(this);
+}
+
+void Creature::ScheduleRespawn()
+{
+    if (!IsPet())
+    {
+        GetMap()->ScheduleRespawn(GetObjectGuid(), m_respawnTime);
     }
 }
 
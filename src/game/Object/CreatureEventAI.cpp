@@ -82,15 +82,15 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
     {
         if (itr->Event.action[2].type != ACTION_T_NONE)
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1, itr->Event.action[2].type, itr->Event.action[2].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetEventTimer(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1, itr->Event.action[2].type, itr->Event.action[2].raw.param1);
         }
         else if (itr->Event.action[1].type != ACTION_T_NONE)
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) actions[type(param1)]: %2u(%5u)  --  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetEventTimer(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1, itr->Event.action[1].type, itr->Event.action[1].raw.param1);
         }
         else
         {
-            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) action[type(param1)]:  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", itr->Time / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1);
+            reader.PSendSysMessage("%u Type%3u (%s) Timer(%3us) action[type(param1)]:  %2u(%5u)", itr->Event.event_id, itr->Event.event_type, itr->Enabled ? "On" : "Off", GetEventTimer(*itr) / 1000, itr->Event.action[0].type, itr->Event.action[0].raw.param1);
         }
     }
 }
@@ -102,11 +102,35 @@ inline bool IsEventFlagsFitForNormalMap(uint8 eFlags)
            (eFlags & EFLAG_DIFFICULTY_0);
 }
 
+inline bool IsTimerBasedEvent(EventAI_Type type)
+{
+    switch (type)
+    {
+        case EVENT_T_TIMER_IN_COMBAT:
+        case EVENT_T_TIMER_OOC:
+        case EVENT_T_TIMER_GENERIC:
+        case EVENT_T_MANA:
+        case EVENT_T_HP:
+        case EVENT_T_TARGET_HP:
+        case EVENT_T_TARGET_CASTING:
+        case EVENT_T_FRIENDLY_HP:
+        case EVENT_T_AURA:
+        case EVENT_T_TARGET_AURA:
+        case EVENT_T_MISSING_AURA:
+        case EVENT_T_TARGET_MISSING_AURA:
+        case EVENT_T_RANGE:
+        case EVENT_T_ENERGY:
+            return true;
+        default:
+            return false;
+    }
+}
+
 CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
+    m_EventClock(0),
     m_Phase(0),
     m_MeleeEnabled(true),
     m_DynamicMovement(false),
-    m_HasOOCLoSEvent(false),
     m_InvinceabilityHpLevel(0),
     m_throwAIEventMask(0),
     m_throwAIEventStep(0),
@@ -173,11 +197,6 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
                 if (storeEvent)
                 {
                     m_CreatureEventAIList.push_back(CreatureEventAIHolder(*i));
-                    // Cache for fast use
-                    if (i->event_type == EVENT_T_OOC_LOS)
-                    {
-                        m_HasOOCLoSEvent = true;
-                    }
                 }
             }
         }
@@ -186,36 +205,46 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
     {
         sLog.outErrorEventAI("EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
     }
-}
 
-#define LOG_PROCESS_EVENT                                                                                                       \
-    DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: Event type %u (script %u) triggered for %s (invoked by %s)",    \
-                     pHolder.Event.event_type, pHolder.Event.event_id, m_creature->GetGuidStr().c_str(), pActionInvoker ? pActionInvoker->GetGuidStr().c_str() : "<no invoker>")
+    // Group the events by type so hooks only visit the events they can trigger
+    uint16 typeCount[EVENT_T_END] = { 0 };
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    {
+        ++typeCount[i->Event.event_type];
+    }
 
-inline bool IsTimerBasedEvent(EventAI_Type type)
-{
-    switch (type)
+    m_EventTypeStart[0] = 0;
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
     {
-        case EVENT_T_TIMER_IN_COMBAT:
-        case EVENT_T_TIMER_OOC:
-        case EVENT_T_TIMER_GENERIC:
-        case EVENT_T_MANA:
-        case EVENT_T_HP:
-        case EVENT_T_TARGET_HP:
-        case EVENT_T_TARGET_CASTING:
-        case EVENT_T_FRIENDLY_HP:
-        case EVENT_T_AURA:
-        case EVENT_T_TARGET_AURA:
-        case EVENT_T_MISSING_AURA:
-        case EVENT_T_TARGET_MISSING_AURA:
-        case EVENT_T_RANGE:
-        case EVENT_T_ENERGY:
-            return true;
-        default:
-            return false;
+        m_EventTypeStart[type + 1] = m_EventTypeStart[type] + typeCount[type];
+    }
+
+    m_EventsByType.resize(m_CreatureEventAIList.size());
+    uint16 typeFill[EVENT_T_END];
+    memcpy(typeFill, m_EventTypeStart, sizeof(typeFill));
+    for (uint16 index = 0; index < m_CreatureEventAIList.size(); ++index)
+    {
+        EventAI_Type type = m_CreatureEventAIList[index].Event.event_type;
+        m_EventsByType[typeFill[type]++] = index;
+
+        if (IsTimerBasedEvent(type))
+        {
+            if (type == EVENT_T_TIMER_OOC || type == EVENT_T_TIMER_GENERIC)
+            {
+                m_TimerEvents.push_back(index);
+            }
+            else
+            {
+                m_CombatTimerEvents.push_back(index);
+            }
+        }
     }
 }
 
+#define LOG_PROCESS_EVENT                                                                                                       \
+    DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: Event type %u (script %u) triggered for %s (invoked by %s)",    \
+                     pHolder.Event.event_type, pHolder.Event.event_id, m_creature->GetGuidStr().c_str(), pActionInvoker ? pActionInvoker->GetGuidStr().c_str() : "<no invoker>")
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker, Creature* pAIEventSender /*=NULL*/)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -572,6 +601,12 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
             break;
     }
 
+    // Time was zero on entry, a repeat timer set above has to be queued before actions can change the phase
+    if (pHolder.Time)
+    {
+        ScheduleEventTimer(pHolder);
+    }
+
     // Disable non-repeatable events
     if (!(pHolder.Event.event_flags & EFLAG_REPEATABLE))
     {
@@ -898,7 +933,8 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             break;
         case ACTION_T_THREAT_ALL_PCT:       //14
         {
-            ThreatList const& threatList = m_creature->GetThreatManager().getThreatList();
+            // copy, references can be removed from the list below
+            ThreatList threatList = m_creature->GetThreatManager().getThreatList();
             for (ThreatList::const_iterator i = threatList.begin(); i != threatList.end(); ++i)
                 if (Unit* Temp = m_creature->GetMap()->GetUnit((*i)->getUnitGuid()))
                 {
@@ -991,7 +1027,7 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             }
             break;
         case ACTION_T_SET_PHASE:            //22
-            m_Phase = action.set_phase.phase;
+            SetPhase(action.set_phase.phase);
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: ACTION_T_SET_PHASE - script %u for %s, phase is now %u", EventId, m_creature->GetGuidStr().c_str(), m_Phase);
             break;
         case ACTION_T_INC_PHASE:            //23
@@ -1000,16 +1036,16 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             if (new_phase < 0)
             {
                 sLog.outErrorEventAI("Event %d decrease Phase under 0. CreatureEntry = %d", EventId, m_creature->GetEntry());
-                m_Phase = 0;
+                SetPhase(0);
             }
             else if (new_phase >= MAX_PHASE)
             {
                 sLog.outErrorEventAI("Event %d incremented Phase above %u. Phase mask can not be used with phases past %u. CreatureEntry = %d", EventId, MAX_PHASE - 1, MAX_PHASE - 1, m_creature->GetEntry());
-                m_Phase = MAX_PHASE - 1;
+                SetPhase(MAX_PHASE - 1);
             }
             else
             {
-                m_Phase = new_phase;
+                SetPhase(new_phase);
             }
 
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: ACTION_T_INC_PHASE - script %u for %s, phase is now %u", EventId, m_creature->GetGuidStr().c_str(), m_Phase);
@@ -1071,13 +1107,13 @@ void CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             }
             break;
         case ACTION_T_RANDOM_PHASE:             //30
-            m_Phase = GetRandActionParam(rnd, action.random_phase.phase1, action.random_phase.phase2, action.random_phase.phase3);
+            SetPhase(GetRandActionParam(rnd, action.random_phase.phase1, action.random_phase.phase2, action.random_phase.phase3));
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "CreatureEventAI: ACTION_T_RANDOM_PHASE - script %u for %s, phase is now %u", EventId, m_creature->GetGuidStr().c_str(), m_Phase);
             break;
         case ACTION_T_RANDOM_PHASE_RANGE:       //31
             if (action.random_phase_range.phaseMax > action.random_phase_range.phaseMin)
             {
-                m_Phase = action.random_phase_range.phaseMin + (rnd % (action.random_phase_range.phaseMax - action.random_phase_range.phaseMin));
+                SetPhase(action.random_phase_range.phaseMin + (rnd % (action.random_phase_range.phaseMax - action.random_phase_range.phaseMin)));
             }
             else
             {
@@ -1303,20 +1339,24 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
 {
     Reset();
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset generic timers
+    for (uint32 j = m_EventTypeStart[EVENT_T_TIMER_GENERIC]; j < m_EventTypeStart[EVENT_T_TIMER_GENERIC + 1]; ++j)
     {
-        // Reset generic timer
-        if (i->Event.event_type == EVENT_T_TIMER_GENERIC)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-            if (i->UpdateRepeatTimer(m_creature, i->Event.timer.initialMin, i->Event.timer.initialMax))
-            {
-                i->Enabled = true;
-            }
+            holder.Enabled = true;
+            ScheduleEventTimer(holder);
         }
-        // Handle Spawned Events
-        else if (SpawnedEventConditionsCheck((*i).Event))
+    }
+
+    // Handle Spawned Events
+    for (uint32 j = m_EventTypeStart[EVENT_T_SPAWNED]; j < m_EventTypeStart[EVENT_T_SPAWNED + 1]; ++j)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        if (SpawnedEventConditionsCheck(holder.Event))
         {
-            ProcessEvent(*i);
+            ProcessEvent(holder);
         }
     }
 }
@@ -1327,38 +1367,24 @@ void CreatureEventAI::Reset()
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
 
-    // Reset all events to enabled
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset all out of combat timers
+    // TODO: verify if the other events should be enabled here (ex. aggro yell), instead of enable this in void Aggro()
+    for (uint32 j = m_EventTypeStart[EVENT_T_TIMER_OOC]; j < m_EventTypeStart[EVENT_T_TIMER_OOC + 1]; ++j)
     {
-        CreatureEventAI_Event const& event = i->Event;
-        switch (event.event_type)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-                // Reset all out of combat timers
-            case EVENT_T_TIMER_OOC:
-            {
-                if (i->UpdateRepeatTimer(m_creature, event.timer.initialMin, event.timer.initialMax))
-                {
-                    i->Enabled = true;
-                }
-                break;
-            }
-            default:
-            // TODO: enable below code line / verify this is correct to enable events previously disabled (ex. aggro yell), instead of enable this in void Aggro()
-            //i->Enabled = true;
-            //i->Time = 0;
-            break;
+            holder.Enabled = true;
+            ScheduleEventTimer(holder);
         }
     }
 }
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_REACHED_HOME]; j < m_EventTypeStart[EVENT_T_REACHED_HOME + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]]);
     }
 
     Reset();
@@ -1379,12 +1405,9 @@ void CreatureEventAI::EnterEvadeMode()
     m_creature->SetLootRecipient(NULL);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_EVADE]; j < m_EventTypeStart[EVENT_T_EVADE + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_EVADE)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]]);
     }
 }
 
@@ -1407,16 +1430,13 @@ void CreatureEventAI::JustDied(Unit* killer)
     }
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_DEATH]; j < m_EventTypeStart[EVENT_T_DEATH + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_DEATH)
-        {
-            ProcessEvent(*i, killer);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]], killer);
     }
 
     // reset phase after any death state events
-    m_Phase = 0;
+    SetPhase(0);
 }
 
 void CreatureEventAI::KilledUnit(Unit* victim)
@@ -1426,45 +1446,33 @@ void CreatureEventAI::KilledUnit(Unit* victim)
         return;
     }
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_KILL]; j < m_EventTypeStart[EVENT_T_KILL + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_KILL)
-        {
-            ProcessEvent(*i, victim);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]], victim);
     }
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_SUMMONED_UNIT]; j < m_EventTypeStart[EVENT_T_SUMMONED_UNIT + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_SUMMONED_JUST_DIED]; j < m_EventTypeStart[EVENT_T_SUMMONED_JUST_DIED + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (uint32 j = m_EventTypeStart[EVENT_T_SUMMONED_JUST_DESPAWN]; j < m_EventTypeStart[EVENT_T_SUMMONED_JUST_DESPAWN + 1]; ++j)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[m_EventsByType[j]], pUnit);
     }
 }
 
@@ -1472,13 +1480,13 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* pSender, U
 {
     MANGOS_ASSERT(pSender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 j = m_EventTypeStart[EVENT_T_RECEIVE_AI_EVENT]; j < m_EventTypeStart[EVENT_T_RECEIVE_AI_EVENT + 1]; ++j)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-            itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
-            {
-                ProcessEvent(*itr, pInvoker, pSender);
-            }
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
+        {
+            ProcessEvent(holder, pInvoker, pSender);
+        }
     }
 }
 
@@ -1499,12 +1507,13 @@ void CreatureEventAI::EnterCombat(Unit* enemy)
                 if (i->UpdateRepeatTimer(m_creature, event.timer.initialMin, event.timer.initialMax))
                 {
                     i->Enabled = true;
+                    ScheduleEventTimer(*i);
                 }
                 break;
                 // All normal events need to be re-enabled and their time set to 0
             default:
                 i->Enabled = true;
-                i->Time = 0;
+                CancelEventTimer(*i);
                 break;
         }
     }
@@ -1538,24 +1547,23 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     }
 
     // Check for OOC LOS Event
-    if (m_HasOOCLoSEvent && !m_creature->getVictim())
+    if (m_EventTypeStart[EVENT_T_OOC_LOS] != m_EventTypeStart[EVENT_T_OOC_LOS + 1] && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (uint32 j = m_EventTypeStart[EVENT_T_OOC_LOS]; j < m_EventTypeStart[EVENT_T_OOC_LOS + 1]; ++j)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                    ((!itr->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
+
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
                 {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                    {
-                        ProcessEvent(*itr, who);
-                    }
+                    ProcessEvent(holder, who);
                 }
             }
         }
@@ -1593,14 +1601,18 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || pSpell->Id == i->Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & i->Event.spell_hit.schoolMask)
-                {
-                    ProcessEvent(*i, pUnit);
-                }
+    for (uint32 j = m_EventTypeStart[EVENT_T_SPELLHIT]; j < m_EventTypeStart[EVENT_T_SPELLHIT + 1]; ++j)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
+        {
+            if (pSpell->SchoolMask & holder.Event.spell_hit.schoolMask)
+            {
+                ProcessEvent(holder, pUnit);
+            }
+        }
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1612,37 +1624,62 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     if (m_EventUpdateTime < diff)
     {
         m_EventDiff += diff;
+        m_EventClock += m_EventDiff;
 
-        // Check for time based events
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        // Timers held by the phase do not run, but still end when less than the elapsed time was left
+        for (size_t j = 0; j < m_PausedTimers.size();)
         {
-            // Decrement Timers
-            if (i->Time)
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[m_PausedTimers[j]];
+            if (holder.Time > m_EventDiff)
             {
-                if (i->Time > m_EventDiff)
-                {
-                    // Do not decrement timers if event can not trigger in this phase
-                    if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
-                    {
-                        i->Time -= m_EventDiff;
-                    }
-                }
-                else
-                {
-                    i->Time = 0;
-                }
+                ++j;
+                continue;
             }
 
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->Enabled) || i->Time)
+            holder.Time = 0;
+            holder.Paused = false;
+            m_PausedTimers[j] = m_PausedTimers.back();
+            m_PausedTimers.pop_back();
+        }
+
+        // End running timers, entries of rescheduled or cancelled timers are dropped
+        while (!m_EventTimers.empty() && m_EventTimers.top().deadline <= m_EventClock)
+        {
+            EventTimer const& timer = m_EventTimers.top();
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[timer.index];
+            if (holder.TimerGeneration == timer.generation && !holder.Paused)
             {
-                continue;
+                holder.Time = 0;
             }
+            m_EventTimers.pop();
+        }
 
-            if (IsTimerBasedEvent(i->Event.event_type))
+        // Check for time based events, combat only ones are not visited out of combat
+        EventIndexList::const_iterator itr = m_TimerEvents.begin();
+        EventIndexList::const_iterator combatItr = m_CombatTimerEvents.begin();
+        EventIndexList::const_iterator combatEnd = m_creature->IsInCombat() ? m_CombatTimerEvents.end() : combatItr;
+        while (itr != m_TimerEvents.end() || combatItr != combatEnd)
+        {
+            // merge both lists to keep the order of m_CreatureEventAIList
+            uint16 index;
+            if (combatItr == combatEnd || (itr != m_TimerEvents.end() && *itr < *combatItr))
             {
-                ProcessEvent(*i);
+                index = *itr++;
             }
+            else
+            {
+                index = *combatItr++;
+            }
+
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[index];
+
+            // Skip processing of events that have time remaining or are disabled
+            if (!holder.Enabled || holder.Time)
+            {
+                continue;
+            }
+
+            ProcessEvent(holder);
         }
 
         m_EventDiff = 0;
@@ -1685,6 +1722,108 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     }
 }
 
+void CreatureEventAI::SetPhase(uint8 phase)
+{
+    if (phase == m_Phase)
+    {
+        return;
+    }
+
+    m_Phase = phase;
+
+    // Hold the timers the new phase masks and restart the ones it releases
+    m_PausedTimers.clear();
+    for (uint16 index = 0; index < m_CreatureEventAIList.size(); ++index)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[index];
+        if (!holder.Time)
+        {
+            holder.Paused = false;
+            continue;
+        }
+
+        if (holder.Event.event_inverse_phase_mask & (1 << m_Phase))
+        {
+            if (!holder.Paused)
+            {
+                holder.Time = GetEventTimer(holder);
+                holder.Paused = holder.Time != 0;
+                ++holder.TimerGeneration;
+            }
+
+            if (holder.Paused)
+            {
+                m_PausedTimers.push_back(index);
+            }
+        }
+        else if (holder.Paused)
+        {
+            holder.Paused = false;
+            ScheduleEventTimer(holder);
+        }
+    }
+}
+
+void CreatureEventAI::ScheduleEventTimer(CreatureEventAIHolder& holder)
+{
+    ++holder.TimerGeneration;
+
+    if (!holder.Time)
+    {
+        return;
+    }
+
+    if (holder.Event.event_inverse_phase_mask & (1 << m_Phase))
+    {
+        // a paused holder is already listed
+        if (!holder.Paused)
+        {
+            holder.Paused = true;
+            m_PausedTimers.push_back(uint16(&holder - &m_CreatureEventAIList[0]));
+        }
+        return;
+    }
+
+    holder.Paused = false;
+    holder.Deadline = m_EventClock + holder.Time;
+
+    // Entries of rescheduled timers stay until their deadline, rebuild once they clearly outnumber the events
+    if (m_EventTimers.size() > 4 * m_CreatureEventAIList.size())
+    {
+        EventTimerQueue timers;
+        for (uint16 index = 0; index < m_CreatureEventAIList.size(); ++index)
+        {
+            CreatureEventAIHolder const& other = m_CreatureEventAIList[index];
+            if (other.Time && !other.Paused && &other != &holder)
+            {
+                EventTimer timer = { other.Deadline, other.TimerGeneration, index };
+                timers.push(timer);
+            }
+        }
+        m_EventTimers.swap(timers);
+    }
+
+    EventTimer timer = { holder.Deadline, holder.TimerGeneration, uint16(&holder - &m_CreatureEventAIList[0]) };
+    m_EventTimers.push(timer);
+}
+
+void CreatureEventAI::CancelEventTimer(CreatureEventAIHolder& holder)
+{
+    // a paused holder leaves m_PausedTimers at the next event update
+    holder.Time = 0;
+    ++holder.TimerGeneration;
+}
+
+uint32 CreatureEventAI::GetEventTimer(CreatureEventAIHolder const& holder) const
+{
+    if (!holder.Time || holder.Paused)
+    {
+        return holder.Time;
+    }
+
+    return holder.Deadline > m_EventClock ? uint32(holder.Deadline - m_EventClock) : 0;
+}
+
 bool CreatureEventAI::IsVisible(Unit* pl) const
 {
     return m_creature->IsWithinDist(pl, sWorld.getConfig(CONFIG_FLOAT_SIGHT_MONSTER))
@@ -1828,21 +1967,19 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(std::list<Creature*>& _list, flo
 
 void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
 {
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 j = m_EventTypeStart[EVENT_T_RECEIVE_EMOTE]; j < m_EventTypeStart[EVENT_T_RECEIVE_EMOTE + 1]; ++j)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_EMOTE)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[m_EventsByType[j]];
+        if (holder.Event.receive_emote.emoteId != text_emote)
         {
-            if (itr->Event.receive_emote.emoteId != text_emote)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            PlayerCondition pcon(0, itr->Event.receive_emote.condition, itr->Event.receive_emote.conditionValue1, itr->Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(0, holder.Event.receive_emote.condition, holder.Event.receive_emote.conditionValue1, holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
@@ -30,6 +30,9 @@
 #include "CreatureAI.h"
 #include "Unit.h"
 
+#include <functional>
+#include <queue>
+
 class Player;
 class WorldObject;
 
@@ -620,12 +623,16 @@ typedef UNORDERED_MAP<uint32, CreatureEventAI_Summon> CreatureEventAI_Summon_Map
 
 struct CreatureEventAIHolder
 {
-    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true) {}
+    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true), Deadline(0), TimerGeneration(0), Paused(false) {}
 
     CreatureEventAI_Event Event;
-    uint32 Time;
+    uint32 Time;                                            // non zero while the event waits, the remaining time only while Paused
     bool Enabled;
 
+    uint64 Deadline;                                        // event clock at which Time runs out, if not Paused
+    uint32 TimerGeneration;                                 // bumped on every reschedule, older heap entries are ignored
+    bool Paused;                                            // timer held by the inverse phase mask of the current phase
+
     // helper
     bool UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax);
 };
@@ -672,6 +679,11 @@ class CreatureEventAI : public CreatureAI
 
         bool SpawnedEventConditionsCheck(CreatureEventAI_Event const& event);
 
+        void SetPhase(uint8 phase);
+        void ScheduleEventTimer(CreatureEventAIHolder& holder);
+        void CancelEventTimer(CreatureEventAIHolder& holder);
+        uint32 GetEventTimer(CreatureEventAIHolder const& holder) const;
+
         Unit* DoSelectLowestHpFriendly(float range, uint32 MinHPDiff);
         void DoFindFriendlyMissingBuff(std::list<Creature*>& _list, float range, uint32 spellid);
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
@@ -683,12 +695,32 @@ class CreatureEventAI : public CreatureAI
 
         // Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
-        CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
+        CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid), not resized after construction
+
+        // Indexes into m_CreatureEventAIList, each kept in list order
+        typedef std::vector<uint16> EventIndexList;
+        EventIndexList m_EventsByType;                      // grouped by event type
+        uint16 m_EventTypeStart[EVENT_T_END + 1];           // first entry of each type in m_EventsByType
+        EventIndexList m_CombatTimerEvents;                 // timer based events that only trigger in combat
+        EventIndexList m_TimerEvents;                       // the other timer based events
+
+        struct EventTimer
+        {
+            uint64 deadline;
+            uint32 generation;
+            uint16 index;
+
+            bool operator>(EventTimer const& other) const { return deadline > other.deadline; }
+        };
+        typedef std::priority_queue<EventTimer, std::vector<EventTimer>, std::greater<EventTimer> > EventTimerQueue;
+
+        uint64 m_EventClock;                                // sum of the diffs of all event updates
+        EventTimerQueue m_EventTimers;                      // running timers, earliest deadline on top
+        EventIndexList m_PausedTimers;                      // timers held by the current phase
 
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
-        bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
         uint32 m_InvinceabilityHpLevel;                     // Minimal health level allowed at damage apply
 
         uint32 m_throwAIEventMask;                          // Automatically throw AIEvents that are encoded into this mask
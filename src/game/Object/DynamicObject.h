@@ -73,6 +73,7 @@ class DynamicObject : public WorldObject
         bool IsVisibleForInState(Player const* u, WorldObject const* viewPoint, bool inVisibleList) const override;
 
         GridReference<DynamicObject>& GetGridRef() { return m_gridRef; }
+        void UpdateGridPosition() override { m_gridRef.UpdatePosition(GetPositionX(), GetPositionY()); WorldObject::UpdateGridPosition(); }
 
     protected:
         uint32 m_spellId;
@@ -127,7 +127,7 @@ void GameObject::AddToWorld()
 #ifdef ENABLE_ELUNA
     if (!inWorld)
     {
-        sEluna->OnAddToWorld(this);
+        GetEluna()->OnAddToWorld(this);
     }
 #endif /* ENABLE_ELUNA */
 }
@@ -138,7 +138,7 @@ void GameObject::RemoveFromWorld()
     if (IsInWorld())
     {
 #ifdef ENABLE_ELUNA
-        sEluna->OnRemoveFromWorld(this);
+        GetEluna()->OnRemoveFromWorld(this);
 #endif /* ENABLE_ELUNA */
 
         // Notify the outdoor pvp script
@@ -272,7 +272,7 @@ bool GameObject::Create(uint32 guidlow, uint32 name_id, Map* map, uint32 phaseMa
 
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    sEluna->OnSpawn(this);
+    GetEluna()->OnSpawn(this);
 #endif /* ENABLE_ELUNA */
 
     // Notify the battleground or outdoor pvp script
@@ -306,7 +306,7 @@ void GameObject::Update(uint32 update_diff, uint32 p_time)
 
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    sEluna->UpdateAI(this, update_diff);
+    GetEluna()->UpdateAI(this, update_diff);
 #endif /* ENABLE_ELUNA */
 
     switch (m_lootState)
@@ -2224,7 +2224,7 @@ void GameObject::SetLootState(LootState state)
 {
     m_lootState = state;
 #ifdef ENABLE_ELUNA
-    sEluna->OnLootStateChanged(this, state);
+    GetEluna()->OnLootStateChanged(this, state);
 #endif /* ENABLE_ELUNA */
     UpdateCollisionState();
 }
@@ -2233,7 +2233,7 @@ void GameObject::SetGoState(GOState state)
 {
     SetByteValue(GAMEOBJECT_BYTES_1, 0, state);
 #ifdef ENABLE_ELUNA
-    sEluna->OnGameObjectStateChanged(this, state);
+    GetEluna()->OnGameObjectStateChanged(this, state);
 #endif /* ENABLE_ELUNA */
     UpdateCollisionState();
 }
@@ -2259,6 +2259,7 @@ void GameObject::UpdateCollisionState() const
     }
 
     m_model->enable(IsCollisionEnabled() ? GetPhaseMask() : 0);
+    GetMap()->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
@@ -2746,7 +2747,7 @@ void GameObject::ForceGameObjectHealth(int32 diff, Unit* caster)
 #ifdef ENABLE_ELUNA
         if (caster && caster->ToPlayer())
         {
-            sEluna->OnDamaged(this, caster->ToPlayer());
+            GetEluna()->OnDamaged(this, caster->ToPlayer());
         }
 #endif
         if (m_useTimes > uint32(-diff))
@@ -2799,7 +2800,7 @@ void GameObject::ForceGameObjectHealth(int32 diff, Unit* caster)
 #ifdef ENABLE_ELUNA
             if(caster && caster->ToPlayer())
             {
-                sEluna->OnDestroyed(this, caster->ToPlayer());
+                GetEluna()->OnDestroyed(this, caster->ToPlayer());
             }
 #endif
             RemoveFlag(GAMEOBJECT_FLAGS, GO_FLAG_UNK_9 | GO_FLAG_UNK_10);
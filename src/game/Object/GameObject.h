@@ -817,6 +817,7 @@ class GameObject : public WorldObject
         GameObjectAI* AI() const { return m_AI.get(); }
 
         GridReference<GameObject>& GetGridRef() { return m_gridRef; }
+        void UpdateGridPosition() override { m_gridRef.UpdatePosition(GetPositionX(), GetPositionY()); WorldObject::UpdateGridPosition(); }
 
         GameObjectModel* m_model;
 
@@ -102,6 +102,7 @@ Guild::Guild()
     m_accountsNumber = 0;
 
     m_CreatedDate = 0;
+    m_rosterBuildTime = 0;
 
     m_GuildBankMoney = 0;
 
@@ -269,9 +270,12 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         pl->SetGuildLevel(GetLevel());
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
+
+        m_onlineMembers[lowguid] = pl;
     }
 
     UpdateAccountsNumber();
+    InvalidateRoster();
 
     // Used by Eluna
 #ifdef ENABLE_ELUNA
@@ -289,6 +293,8 @@ void Guild::SetMOTD(std::string motd)
     CharacterDatabase.escape_string(motd);
     CharacterDatabase.PExecute("UPDATE `guild` SET `motd`='%s' WHERE `guildid`='%u'", motd.c_str(), m_Id);
 
+    InvalidateRoster();
+
     // Used by Eluna
 #ifdef ENABLE_ELUNA
     sEluna->OnMOTDChanged(this, motd);
@@ -303,6 +309,8 @@ void Guild::SetGINFO(std::string ginfo)
     CharacterDatabase.escape_string(ginfo);
     CharacterDatabase.PExecute("UPDATE `guild` SET `info`='%s' WHERE `guildid`='%u'", ginfo.c_str(), m_Id);
 
+    InvalidateRoster();
+
     // Used by Eluna
 #ifdef ENABLE_ELUNA
     sEluna->OnInfoChanged(this, ginfo);
@@ -567,6 +575,7 @@ void Guild::SetLeader(ObjectGuid guid)
 
     m_LeaderGuid = guid;
     slot->ChangeRank(GR_GUILDMASTER);
+    InvalidateRoster();
 
     CharacterDatabase.PExecute("UPDATE `guild` SET `leaderguid`='%u' WHERE `guildid`='%u'", guid.GetCounter(), m_Id);
 }
@@ -627,6 +636,8 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     members.erase(lowguid);
+    m_onlineMembers.erase(lowguid);
+    InvalidateRoster();
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -658,6 +669,7 @@ bool Guild::ChangeMemberRank(ObjectGuid guid, uint8 newRank)
         if (MemberSlot* member = GetMemberSlot(guid))
         {
             member->ChangeRank(newRank);
+            InvalidateRoster();
             return true;
         }
     return false;
@@ -679,11 +691,11 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
             pl->GetSession()->SendPacket(&data);
         }
@@ -697,11 +709,11 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, const std::string& msg,
         WorldPacket data;
         ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
 
-        for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+        for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
         {
-            Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+            Player* pl = itr->second;
 
-            if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
+            if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
             {
                 pl->GetSession()->SendPacket(&data);
             }
@@ -722,14 +734,14 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
         return;
     }
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+        if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
             pl->GetSession()->SendPacket(&data);
         }
@@ -740,14 +752,14 @@ void Guild::BroadcastAddonToOfficers(WorldSession* session, const std::string& m
 {
     if (session && session->GetPlayer() && HasRankRight(session->GetPlayer()->GetRank(), GR_RIGHT_OFFCHATSPEAK))
     {
-        for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-        {
-            WorldPacket data;
-            ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
+        WorldPacket data;
+        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
 
-            Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+        {
+            Player* pl = itr->second;
 
-            if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
+            if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
             {
                 pl->GetSession()->SendPacket(&data);
             }
@@ -757,31 +769,43 @@ void Guild::BroadcastAddonToOfficers(WorldSession* session, const std::string& m
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
-        {
-            player->GetSession()->SendPacket(packet);
-        }
+        itr->second->GetSession()->SendPacket(packet);
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        if (itr->second.RankId == rankId)
+        // online members get every rank change through MemberSlot::ChangeRank
+        if (itr->second->GetRank() == rankId)
         {
-            Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
-            {
-                player->GetSession()->SendPacket(packet);
-            }
+            itr->second->GetSession()->SendPacket(packet);
         }
     }
 }
 
+void Guild::AddOnlineMember(Player* player)
+{
+    if (!GetMemberSlot(player->GetObjectGuid()))
+    {
+        return;
+    }
+
+    m_onlineMembers[player->GetGUIDLow()] = player;
+    InvalidateRoster();
+}
+
+void Guild::RemoveOnlineMember(Player* player)
+{
+    if (m_onlineMembers.erase(player->GetGUIDLow()))
+    {
+        InvalidateRoster();
+    }
+}
+
 // add new event to all already connected guild memebers
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
 {
@@ -909,6 +933,8 @@ void Guild::SwitchRank(uint32 rankId, bool up)
         }
 
     CharacterDatabase.CommitTransaction();
+
+    InvalidateRoster();
 }
 
 std::string Guild::GetRankName(uint32 rankId)
@@ -994,19 +1020,50 @@ void Guild::Disband()
     sGuildMgr.RemoveGuild(m_Id);
 }
 
+/**
+ * Send the member list, to one member asking for it or to every member online
+ *
+ * The packet of a member request is resent unchanged for GUILD_ROSTER_CACHE_TIME
+ * seconds unless member data changed meanwhile, clients ask for it every few
+ * seconds while the guild window is open. Zone, level and away flags of online
+ * members are refreshed with that delay. A broadcast always builds the packet.
+ */
 void Guild::Roster(WorldSession* session /*= NULL*/)
+{
+    time_t now = time(NULL);
+    if (!session || now >= m_rosterBuildTime + GUILD_ROSTER_CACHE_TIME)
+    {
+        BuildRoster(m_rosterPacket);
+        m_rosterBuildTime = now;
+    }
+
+    if (session)
+    {
+        session->SendPacket(&m_rosterPacket);
+    }
+    else
+    {
+        BroadcastPacket(&m_rosterPacket);
+    }
+    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
+}
+
+void Guild::BuildRoster(WorldPacket& data)
 {
     ByteBuffer buffer;
 
     // we can only guess size
-    WorldPacket data(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + members.size() * 50));
+    data.Initialize(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + members.size() * 50));
     data.WriteBits(MOTD.length(), 11);
     data.WriteBits(members.size(), 18);
 
+    time_t now = time(NULL);
+
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
-        MemberSlot const member = itr->second;
-        Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        MemberSlot const& member = itr->second;
+        OnlineMemberMap::const_iterator online = m_onlineMembers.find(itr->first);
+        Player* player = online != m_onlineMembers.end() ? online->second : NULL;
 
         ObjectGuid guid = member.guid;
         data.WriteGuidMask<3, 4>(guid);
@@ -1058,7 +1115,7 @@ void Guild::Roster(WorldSession* session /*= NULL*/)
         buffer.WriteGuidBytes<5, 4>(guid);
         buffer << uint8(0);                             // unk
         buffer.WriteGuidBytes<1>(guid);
-        buffer << float(player ? 0.0f : float(time(NULL) - itr->second.LogoutTime) / DAY);
+        buffer << float(player ? 0.0f : float(now - member.LogoutTime) / DAY);
 
         buffer.WriteStringData(member.OFFnote);
 
@@ -1078,16 +1135,6 @@ void Guild::Roster(WorldSession* session /*= NULL*/)
     data << uint32(0);                                      // weekly rep cap
     data << secsToTimeBitFields(m_CreatedDate);
     data << uint32(0);
-
-    if (session)
-    {
-        session->SendPacket(&data);
-    }
-    else
-    {
-        BroadcastPacket(&data);
-    }
-    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
 }
 
 void Guild::Query(WorldSession* session)
@@ -32,10 +32,14 @@
 #include "Item.h"
 #include "ObjectAccessor.h"
 #include "SharedDefines.h"
+#include "WorldPacket.h"
+
+#include <map>
 
 class Item;
 
 #define GUILD_RANK_NONE         0xFF
+#define GUILD_ROSTER_CACHE_TIME 10                          // seconds a roster packet is resent as is to members asking for it
 
 enum GuildDefaultRanks
 {
@@ -398,14 +402,19 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = NULL)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
-                    if (player != except)
-                    {
-                        _do(player);
-                    }
+            for (OnlineMemberMap::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (itr->second != except)
+                {
+                    _do(itr->second);
+                }
         }
 
+        // members in world, the only players guild broadcasts are sent to
+        void AddOnlineMember(Player* player);
+        void RemoveOnlineMember(Player* player);
+        // next roster request builds the packet again, called on every change of member data
+        void InvalidateRoster() { m_rosterBuildTime = 0; }
+
         void CreateRank(std::string name, uint32 rights);
         void DelRank(uint32 rankId);
         void SwitchRank(uint32 rankId, bool up);
@@ -527,6 +536,12 @@ class Guild
 
         MemberList members;
 
+        typedef std::map<uint32, Player*> OnlineMemberMap;
+        OnlineMemberMap m_onlineMembers;                    // low guid -> player, filled at login and cleared at logout
+
+        WorldPacket m_rosterPacket;                         // last SMSG_GUILD_ROSTER sent
+        time_t m_rosterBuildTime;                           // 0 if m_rosterPacket is out of date
+
         typedef std::vector<GuildBankTab*> TabListMap;
         TabListMap m_TabListMap;
 
@@ -546,6 +561,7 @@ class Guild
     private:
         void UpdateAccountsNumber() { m_accountsNumber = 0;}// mark for lazy calculation at request in GetAccountsNumber
         void _ChangeRank(ObjectGuid guid, MemberSlot* slot, uint32 newRank);
+        void BuildRoster(WorldPacket& data);
 
         // used only from high level Swap/Move functions
         Item*  GetItem(uint8 TabId, uint8 SlotId);
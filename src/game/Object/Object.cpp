@@ -221,6 +221,34 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache& cache) const
+{
+    // update bits only differ between the object itself and other players (see Player::_SetUpdateBits)
+    ValuesUpdateCache::Block& block = cache.blocks[target == this ? ValuesUpdateCache::VISIBILITY_SELF : ValuesUpdateCache::VISIBILITY_OTHER];
+
+    if (!block.built)
+    {
+        block.data << uint8(UPDATETYPE_VALUES);
+        block.data << GetPackGUID();
+
+        UpdateMask updateMask;
+        updateMask.SetCount(m_valuesCount);
+
+        _SetUpdateBits(&updateMask, target);
+        BuildValuesUpdate(UPDATETYPE_VALUES, &block.data, &updateMask, target, &block.targetFields);
+        block.built = true;
+
+        data->AddUpdateBlock(block.data);
+        return;
+    }
+
+    size_t pos = data->AddUpdateBlock(block.data);
+    for (ValuesUpdateCache::TargetFieldList::const_iterator itr = block.targetFields.begin(); itr != block.targetFields.end(); ++itr)
+    {
+        data->PatchUpdateBlock(pos + itr->first, GetUpdateFieldValueFor(itr->second, target));
+    }
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetObjectGuid());
@@ -559,7 +587,7 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateCache::TargetFieldList* targetFields) const
 {
     if (!target)
     {
@@ -572,48 +600,20 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
         valuesCount = PLAYER_END_NOT_SELF;
     }
 
-    bool IsActivateToQuest = false;
-    bool IsPerCasterAuraState = false;
-
-    if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
+    // fields always sent, their value is selected per target below
+    if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+        updateMask->SetBit(GAMEOBJECT_DYNAMIC);
+        if (updatetype == UPDATETYPE_VALUES)
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-            {
-                IsActivateToQuest = true;
-            }
-
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
-        }
-        else if (isType(TYPEMASK_UNIT))
-        {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
+            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
         }
     }
-    else                                                    // case UPDATETYPE_VALUES
+    else if (isType(TYPEMASK_UNIT))
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-            {
-                IsActivateToQuest = true;
-            }
-
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
-            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
-        }
-        else if (isType(TYPEMASK_UNIT))
-        {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
+            updateMask->SetBit(UNIT_FIELD_AURASTATE);
         }
     }
 
@@ -629,54 +629,13 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
         {
             if (updateMask->GetBit(index))
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
-
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                        {
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                            {
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                            }
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                            {
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                            }
-                        }
-                    }
-
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
+                if (IsTargetDependentUpdateField(index))
                 {
-                    if (IsPerCasterAuraState)
+                    if (targetFields)
                     {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                        {
-                            *data << m_uint32Values[index];
-                        }
-                        else
-                        {
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                        }
-                    }
-                    else
-                    {
-                        *data << m_uint32Values[index];
+                        targetFields->push_back(ValuesUpdateCache::TargetFieldList::value_type(data->wpos(), index));
                     }
+                    *data << GetUpdateFieldValueFor(index, target);
                 }
                 // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
                 else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
@@ -693,48 +652,6 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
                 {
                     *data << uint32(m_floatValues[index]);
                 }
-
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                /* Hide loot animation for players that aren't permitted to loot the corpse */
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    uint32 send_value = m_uint32Values[index];
-
-                    /* Initiate pointer to creature so we can check loot */
-                    if (Creature* my_creature = (Creature*)this)
-                        /* If the creature is NOT fully looted */
-                        if (!my_creature->loot.isLooted())
-                            /* If the lootable flag is NOT set */
-                            if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
-                            {
-                                /* Update it on the creature */
-                                my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                                /* Update it in the packet */
-                                send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
-                            }
-
-                    /* If we're not allowed to loot the target, destroy the lootable flag */
-                    if (!target->isAllowedToLoot((Creature*)this))
-                        if (send_value & UNIT_DYNFLAG_LOOTABLE)
-                        {
-                            send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
-                        }
-
-                    /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
-                    bool is_tapped = target->IsTappedByMeOrMyGroup((Creature*)this);
-
-                    /* If the creature has tapped flag but is tapped by us, remove the flag */
-                    if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
-                    {
-                        send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
-                    }
-
-                    *data << send_value;
-                }
                 else
                 {
                     // send in current format (float as float, uint32 as uint32)
@@ -750,40 +667,13 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
             if (updateMask->GetBit(index))
             {
                 // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
+                if (IsTargetDependentUpdateField(index))
                 {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
-
-                    if (IsActivateToQuest)
+                    if (targetFields)
                     {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
+                        targetFields->push_back(ValuesUpdateCache::TargetFieldList::value_type(data->wpos(), index));
                     }
+                    *data << GetUpdateFieldValueFor(index, target);
                 }
                 else if (index == GAMEOBJECT_BYTES_1)
                 {
@@ -816,6 +706,169 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     }
 }
 
+bool Object::IsTargetDependentUpdateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+                return GetTypeId() == TYPEID_UNIT;
+            case UNIT_FIELD_AURASTATE:
+                return ((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE);
+            case UNIT_FIELD_FLAGS:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        return index == GAMEOBJECT_DYNAMIC;
+    }
+
+    return false;
+}
+
+uint32 Object::GetUpdateFieldValueFor(uint16 index, Player* target) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            {
+                uint32 appendValue = m_uint32Values[index];
+
+                if (GetTypeId() == TYPEID_UNIT)
+                {
+                    if (!target->canSeeSpellClickOn((Creature*)this))
+                    {
+                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+                    }
+
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
+                    {
+                        if (!((Creature*)this)->IsTrainerOf(target, false))
+                        {
+                            appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+                        }
+                    }
+
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+                    {
+                        if (target->getClass() != CLASS_HUNTER)
+                        {
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                        }
+                    }
+                }
+
+                return appendValue;
+            }
+            case UNIT_FIELD_AURASTATE:
+            {
+                // related pet caster aura state is only visible to the caster
+                if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE) &&
+                    !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                {
+                    return m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+                }
+
+                return m_uint32Values[index];
+            }
+            case UNIT_FIELD_FLAGS:
+            {
+                // Gamemasters should be always able to select units - remove not selectable flag
+                if (target->isGameMaster())
+                {
+                    return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+                }
+
+                return m_uint32Values[index];
+            }
+            case UNIT_DYNAMIC_FLAGS:
+            {
+                /* Hide loot animation for players that aren't permitted to loot the corpse */
+                if (GetTypeId() != TYPEID_UNIT)
+                {
+                    return m_uint32Values[index];
+                }
+
+                uint32 send_value = m_uint32Values[index];
+
+                /* Initiate pointer to creature so we can check loot */
+                if (Creature* my_creature = (Creature*)this)
+                    /* If the creature is NOT fully looted */
+                    if (!my_creature->loot.isLooted())
+                        /* If the lootable flag is NOT set */
+                        if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
+                        {
+                            /* Update it on the creature */
+                            my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+                            /* Update it in the packet */
+                            send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
+                        }
+
+                /* If we're not allowed to loot the target, destroy the lootable flag */
+                if (!target->isAllowedToLoot((Creature*)this))
+                    if (send_value & UNIT_DYNFLAG_LOOTABLE)
+                    {
+                        send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
+                    }
+
+                /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
+                bool is_tapped = target->IsTappedByMeOrMyGroup((Creature*)this);
+
+                /* If the creature has tapped flag but is tapped by us, remove the flag */
+                if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
+                {
+                    send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
+                }
+
+                return send_value;
+            }
+            default:
+                return m_uint32Values[index];
+        }
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT) && index == GAMEOBJECT_DYNAMIC)
+    {
+        // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+        //      most likely related to "can enter map" and then should be 0 if can not enter
+        // lo part is the dynamic flags, hi part is always -1
+        uint16 dynFlags = 0;                                // disable quest object
+
+        GameObject const* go = (GameObject const*)this;
+        if (!go->IsTransport() && (go->ActivateToQuest(target) || target->isGameMaster()))
+        {
+            switch (go->GetGoType())
+            {
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
+                    dynFlags = GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GENERIC:
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    dynFlags = GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                default:
+                    // unknown, not happen.
+                    break;
+            }
+        }
+
+        return uint32(dynFlags) | (uint32(uint16(-1)) << 16);
+    }
+
+    return m_uint32Values[index];
+}
+
 void Object::ClearUpdateMask(bool remove)
 {
     if (m_uint32Values)
@@ -1145,7 +1198,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1156,7 +1209,14 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (cache)
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    }
+    else
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    }
 }
 
 void Object::AddToClientUpdateList()
@@ -1247,6 +1307,8 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
     }
+
+    UpdateGridPosition();
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1259,6 +1321,8 @@ void WorldObject::Relocate(float x, float y, float z)
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
     }
+
+    UpdateGridPosition();
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1868,6 +1932,32 @@ void WorldObject::SendMessageToSetExcept(WorldPacket* data, Player const* skippe
     }
 }
 
+void WorldObject::SendMovementHeartbeatToSetExcept(WorldPacket* data, Player const* skipped_receiver, uint32 sequence) const
+{
+    if (!IsInWorld())
+    {
+        return;
+    }
+
+    Map* map = GetMap();
+    float nearDist = map->GetMovementLodNearDistance();
+    if (nearDist <= 0.0f || nearDist >= map->GetVisibilityDistance())
+    {
+        SendMessageToSetExcept(data, skipped_receiver);
+        return;
+    }
+
+    // mid range observers only get every MidRate-th heartbeat, farther ones none
+    float radius = nearDist;
+    if (sequence % sWorld.getConfig(CONFIG_UINT32_MOVEMENT_LOD_MID_RATE) == 0)
+    {
+        radius = std::min(map->GetMovementLodMidDistance(), map->GetVisibilityDistance());
+    }
+
+    MaNGOS::MovementLodDeliverer notifier(this, data, skipped_receiver, radius);
+    Cell::VisitWorldObjects(this, notifier, radius);
+}
+
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -1893,11 +1983,17 @@ void WorldObject::SetMap(Map* map)
 
 #ifdef ENABLE_ELUNA
     delete elunaEvents;
-    // On multithread replace this with a pointer to map's Eluna pointer stored in a map
-    elunaEvents = new ElunaEventProcessor(&Eluna::GEluna, this);
+    elunaEvents = new ElunaEventProcessor(map->GetElunaHandle(), this);
 #endif
 }
 
+#ifdef ENABLE_ELUNA
+Eluna* WorldObject::GetEluna() const
+{
+    return m_currMap ? m_currMap->GetEluna() : sEluna;
+}
+#endif /* ENABLE_ELUNA */
+
 void WorldObject::ResetMap()
 {
 #ifdef ENABLE_ELUNA
@@ -1967,7 +2063,7 @@ Creature* WorldObject::SummonCreature(uint32 id, float x, float y, float z, floa
 #ifdef ENABLE_ELUNA
     if (Unit* summoner = ToUnit())
     {
-        sEluna->OnSummoned(pCreature, summoner);
+        GetEluna()->OnSummoned(pCreature, summoner);
     }
 #endif /* ENABLE_ELUNA */
 
@@ -2334,13 +2430,14 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateCache i_valuesCache;                        // one serialization for all observers
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
         {
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas, &i_valuesCache);
         }
     }
 
@@ -2351,7 +2448,7 @@ struct WorldObjectChangeAccumulator
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
             {
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_valuesCache);
             }
         }
     }
@@ -92,12 +92,42 @@ class InstanceData;
 class TerrainInfo;
 #ifdef ENABLE_ELUNA
 class ElunaEventProcessor;
+class Eluna;
 #endif /* ENABLE_ELUNA */
 class TransportInfo;
 struct MangosStringLocale;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+/**
+ * Values update blocks of one object, serialized once per visibility class during one
+ * Object::BuildUpdateData pass and appended to the UpdateData of every observer.
+ * Fields whose value depends on the observer (npc flags, aura state, loot and quest
+ * activation flags, ...) are patched in after appending.
+ */
+struct ValuesUpdateCache
+{
+    enum Visibility
+    {
+        VISIBILITY_SELF     = 0,                            // observer is the object itself
+        VISIBILITY_OTHER    = 1,                            // any other player
+        MAX_VISIBILITY      = 2
+    };
+
+    typedef std::vector<std::pair<size_t, uint16> > TargetFieldList;
+
+    struct Block
+    {
+        Block() : built(false), data(0) {}
+
+        bool built;
+        ByteBuffer data;
+        TargetFieldList targetFields;                       // position in data, field index
+    };
+
+    Block blocks[MAX_VISIBILITY];
+};
+
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -196,6 +226,7 @@ class Object
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache& cache) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target, bool anim = false) const;
@@ -461,8 +492,10 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateCache::TargetFieldList* targetFields = NULL) const;
+        bool IsTargetDependentUpdateField(uint16 index) const;
+        uint32 GetUpdateFieldValueFor(uint16 index, Player* target) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache = NULL);
 
         uint16 m_objectType;
 
@@ -538,6 +571,11 @@ class WorldObject : public Object
 
         void Relocate(float x, float y, float z, float orientation);
         void Relocate(float x, float y, float z);
+        /**
+         * Refreshes the position cached by the grid cell storage for this object
+         * and for the cameras looking through it, called from Relocate.
+         */
+        virtual void UpdateGridPosition() { m_viewPoint.Event_Relocated(); }
 
         void SetOrientation(float orientation);
 
@@ -657,6 +695,11 @@ class WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket* data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket* data, float dist, bool self) const;
         void SendMessageToSetExcept(WorldPacket* data, Player const* skipped_receiver) const;
+        /**
+         * Relays a movement heartbeat to the visible set using the map's movement level of detail.
+         * \param sequence running heartbeat number of the mover, selects which heartbeats reach mid range observers
+         */
+        void SendMovementHeartbeatToSetExcept(WorldPacket* data, Player const* skipped_receiver, uint32 sequence) const;
 
         void MonsterSay(const char* text, uint32 language, Unit const* target = NULL) const;
         void MonsterYell(const char* text, uint32 language, Unit const* target = NULL) const;
@@ -718,6 +761,9 @@ class WorldObject : public Object
 
 #ifdef ENABLE_ELUNA
         ElunaEventProcessor* elunaEvents;
+
+        // Lua state of the current map, the global one while the object has no map
+        Eluna* GetEluna() const;
 #endif /* ENABLE_ELUNA */
 
     protected:
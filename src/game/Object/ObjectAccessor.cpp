@@ -56,18 +56,26 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
         return nullptr;
     }
 
-    return m_playersMap.FindWith([&guid, &inWorld](const ObjectGuid& g, Player* plr)->bool
-    {
-        return ((g == guid) && (plr->IsInWorld() || !inWorld));
-    });
+    Player* plr = m_playersMap.Find(guid);
+    return (plr && (plr->IsInWorld() || !inWorld)) ? plr : nullptr;
 }
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    return m_playersMap.FindWith([name](const ObjectGuid& g, Player* plr)->bool
-    {
-        return (plr->IsInWorld() && (::strcmp(name, plr->GetName()) == 0));
-    });
+    Player* plr = m_playerNames.Find(name);
+    return (plr && plr->IsInWorld()) ? plr : nullptr;
+}
+
+void ObjectAccessor::AddObject(Player* object)
+{
+    m_playersMap.Insert(object);
+    m_playerNames.Insert(object->GetName(), object);
+}
+
+void ObjectAccessor::RemoveObject(Player* object)
+{
+    m_playersMap.Remove(object);
+    m_playerNames.Remove(object->GetName(), object);
 }
 
 void ObjectAccessor::SaveAllPlayers()
@@ -130,9 +138,10 @@ Corpse* ObjectAccessor::GetCorpseForPlayerGUID(ObjectGuid guid)
 
 void Player2Corpse::Remove(Corpse* corpse)
 {
-    ACE_WRITE_GUARD(LockType, guard, i_lock)
+    Shard& shard = GetShard(corpse->GetOwnerGuid());
+    ACE_WRITE_GUARD(LockType, guard, shard.lock)
 
-    if( m_objectMap.end() == m_objectMap.find(corpse->GetOwnerGuid()))
+    if (shard.objects.end() == shard.objects.find(corpse->GetOwnerGuid()))
     {
         return;
     }
@@ -144,7 +153,7 @@ void Player2Corpse::Remove(Corpse* corpse)
     sObjectMgr.DeleteCorpseCellData(corpse->GetMapId(), cell_id, corpse->GetObjectGuid().GetCounter());
     corpse->RemoveFromWorld();
 
-    m_objectMap.erase(corpse->GetOwnerGuid());
+    shard.objects.erase(corpse->GetOwnerGuid());
 }
 
 
@@ -157,8 +166,9 @@ void ObjectAccessor::RemoveCorpse(Corpse* corpse)
 
 void Player2Corpse::Insert(Corpse* corpse)
 {
-    ACE_WRITE_GUARD(LockType, guard, i_lock)
-    m_objectMap[corpse->GetOwnerGuid()] = corpse;
+    Shard& shard = GetShard(corpse->GetOwnerGuid());
+    ACE_WRITE_GUARD(LockType, guard, shard.lock)
+    shard.objects[corpse->GetOwnerGuid()] = corpse;
 
     CellPair cell_pair = MaNGOS::ComputeCellPair(corpse->GetPositionX(), corpse->GetPositionY());
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
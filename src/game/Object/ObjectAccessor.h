@@ -49,74 +49,114 @@ class Unit;
 class WorldObject;
 class Map;
 
-template <class T>
+// Objects by key, split in shards with a lock each: lookups only contend with
+// writers of the same shard and walks never hold more than one shard at once
+template <class T, class Key = ObjectGuid>
 class HashMapHolder
 {
     public:
-        HashMapHolder(): i_lock{}, m_objectMap{}
+        enum { SHARD_COUNT = 16 };
+
+        HashMapHolder()
         {}
 
-        void Insert(T* o)
+        void Insert(T* o) { Insert(o->GetObjectGuid(), o); }
+        void Remove(T* o) { Remove(o->GetObjectGuid(), o); }
+
+        void Insert(Key const& key, T* o)
         {
-            ACE_WRITE_GUARD(LockType, guard, i_lock)
-            m_objectMap[o->GetObjectGuid()] = o;
+            Shard& shard = GetShard(key);
+            ACE_WRITE_GUARD(LockType, guard, shard.lock)
+            shard.objects[key] = o;
         }
 
-        void Remove(T* o)
+        // only removes the entry if it still points to o
+        void Remove(Key const& key, T* o)
         {
-            ACE_WRITE_GUARD(LockType, guard, i_lock)
-            m_objectMap.erase(o->GetObjectGuid());
+            Shard& shard = GetShard(key);
+            ACE_WRITE_GUARD(LockType, guard, shard.lock)
+            auto const itr = shard.objects.find(key);
+            if (itr != shard.objects.end() && itr->second == o)
+            {
+                shard.objects.erase(itr);
+            }
         }
 
-        T* Find(ObjectGuid guid)
+        T* Find(Key const& key)
         {
-            ACE_READ_GUARD_RETURN (LockType, guard, i_lock, nullptr)
-            auto const itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : nullptr;
+            Shard& shard = GetShard(key);
+            ACE_READ_GUARD_RETURN (LockType, guard, shard.lock, nullptr)
+            auto const itr = shard.objects.find(key);
+            return (itr != shard.objects.end()) ? itr->second : nullptr;
         }
 
-        // bool Predicate(const ObjectGuid& guid, T*)
+        // bool Predicate(const Key& key, T*)
         template <typename F>
         T* FindWith(F&& pred)
         {
-            ACE_READ_GUARD_RETURN (LockType, guard, i_lock, nullptr)
-            for(auto const& itr : m_objectMap)
+            for (auto& shard : m_shards)
             {
-                if(std::forward<F>(pred)(itr.first, itr.second))
+                ACE_READ_GUARD_RETURN (LockType, guard, shard.lock, nullptr)
+                for (auto const& itr : shard.objects)
                 {
-                    return itr.second;
+                    if (std::forward<F>(pred)(itr.first, itr.second))
+                    {
+                        return itr.second;
+                    }
                 }
             }
             return nullptr;
         }
 
-        // void Worker(const T*)
+        // void Worker(const T*), objects added or removed meanwhile in other shards may be missed
         template <typename F>
         void Do(F&& work)
         {
-            ACE_READ_GUARD(LockType, guard, i_lock)
-            for(auto const& itr : m_objectMap)
+            for (auto& shard : m_shards)
             {
-                std::forward<F>(work)(itr.second);
+                ACE_READ_GUARD(LockType, guard, shard.lock)
+                for (auto const& itr : shard.objects)
+                {
+                    std::forward<F>(work)(itr.second);
+                }
             }
         }
 
     protected:
         using LockType = ACE_RW_Thread_Mutex;
-        LockType i_lock;
-        std::unordered_map<ObjectGuid, T*> m_objectMap;
+        using MapType = std::unordered_map<Key, T*>;
+
+        struct Shard
+        {
+            LockType lock;
+            MapType objects;
+            char _cg[64];  //cache guard
+        };
+
+        Shard& GetShard(Key const& key)
+        {
+            // std::hash of integers is the value itself on most platforms, mix all bits into the shard
+            uint64 hash = uint64(std::hash<Key>()(key)) * UI64LIT(0x9E3779B97F4A7C15);
+            return m_shards[(hash >> 32) % SHARD_COUNT];
+        }
+
+        Shard m_shards[SHARD_COUNT];
 };
 
+// Corpses by owner guid
 class Player2Corpse: public HashMapHolder<Corpse>
 {
     public:
         Player2Corpse() : HashMapHolder<Corpse>(){}
         ~Player2Corpse()
         {
-            for (auto& itr : m_objectMap)
+            for (auto& shard : m_shards)
             {
-                itr.second->RemoveFromWorld();
-                delete itr.second;
+                for (auto& itr : shard.objects)
+                {
+                    itr.second->RemoveFromWorld();
+                    delete itr.second;
+                }
             }
         }
 
@@ -131,7 +171,7 @@ class ObjectAccessor
         ObjectAccessor& operator=(const ObjectAccessor&) = delete;
 
     public:
-        ObjectAccessor(): m_playersMap{}, m_corpsesMap{}, m_player2corpse{}
+        ObjectAccessor(): m_playersMap{}, m_playerNames{}, m_corpsesMap{}, m_player2corpse{}
         {}
 
         // Search player at any map in world and other objects at same map with `obj`
@@ -162,9 +202,9 @@ class ObjectAccessor
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { m_corpsesMap.Insert(object); }
-        void AddObject(Player* object) { m_playersMap.Insert(object); }
+        void AddObject(Player* object);
         void RemoveObject(Corpse* object) { m_corpsesMap.Remove(object); }
-        void RemoveObject(Player* object) { m_playersMap.Remove(object); }
+        void RemoveObject(Player* object);
 
         static ObjectAccessor& Instance()
         {
@@ -174,6 +214,7 @@ class ObjectAccessor
 
     private:
         HashMapHolder<Player> m_playersMap;
+        HashMapHolder<Player, std::string> m_playerNames;
         char _cg1[256];  //cache guard 1
         HashMapHolder<Corpse> m_corpsesMap;
         char _cg2[256]; //cache guard 2
@@ -1949,20 +1949,21 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
 // name must be checked to correctness (if received) before call this function
 ObjectGuid ObjectMgr::GetPlayerGuidByName(std::string name) const
 {
-    ObjectGuid guid;
+    std::wstring key;
+    if (!MakeCharacterNameKey(name, key))
+    {
+        return ObjectGuid();
+    }
 
-    CharacterDatabase.escape_string(name);
+    ACE_READ_GUARD_RETURN(CharacterIdentityLock, guard, m_CharacterIdentityLock, ObjectGuid())
 
-    // Player name safe to sending to DB (checked at login) and this function using
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `guid` FROM `characters` WHERE `name` = '%s'", name.c_str());
-    if (result)
+    CharacterNameIndex::const_iterator itr = m_CharacterNameIndex.find(key);
+    if (itr == m_CharacterNameIndex.end())
     {
-        guid = ObjectGuid(HIGHGUID_PLAYER, (*result)[0].GetUInt32());
-
-        delete result;
+        return ObjectGuid();
     }
 
-    return guid;
+    return ObjectGuid(HIGHGUID_PLAYER, itr->second);
 }
 
 bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
@@ -1974,18 +1975,14 @@ bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
         return true;
     }
 
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `name` FROM `characters` WHERE `guid` = '%u'", lowguid);
-
-    if (result)
+    CharacterIdentity identity;
+    if (!GetCharacterIdentity(guid, identity))
     {
-        name = (*result)[0].GetCppString();
-        delete result;
-        return true;
+        return false;
     }
 
-    return false;
+    name = identity.name;
+    return true;
 }
 
 Team ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
@@ -1996,18 +1993,13 @@ Team ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
         return Player::TeamForRace(player->getRace());
     }
 
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `race` FROM `characters` WHERE `guid` = '%u'", lowguid);
-
-    if (result)
+    CharacterIdentity identity;
+    if (!GetCharacterIdentity(guid, identity))
     {
-        uint8 race = (*result)[0].GetUInt8();
-        delete result;
-        return Player::TeamForRace(race);
+        return TEAM_NONE;
     }
 
-    return TEAM_NONE;
+    return Player::TeamForRace(identity.race);
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
@@ -2023,30 +2015,228 @@ uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
         return player->GetSession()->GetAccountId();
     }
 
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `account` FROM `characters` WHERE `guid` = '%u'", lowguid);
-    if (result)
+    CharacterIdentity identity;
+    if (!GetCharacterIdentity(guid, identity))
     {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
+        return 0;
     }
 
-    return 0;
+    return identity.account;
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `account` FROM `characters` WHERE `name` = '%s'", name.c_str());
-    if (result)
+    ObjectGuid guid = GetPlayerGuidByName(name);
+    if (!guid)
     {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
+        return 0;
     }
 
-    return 0;
+    return GetPlayerAccountIdByGUID(guid);
+}
+
+void ObjectMgr::LoadCharacterIdentities()
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    m_CharacterIdentities.clear();                          // need for reload case
+    m_CharacterNameIndex.clear();
+
+    //                                                0       1       2          3       4        5         6
+    QueryResult* result = CharacterDatabase.Query("SELECT `guid`, `name`, `account`, `race`, `class`, `gender`, `level` FROM `characters`");
+    if (!result)
+    {
+        BarGoLink bar(1);
+        bar.step();
+        sLog.outString(">> Loaded 0 character identities");
+        sLog.outString();
+        return;
+    }
+
+    BarGoLink bar(result->GetRowCount());
+
+    do
+    {
+        bar.step();
+        Field* fields = result->Fetch();
+
+        uint32 lowguid = fields[0].GetUInt32();
+
+        CharacterIdentity& identity = m_CharacterIdentities[lowguid];
+        identity.name = fields[1].GetCppString();
+        identity.account = fields[2].GetUInt32();
+        identity.race = fields[3].GetUInt8();
+        identity.playerClass = fields[4].GetUInt8();
+        identity.gender = fields[5].GetUInt8();
+        identity.level = fields[6].GetUInt32();
+
+        IndexCharacterName(lowguid, identity.name);
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    sLog.outString(">> Loaded " SIZEFMTD " character identities", m_CharacterIdentities.size());
+    sLog.outString();
+}
+
+bool ObjectMgr::GetCharacterIdentity(ObjectGuid guid, CharacterIdentity& identity) const
+{
+    ACE_READ_GUARD_RETURN(CharacterIdentityLock, guard, m_CharacterIdentityLock, false)
+
+    CharacterIdentityMap::const_iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr == m_CharacterIdentities.end())
+    {
+        return false;
+    }
+
+    identity = itr->second;
+    return true;
+}
+
+void ObjectMgr::SetCharacterIdentity(ObjectGuid guid, CharacterIdentity const& identity)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentity& stored = m_CharacterIdentities[guid.GetCounter()];
+    if (stored.name != identity.name)
+    {
+        UnindexCharacterName(guid.GetCounter(), stored.name);
+        IndexCharacterName(guid.GetCounter(), identity.name);
+    }
+
+    stored = identity;
+}
+
+void ObjectMgr::SetCharacterIdentity(Player* player)
+{
+    CharacterIdentity identity;
+    identity.name = player->GetName();
+    identity.account = player->GetSession()->GetAccountId();
+    identity.race = player->getRace();
+    identity.playerClass = player->getClass();
+    identity.gender = player->getGender();
+    identity.level = player->getLevel();
+
+    SetCharacterIdentity(player->GetObjectGuid(), identity);
+}
+
+void ObjectMgr::SetCharacterIdentityName(ObjectGuid guid, std::string const& name)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentityMap::iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr == m_CharacterIdentities.end())
+    {
+        return;
+    }
+
+    UnindexCharacterName(guid.GetCounter(), itr->second.name);
+    itr->second.name = name;
+    IndexCharacterName(guid.GetCounter(), name);
+}
+
+void ObjectMgr::SetCharacterIdentityLevel(ObjectGuid guid, uint32 level)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentityMap::iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr != m_CharacterIdentities.end())
+    {
+        itr->second.level = level;
+    }
+}
+
+void ObjectMgr::SetCharacterIdentityGender(ObjectGuid guid, uint8 gender)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentityMap::iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr != m_CharacterIdentities.end())
+    {
+        itr->second.gender = gender;
+    }
+}
+
+void ObjectMgr::SetCharacterIdentityDeleted(ObjectGuid guid)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentityMap::iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr == m_CharacterIdentities.end())
+    {
+        return;
+    }
+
+    // same as the `characters` row, the name is free again and the account unlinked
+    UnindexCharacterName(guid.GetCounter(), itr->second.name);
+    itr->second.name.clear();
+    itr->second.account = 0;
+}
+
+void ObjectMgr::RemoveCharacterIdentity(ObjectGuid guid)
+{
+    ACE_WRITE_GUARD(CharacterIdentityLock, guard, m_CharacterIdentityLock)
+
+    CharacterIdentityMap::iterator itr = m_CharacterIdentities.find(guid.GetCounter());
+    if (itr == m_CharacterIdentities.end())
+    {
+        return;
+    }
+
+    UnindexCharacterName(guid.GetCounter(), itr->second.name);
+    m_CharacterIdentities.erase(itr);
+}
+
+bool ObjectMgr::MakeCharacterNameKey(std::string const& name, std::wstring& key)
+{
+    // `characters`.`name` is compared case insensitive by the DB
+    if (name.empty() || !Utf8toWStr(name, key))
+    {
+        return false;
+    }
+
+    wstrToLower(key);
+    return true;
+}
+
+void ObjectMgr::IndexCharacterName(uint32 lowguid, std::string const& name)
+{
+    std::wstring key;
+    if (!MakeCharacterNameKey(name, key))
+    {
+        return;
+    }
+
+    // a character loaded with a taken name (dump import) must not hide the owner while its rename is pending
+    CharacterNameIndex::iterator itr = m_CharacterNameIndex.find(key);
+    if (itr != m_CharacterNameIndex.end() && itr->second != lowguid)
+    {
+        CharacterIdentityMap::const_iterator owner = m_CharacterIdentities.find(itr->second);
+        std::wstring ownerKey;
+        if (owner != m_CharacterIdentities.end() && MakeCharacterNameKey(owner->second.name, ownerKey) && ownerKey == key)
+        {
+            return;
+        }
+    }
+
+    m_CharacterNameIndex[key] = lowguid;
+}
+
+void ObjectMgr::UnindexCharacterName(uint32 lowguid, std::string const& name)
+{
+    std::wstring key;
+    if (!MakeCharacterNameKey(name, key))
+    {
+        return;
+    }
+
+    // only when the name was not taken by another character meanwhile
+    CharacterNameIndex::iterator itr = m_CharacterNameIndex.find(key);
+    if (itr != m_CharacterNameIndex.end() && itr->second == lowguid)
+    {
+        m_CharacterNameIndex.erase(itr);
+    }
 }
 
 void ObjectMgr::LoadItemLocales()
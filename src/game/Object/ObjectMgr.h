@@ -526,6 +526,20 @@ struct HotfixInfo
 
 typedef std::vector<HotfixInfo> HotfixData;
 
+/**
+ * @brief Row of `characters` kept in memory so offline players are known without a query
+ *
+ */
+struct CharacterIdentity
+{
+    std::string name; /**< empty for deleted characters kept by CharDelete.Method */
+    uint32 account; /**< 0 for deleted characters */
+    uint8 race; /**< TODO */
+    uint8 playerClass; /**< TODO */
+    uint8 gender; /**< TODO */
+    uint32 level; /**< TODO */
+};
+
 #define MAX_PLAYER_NAME          12                         // max allowed by client name length
 #define MAX_INTERNAL_PLAYER_NAME 15                         // max server internal player name length ( > MAX_PLAYER_NAME for support declined names )
 #define MAX_PET_NAME             12                         // max allowed by client name length
@@ -641,6 +655,17 @@ class ObjectMgr
         uint32 GetPlayerAccountIdByGUID(ObjectGuid guid) const;
         uint32 GetPlayerAccountIdByPlayerName(const std::string& name) const;
 
+        // identities of all characters, online or not
+        void LoadCharacterIdentities();
+        bool GetCharacterIdentity(ObjectGuid guid, CharacterIdentity& identity) const;
+        void SetCharacterIdentity(ObjectGuid guid, CharacterIdentity const& identity);
+        void SetCharacterIdentity(Player* player);
+        void SetCharacterIdentityName(ObjectGuid guid, std::string const& name);
+        void SetCharacterIdentityLevel(ObjectGuid guid, uint32 level);
+        void SetCharacterIdentityGender(ObjectGuid guid, uint8 gender);
+        void SetCharacterIdentityDeleted(ObjectGuid guid);
+        void RemoveCharacterIdentity(ObjectGuid guid);
+
         uint32 GetNearestTaxiNode(float x, float y, float z, uint32 mapid, Team team);
         void GetTaxiPath(uint32 source, uint32 destination, uint32& path, uint32& cost);
         uint32 GetTaxiMountDisplayId(uint32 id, Team team, bool allowed_alt_team = false);
@@ -1452,6 +1477,18 @@ class ObjectMgr
         typedef std::set<std::wstring> ReservedNamesMap;
         ReservedNamesMap    m_ReservedNames;
 
+        // character identities by guid counter and by lower case name, read from map and session threads
+        typedef ACE_RW_Thread_Mutex CharacterIdentityLock;
+        typedef UNORDERED_MAP<uint32, CharacterIdentity> CharacterIdentityMap;
+        typedef UNORDERED_MAP<std::wstring, uint32> CharacterNameIndex;
+        CharacterIdentityMap m_CharacterIdentities;
+        CharacterNameIndex  m_CharacterNameIndex;
+        mutable CharacterIdentityLock m_CharacterIdentityLock;
+
+        static bool MakeCharacterNameKey(std::string const& name, std::wstring& key);
+        void IndexCharacterName(uint32 lowguid, std::string const& name);
+        void UnindexCharacterName(uint32 lowguid, std::string const& name);
+
         GraveYardMap        mGraveYardMap;
 
         GameTeleMap         m_GameTeleMap;
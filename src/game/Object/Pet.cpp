@@ -90,43 +90,53 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
 
     uint32 ownerid = owner->GetGUIDLow();
 
-    QueryResult* result;
+    // pets of the owner are read at login and kept current by SavePetToDB, no DB access here
+    PetDataMap& storedPets = owner->GetStoredPets();
+    PetDataMap::const_iterator stored = storedPets.end();
 
     if (petnumber)
-        // known petnumber entry                   0     1        2(?)     3          4        5      6             7       8       9          10           11         12        13          14                   15                   16                17
-        result = CharacterDatabase.PQuery("SELECT `id`, `entry`, `owner`, `modelid`, `level`, `exp`, `Reactstate`, `slot`, `name`, `renamed`, `curhealth`, `curmana`, `abdata`, `savetime`, `resettalents_cost`, `resettalents_time`, `CreatedBySpell`, `PetType` "
-                                          "FROM `character_pet` WHERE `owner` = '%u' AND `id` = '%u'",
-                                          ownerid, petnumber);
-    else if (current)
-        // current pet (slot 0)                    0     1        2(?)     3          4        5      6             7       8       9          10           11         12        13          14                   15                   16                17
-        result = CharacterDatabase.PQuery("SELECT `id`, `entry`, `owner`, `modelid`, `level`, `exp`, `Reactstate`, `slot`, `name`, `renamed`, `curhealth`, `curmana`, `abdata`, `savetime`, `resettalents_cost`, `resettalents_time`, `CreatedBySpell`, `PetType` "
-                                          "FROM `character_pet` WHERE `owner` = '%u' AND `slot` = '%u'",
-                                          ownerid, PET_SAVE_AS_CURRENT);
-    else if (petentry)
-        // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
-        //                                         0     1        2(?)     3          4        5      6             7       8       9          10           11         12        13          14                   15                   16                17
-        result = CharacterDatabase.PQuery("SELECT `id`, `entry`, `owner`, `modelid`, `level`, `exp`, `Reactstate`, `slot`, `name`, `renamed`, `curhealth`, `curmana`, `abdata`, `savetime`, `resettalents_cost`, `resettalents_time`, `CreatedBySpell`, `PetType` "
-                                          "FROM `character_pet` WHERE `owner` = '%u' AND `entry` = '%u' AND (`slot` = '%u' OR `slot` > '%u') ",
-                                          ownerid, petentry, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
+    {
+        // known petnumber entry
+        stored = storedPets.find(petnumber);
+    }
     else
-        // any current or other non-stabled pet (for hunter "call pet")
-        //                                         0     1        2(?)     3          4        5      6             7       8       9          10           11         12        13          14                   15                   16                17
-        result = CharacterDatabase.PQuery("SELECT `id`, `entry`, `owner`, `modelid`, `level`, `exp`, `Reactstate`, `slot`, `name`, `renamed`, `curhealth`, `curmana`, `abdata`, `savetime`, `resettalents_cost`, `resettalents_time`, `CreatedBySpell`, `PetType` "
-                                          "FROM `character_pet` WHERE `owner` = '%u' AND (`slot` = '%u' OR `slot` > '%u') ",
-                                          ownerid, PET_SAVE_AS_CURRENT, PET_SAVE_LAST_STABLE_SLOT);
+    {
+        for (PetDataMap::const_iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
+        {
+            bool found;
+            if (current)
+            {
+                // current pet (slot 0)
+                found = itr->second.slot == PET_SAVE_AS_CURRENT;
+            }
+            else
+            {
+                // known petentry entry (unique for summoned pet, but non unique for hunter pet (only from current or not stabled pets)
+                // or any current or other non-stabled pet (for hunter "call pet")
+                found = (!petentry || itr->second.entry == petentry) &&
+                        (itr->second.slot == PET_SAVE_AS_CURRENT || itr->second.slot > PET_SAVE_LAST_STABLE_SLOT);
+            }
+
+            if (found)
+            {
+                stored = itr;
+                break;
+            }
+        }
+    }
 
-    if (!result)
+    if (stored == storedPets.end())
     {
         return false;
     }
 
-    Field* fields = result->Fetch();
+    // copy, the owner may save other pets before loading is done
+    PetData data = stored->second;
 
     // update for case of current pet "slot = 0"
-    petentry = fields[1].GetUInt32();
+    petentry = data.entry;
     if (!petentry)
     {
-        delete result;
         return false;
     }
 
@@ -134,11 +144,10 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     if (!creatureInfo)
     {
         sLog.outError("Pet entry %u does not exist but used at pet load (owner: %s).", petentry, owner->GetGuidStr().c_str());
-        delete result;
         return false;
     }
 
-    uint32 summon_spell_id = fields[16].GetUInt32();
+    uint32 summon_spell_id = data.createdBySpell;
     SpellEntry const* spellInfo = sSpellStore.LookupEntry(summon_spell_id);
 
     bool is_temporary_summoned = spellInfo && GetSpellDuration(spellInfo) > 0;
@@ -146,21 +155,19 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     // check temporary summoned pets like mage water elemental
     if (current && is_temporary_summoned)
     {
-        delete result;
         return false;
     }
 
-    PetType pet_type = PetType(fields[17].GetUInt8());
+    PetType pet_type = PetType(data.petType);
     if (pet_type == HUNTER_PET)
     {
         if (!creatureInfo->isTameable(owner->CanTameExoticPets()))
         {
-            delete result;
             return false;
         }
     }
 
-    uint32 pet_number = fields[0].GetUInt32();
+    uint32 pet_number = stored->first;
 
     Map* map = owner->GetMap();
 
@@ -169,7 +176,6 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     uint32 guid = pos.GetMap()->GenerateLocalLowGuid(HIGHGUID_PET);
     if (!Create(guid, pos, creatureInfo, pet_number))
     {
-        delete result;
         return false;
     }
 
@@ -183,25 +189,24 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     {
         AIM_Initialize();
         pos.GetMap()->Add((Creature*)this);
-        delete result;
         return true;
     }
 
     m_charmInfo->SetPetNumber(pet_number, isControlled());
 
     SetOwnerGuid(owner->GetObjectGuid());
-    SetDisplayId(fields[3].GetUInt32());
-    SetNativeDisplayId(fields[3].GetUInt32());
-    uint32 petlevel = fields[4].GetUInt32();
+    SetDisplayId(data.modelId);
+    SetNativeDisplayId(data.modelId);
+    uint32 petlevel = data.level;
     SetUInt32Value(UNIT_NPC_FLAGS, UNIT_NPC_FLAG_NONE);
-    SetName(fields[8].GetString());
+    SetName(data.name);
 
     SetByteValue(UNIT_FIELD_BYTES_2, 1, UNIT_BYTE2_FLAG_SUPPORTABLE | UNIT_BYTE2_FLAG_AURAS);
     SetUInt32Value(UNIT_FIELD_FLAGS, UNIT_FLAG_PVP_ATTACKABLE);
 
     if (getPetType() == HUNTER_PET)
     {
-        SetByteFlag(UNIT_FIELD_BYTES_2, 2, fields[9].GetBool() ? UNIT_CAN_BE_ABANDONED : UNIT_CAN_BE_RENAMED | UNIT_CAN_BE_ABANDONED);
+        SetByteFlag(UNIT_FIELD_BYTES_2, 2, data.renamed ? UNIT_CAN_BE_ABANDONED : UNIT_CAN_BE_RENAMED | UNIT_CAN_BE_ABANDONED);
         SetPowerType(POWER_FOCUS);
     }
     else if (getPetType() != SUMMON_PET)
@@ -222,19 +227,19 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     InitTalentForLevel();                                   // set original talents points before spell loading
 
     SetUInt32Value(UNIT_FIELD_PET_NAME_TIMESTAMP, uint32(time(NULL)));
-    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, fields[5].GetUInt32());
+    SetUInt32Value(UNIT_FIELD_PETEXPERIENCE, data.exp);
     SetCreatorGuid(owner->GetObjectGuid());
 
-    m_charmInfo->SetReactState(ReactStates(fields[6].GetUInt8()));
+    m_charmInfo->SetReactState(ReactStates(data.reactState));
 
-    uint32 savedhealth = fields[10].GetUInt32();
-    uint32 savedpower = fields[11].GetUInt32();
+    uint32 savedhealth = data.curHealth;
+    uint32 savedpower = data.curPower;
 
     // set current pet as current
     // 0=current
     // 1..MAX_PET_STABLES in stable slot
     // PET_SAVE_NOT_IN_SLOT(100) = not stable slot (summoning))
-    if (fields[7].GetUInt32() != 0)
+    if (data.slot != PET_SAVE_AS_CURRENT)
     {
         CharacterDatabase.BeginTransaction();
 
@@ -248,24 +253,31 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         stmt.PExecute(uint32(PET_SAVE_AS_CURRENT), ownerid, m_charmInfo->GetPetNumber());
 
         CharacterDatabase.CommitTransaction();
+
+        for (PetDataMap::iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
+        {
+            if (itr->second.slot == PET_SAVE_AS_CURRENT)
+            {
+                itr->second.slot = PET_SAVE_NOT_IN_SLOT;
+            }
+        }
+        storedPets[pet_number].slot = PET_SAVE_AS_CURRENT;
     }
 
     // load action bar, if data broken will fill later by default spells.
     if (!is_temporary_summoned)
     {
-        m_charmInfo->LoadPetActionBar(fields[12].GetCppString());
+        m_charmInfo->LoadPetActionBar(data.actionBar);
     }
 
     // since last save (in seconds)
-    uint32 timediff = uint32(time(NULL) - fields[13].GetUInt64());
-
-    m_resetTalentsCost = fields[14].GetUInt32();
-    m_resetTalentsTime = fields[15].GetUInt64();
+    uint32 timediff = uint32(time(NULL) - data.saveTime);
 
-    delete result;
+    m_resetTalentsCost = data.resetTalentsCost;
+    m_resetTalentsTime = data.resetTalentsTime;
 
     // load spells/cooldowns/auras
-    _LoadAuras(timediff);
+    _LoadAuras(data.auras, timediff);
 
     // init AB
     if (is_temporary_summoned)
@@ -294,12 +306,12 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
     AIM_Initialize();
 
     // Spells should be loaded after pet is added to map, because in CheckCast is check on it
-    _LoadSpells();
+    _LoadSpells(data);
     InitLevelupSpellsForLevel();
 
     CleanupActionBar();                                     // remove unknown spells from action bar after load
 
-    _LoadSpellCooldowns();
+    _LoadSpellCooldowns(data);
 
     owner->SetPet(this);                                    // in DB stored only full controlled creature
     DEBUG_LOG("New Pet has guid %u", GetGUIDLow());
@@ -315,23 +327,10 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         ((Player*)owner)->SendTalentsInfoData(true);
     }
 
-    if (owner->GetTypeId() == TYPEID_PLAYER && getPetType() == HUNTER_PET)
+    if (getPetType() == HUNTER_PET && data.hasDeclinedName)
     {
-        result = CharacterDatabase.PQuery("SELECT `genitive`, `dative`, `accusative`, `instrumental`, `prepositional` FROM `character_pet_declinedname` WHERE `owner` = '%u' AND `id` = '%u'", owner->GetGUIDLow(), GetCharmInfo()->GetPetNumber());
-
-        if (result)
-        {
-            delete m_declinedname;
-            m_declinedname = new DeclinedName;
-
-            Field* fields2 = result->Fetch();
-            for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
-            {
-                m_declinedname->name[i] = fields2[i].GetCppString();
-            }
-
-            delete result;
-        }
+        delete m_declinedname;
+        m_declinedname = new DeclinedName(data.declinedName);
     }
 
     m_loading = false;
@@ -404,11 +403,47 @@ void Pet::SavePetToDB(PetSaveMode mode)
             RemoveAllAuras();
         }
 
+        uint32 petNumber = m_charmInfo->GetPetNumber();
+        PetDataMap& storedPets = pOwner->GetStoredPets();
+
+        // the stored copy is what the next summon loads, the declined name is only changed by renaming
+        PetData data;
+        if (PetData const* stored = pOwner->GetStoredPet(petNumber))
+        {
+            data.hasDeclinedName = stored->hasDeclinedName;
+            data.declinedName = stored->declinedName;
+        }
+
+        data.entry = GetEntry();
+        data.modelId = GetNativeDisplayId();
+        data.level = getLevel();
+        data.exp = GetUInt32Value(UNIT_FIELD_PETEXPERIENCE);
+        data.reactState = uint8(m_charmInfo->GetReactState());
+        data.slot = uint32(mode);
+        data.name = m_name;
+        data.renamed = !HasByteFlag(UNIT_FIELD_BYTES_2, 2, UNIT_CAN_BE_RENAMED);
+        data.curHealth = curhealth;
+        data.curPower = curpower;
+
+        std::ostringstream ss;
+        for (uint32 i = ACTION_BAR_INDEX_START; i < ACTION_BAR_INDEX_END; ++i)
+        {
+            ss << uint32(m_charmInfo->GetActionBarEntry(i)->GetType()) << " "
+               << uint32(m_charmInfo->GetActionBarEntry(i)->GetAction()) << " ";
+        };
+        data.actionBar = ss.str();
+
+        data.saveTime = uint64(time(NULL));
+        data.resetTalentsCost = m_resetTalentsCost;
+        data.resetTalentsTime = uint64(m_resetTalentsTime);
+        data.createdBySpell = GetUInt32Value(UNIT_CREATED_BY_SPELL);
+        data.petType = uint8(getPetType());
+
         // save pet's data as one single transaction
         CharacterDatabase.BeginTransaction();
-        _SaveSpells();
-        _SaveSpellCooldowns();
-        _SaveAuras();
+        _SaveSpells(data);
+        _SaveSpellCooldowns(data);
+        _SaveAuras(data.auras);
 
         uint32 ownerLow = GetOwnerGuid().GetCounter();
         // remove current data
@@ -416,7 +451,7 @@ void Pet::SavePetToDB(PetSaveMode mode)
         static SqlStatementID insPet ;
 
         SqlStatement stmt = CharacterDatabase.CreateStatement(delPet, "DELETE FROM `character_pet` WHERE `owner` = ? AND `id` = ?");
-        stmt.PExecute(ownerLow, m_charmInfo->GetPetNumber());
+        stmt.PExecute(ownerLow, petNumber);
 
         // prevent duplicate using slot (except PET_SAVE_NOT_IN_SLOT)
         if (mode <= PET_SAVE_LAST_STABLE_SLOT)
@@ -425,6 +460,14 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
             stmt = CharacterDatabase.CreateStatement(updPet, "UPDATE `character_pet` SET `slot` = ? WHERE `owner` = ? AND `slot` = ?");
             stmt.PExecute(uint32(PET_SAVE_NOT_IN_SLOT), ownerLow, uint32(mode));
+
+            for (PetDataMap::iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
+            {
+                if (itr->second.slot == uint32(mode))
+                {
+                    itr->second.slot = PET_SAVE_NOT_IN_SLOT;
+                }
+            }
         }
 
         // prevent existence another hunter pet in PET_SAVE_AS_CURRENT and PET_SAVE_NOT_IN_SLOT
@@ -434,6 +477,18 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
             stmt = CharacterDatabase.CreateStatement(del, "DELETE FROM `character_pet` WHERE `owner` = ? AND (`slot` = ? OR `slot` > ?)");
             stmt.PExecute(ownerLow, uint32(PET_SAVE_AS_CURRENT), uint32(PET_SAVE_LAST_STABLE_SLOT));
+
+            for (PetDataMap::iterator itr = storedPets.begin(); itr != storedPets.end();)
+            {
+                if (itr->second.slot == PET_SAVE_AS_CURRENT || itr->second.slot > PET_SAVE_LAST_STABLE_SLOT)
+                {
+                    storedPets.erase(itr++);
+                }
+                else
+                {
+                    ++itr;
+                }
+            }
         }
 
         // save pet
@@ -441,40 +496,35 @@ void Pet::SavePetToDB(PetSaveMode mode)
         "(`id`, `entry`,  `owner`, `modelid`, `level`, `exp`, `Reactstate`, `slot`, `name`, `renamed`, `curhealth`, `curmana`, `abdata`, `savetime`, `resettalents_cost`, `resettalents_time`, `CreatedBySpell`, `PetType`) "
              "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
-        savePet.addUInt32(m_charmInfo->GetPetNumber());
-        savePet.addUInt32(GetEntry());
+        savePet.addUInt32(petNumber);
+        savePet.addUInt32(data.entry);
         savePet.addUInt32(ownerLow);
-        savePet.addUInt32(GetNativeDisplayId());
-        savePet.addUInt32(getLevel());
-        savePet.addUInt32(GetUInt32Value(UNIT_FIELD_PETEXPERIENCE));
-        savePet.addUInt32(uint32(m_charmInfo->GetReactState()));
-        savePet.addUInt32(uint32(mode));
-        savePet.addString(m_name);
-        savePet.addUInt32(uint32(HasByteFlag(UNIT_FIELD_BYTES_2, 2, UNIT_CAN_BE_RENAMED) ? 0 : 1));
-        savePet.addUInt32(curhealth);
-        savePet.addUInt32(curpower);
-
-        std::ostringstream ss;
-        for (uint32 i = ACTION_BAR_INDEX_START; i < ACTION_BAR_INDEX_END; ++i)
-        {
-            ss << uint32(m_charmInfo->GetActionBarEntry(i)->GetType()) << " "
-               << uint32(m_charmInfo->GetActionBarEntry(i)->GetAction()) << " ";
-        };
-        savePet.addString(ss);
-
-        savePet.addUInt64(uint64(time(NULL)));
-        savePet.addUInt32(uint32(m_resetTalentsCost));
-        savePet.addUInt64(uint64(m_resetTalentsTime));
-        savePet.addUInt32(GetUInt32Value(UNIT_CREATED_BY_SPELL));
-        savePet.addUInt32(uint32(getPetType()));
+        savePet.addUInt32(data.modelId);
+        savePet.addUInt32(data.level);
+        savePet.addUInt32(data.exp);
+        savePet.addUInt32(uint32(data.reactState));
+        savePet.addUInt32(data.slot);
+        savePet.addString(data.name);
+        savePet.addUInt32(uint32(data.renamed ? 1 : 0));
+        savePet.addUInt32(data.curHealth);
+        savePet.addUInt32(data.curPower);
+        savePet.addString(data.actionBar);
+        savePet.addUInt64(data.saveTime);
+        savePet.addUInt32(data.resetTalentsCost);
+        savePet.addUInt64(data.resetTalentsTime);
+        savePet.addUInt32(data.createdBySpell);
+        savePet.addUInt32(uint32(data.petType));
 
         savePet.Execute();
         CharacterDatabase.CommitTransaction();
+
+        storedPets[petNumber] = data;
     }
     else
     {
         RemoveAllAuras(AURA_REMOVE_BY_DELETE);
         DeleteFromDB(m_charmInfo->GetPetNumber());
+        pOwner->GetStoredPets().erase(m_charmInfo->GetPetNumber());
     }
 }
 
@@ -1256,59 +1306,54 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel)
     }
 }
 
-void Pet::_LoadSpellCooldowns()
+void Pet::_LoadSpellCooldowns(PetData const& stored)
 {
     m_CreatureSpellCooldowns.clear();
     m_CreatureCategoryCooldowns.clear();
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `spell`,`time` FROM `pet_spell_cooldown` WHERE `guid` = '%u'", m_charmInfo->GetPetNumber());
-
-    if (result)
+    if (stored.cooldowns.empty())
     {
-        time_t curTime = time(NULL);
-
-        WorldPacket data(SMSG_SPELL_COOLDOWN, (8 + 1 + size_t(result->GetRowCount()) * 8));
-        data << ObjectGuid(GetObjectGuid());
-        data << uint8(0x0);                                 // flags (0x1, 0x2)
+        return;
+    }
 
-        do
-        {
-            Field* fields = result->Fetch();
+    time_t curTime = time(NULL);
 
-            uint32 spell_id = fields[0].GetUInt32();
-            time_t db_time  = (time_t)fields[1].GetUInt64();
+    WorldPacket data(SMSG_SPELL_COOLDOWN, (8 + 1 + stored.cooldowns.size() * 8));
+    data << ObjectGuid(GetObjectGuid());
+    data << uint8(0x0);                                    // flags (0x1, 0x2)
 
-            if (!sSpellStore.LookupEntry(spell_id))
-            {
-                sLog.outError("Pet %u have unknown spell %u in `pet_spell_cooldown`, skipping.", m_charmInfo->GetPetNumber(), spell_id);
-                continue;
-            }
+    for (std::map<uint32, uint64>::const_iterator itr = stored.cooldowns.begin(); itr != stored.cooldowns.end(); ++itr)
+    {
+        uint32 spell_id = itr->first;
+        time_t db_time  = (time_t)itr->second;
 
-            // skip outdated cooldown
-            if (db_time <= curTime)
-            {
-                continue;
-            }
+        if (!sSpellStore.LookupEntry(spell_id))
+        {
+            sLog.outError("Pet %u have unknown spell %u in `pet_spell_cooldown`, skipping.", m_charmInfo->GetPetNumber(), spell_id);
+            continue;
+        }
 
-            data << uint32(spell_id);
-            data << uint32(uint32(db_time - curTime)*IN_MILLISECONDS);
+        // skip outdated cooldown
+        if (db_time <= curTime)
+        {
+            continue;
+        }
 
-            _AddCreatureSpellCooldown(spell_id, db_time);
+        data << uint32(spell_id);
+        data << uint32(uint32(db_time - curTime)*IN_MILLISECONDS);
 
-            DEBUG_LOG("Pet (Number: %u) spell %u cooldown loaded (%u secs).", m_charmInfo->GetPetNumber(), spell_id, uint32(db_time - curTime));
-        }
-        while (result->NextRow());
+        _AddCreatureSpellCooldown(spell_id, db_time);
 
-        delete result;
+        DEBUG_LOG("Pet (Number: %u) spell %u cooldown loaded (%u secs).", m_charmInfo->GetPetNumber(), spell_id, uint32(db_time - curTime));
+    }
 
-        if (!m_CreatureSpellCooldowns.empty() && GetOwner())
-        {
-            ((Player*)GetOwner())->GetSession()->SendPacket(&data);
-        }
+    if (!m_CreatureSpellCooldowns.empty() && GetOwner())
+    {
+        ((Player*)GetOwner())->GetSession()->SendPacket(&data);
     }
 }
 
-void Pet::_SaveSpellCooldowns()
+void Pet::_SaveSpellCooldowns(PetData& stored)
 {
     static SqlStatementID delSpellCD ;
     static SqlStatementID insSpellCD ;
@@ -1329,30 +1374,21 @@ void Pet::_SaveSpellCooldowns()
         {
             stmt = CharacterDatabase.CreateStatement(insSpellCD, "INSERT INTO `pet_spell_cooldown` (`guid`,`spell`,`time`) VALUES (?, ?, ?)");
             stmt.PExecute(m_charmInfo->GetPetNumber(), itr->first, uint64(itr->second));
+            stored.cooldowns[itr->first] = uint64(itr->second);
             ++itr;
         }
     }
 }
 
-void Pet::_LoadSpells()
+void Pet::_LoadSpells(PetData const& stored)
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `spell`,`active` FROM `pet_spell` WHERE `guid` = '%u'", m_charmInfo->GetPetNumber());
-
-    if (result)
+    for (std::map<uint32, uint8>::const_iterator itr = stored.spells.begin(); itr != stored.spells.end(); ++itr)
     {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            addSpell(fields[0].GetUInt32(), ActiveStates(fields[1].GetUInt8()), PETSPELL_UNCHANGED);
-        }
-        while (result->NextRow());
-
-        delete result;
+        addSpell(itr->first, ActiveStates(itr->second), PETSPELL_UNCHANGED);
     }
 }
 
-void Pet::_SaveSpells()
+void Pet::_SaveSpells(PetData& stored)
 {
     static SqlStatementID delSpell ;
     static SqlStatementID insSpell ;
@@ -1392,130 +1428,124 @@ void Pet::_SaveSpells()
             }
             break;
             case PETSPELL_UNCHANGED:
-                continue;
+                break;
         }
 
         itr->second.state = PETSPELL_UNCHANGED;
+        stored.spells[itr->first] = itr->second.active;
     }
 }
 
-void Pet::_LoadAuras(uint32 timediff)
+void Pet::_LoadAuras(PetAuraDataList const& auras, uint32 timediff)
 {
     RemoveAllAuras();
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `caster_guid`,`item_guid`,`spell`,`stackcount`,`remaincharges`,`basepoints0`,`basepoints1`,`basepoints2`,`periodictime0`,`periodictime1`,`periodictime2`,`maxduration`,`remaintime`,`effIndexMask` FROM `pet_aura` WHERE `guid` = '%u'", m_charmInfo->GetPetNumber());
-
-    if (result)
+    for (PetAuraDataList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
     {
-        do
+        ObjectGuid casterGuid = itr->casterGuid;
+        uint32 item_lowguid = itr->itemLowGuid;
+        uint32 spellid = itr->spellId;
+        uint32 stackcount = itr->stackCount;
+        uint32 remaincharges = itr->remainCharges;
+        int32  damage[MAX_EFFECT_INDEX];
+        uint32 periodicTime[MAX_EFFECT_INDEX];
+
+        for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         {
-            Field* fields = result->Fetch();
-            ObjectGuid casterGuid = ObjectGuid(fields[0].GetUInt64());
-            uint32 item_lowguid = fields[1].GetUInt32();
-            uint32 spellid = fields[2].GetUInt32();
-            uint32 stackcount = fields[3].GetUInt32();
-            uint32 remaincharges = fields[4].GetUInt32();
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
+            damage[i] = itr->basePoints[i];
+            periodicTime[i] = itr->periodicTime[i];
+        }
 
-            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                damage[i] = fields[i + 5].GetInt32();
-                periodicTime[i] = fields[i + 8].GetUInt32();
-            }
+        int32 maxduration = itr->maxDuration;
+        int32 remaintime = itr->remainTime;
+        uint32 effIndexMask = itr->effIndexMask;
 
-            int32 maxduration = fields[11].GetInt32();
-            int32 remaintime = fields[12].GetInt32();
-            uint32 effIndexMask = fields[13].GetUInt32();
+        SpellEntry const* spellproto = sSpellStore.LookupEntry(spellid);
+        if (!spellproto)
+        {
+            sLog.outError("Unknown spell (spellid %u), ignore.", spellid);
+            continue;
+        }
 
-            SpellEntry const* spellproto = sSpellStore.LookupEntry(spellid);
-            if (!spellproto)
-            {
-                sLog.outError("Unknown spell (spellid %u), ignore.", spellid);
-                continue;
-            }
+        // do not load single target auras (unless they were cast by the player)
+        if (casterGuid != GetObjectGuid() && IsSingleTargetSpell(spellproto))
+        {
+            continue;
+        }
 
-            // do not load single target auras (unless they were cast by the player)
-            if (casterGuid != GetObjectGuid() && IsSingleTargetSpell(spellproto))
+        if (remaintime != -1 && !IsPositiveSpell(spellproto))
+        {
+            if (remaintime / IN_MILLISECONDS <= int32(timediff))
             {
                 continue;
             }
 
-            if (remaintime != -1 && !IsPositiveSpell(spellproto))
-            {
-                if (remaintime / IN_MILLISECONDS <= int32(timediff))
-                {
-                    continue;
-                }
-
-                remaintime -= timediff * IN_MILLISECONDS;
-            }
+            remaintime -= timediff * IN_MILLISECONDS;
+        }
 
-            // prevent wrong values of remaincharges
-            uint32 procCharges = spellproto->GetProcCharges();
-            if (procCharges)
-            {
-                if (remaincharges <= 0 || remaincharges > procCharges)
-                {
-                    remaincharges = procCharges;
-                }
-            }
-            else
+        // prevent wrong values of remaincharges
+        uint32 procCharges = spellproto->GetProcCharges();
+        if (procCharges)
+        {
+            if (remaincharges <= 0 || remaincharges > procCharges)
             {
-                remaincharges = 0;
+                remaincharges = procCharges;
             }
+        }
+        else
+        {
+            remaincharges = 0;
+        }
 
-            uint32 defstackamount = spellproto->GetStackAmount();
-            if (!defstackamount)
-            {
-                stackcount = 1;
-            }
-            else if (defstackamount < stackcount)
-            {
-                stackcount = defstackamount;
-            }
-            else if (!stackcount)
-            {
-                stackcount = 1;
-            }
+        uint32 defstackamount = spellproto->GetStackAmount();
+        if (!defstackamount)
+        {
+            stackcount = 1;
+        }
+        else if (defstackamount < stackcount)
+        {
+            stackcount = defstackamount;
+        }
+        else if (!stackcount)
+        {
+            stackcount = 1;
+        }
 
-            SpellAuraHolder* holder = CreateSpellAuraHolder(spellproto, this, NULL);
-            holder->SetLoadedState(casterGuid, ObjectGuid(HIGHGUID_ITEM, item_lowguid), stackcount, remaincharges, maxduration, remaintime);
+        SpellAuraHolder* holder = CreateSpellAuraHolder(spellproto, this, NULL);
+        holder->SetLoadedState(casterGuid, ObjectGuid(HIGHGUID_ITEM, item_lowguid), stackcount, remaincharges, maxduration, remaintime);
 
-            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            if ((effIndexMask & (1 << i)) == 0)
             {
-                if ((effIndexMask & (1 << i)) == 0)
-                {
-                    continue;
-                }
-
-                Aura* aura = CreateAura(spellproto, SpellEffectIndex(i), NULL, holder, this);
-                if (!damage[i])
-                {
-                    damage[i] = aura->GetModifier()->m_amount;
-                }
-
-                aura->SetLoadedState(damage[i], periodicTime[i]);
-                holder->AddAura(aura, SpellEffectIndex(i));
+                continue;
             }
 
-            if (!holder->IsEmptyHolder())
-            {
-                AddSpellAuraHolder(holder);
-            }
-            else
+            Aura* aura = CreateAura(spellproto, SpellEffectIndex(i), NULL, holder, this);
+            if (!damage[i])
             {
-                delete holder;
+                damage[i] = aura->GetModifier()->m_amount;
             }
+
+            aura->SetLoadedState(damage[i], periodicTime[i]);
+            holder->AddAura(aura, SpellEffectIndex(i));
         }
-        while (result->NextRow());
 
-        delete result;
+        if (!holder->IsEmptyHolder())
+        {
+            AddSpellAuraHolder(holder);
+        }
+        else
+        {
+            delete holder;
+        }
     }
 }
 
-void Pet::_SaveAuras()
+void Pet::_SaveAuras(PetAuraDataList& auras)
 {
+    auras.clear();
+
     static SqlStatementID delAuras ;
     static SqlStatementID insAuras ;
 
@@ -1560,14 +1590,13 @@ void Pet::_SaveAuras()
         // do not save single target holders (unless they were cast by the player)
         if (save && !holder->IsPassive() && !IsChanneledSpell(holder->GetSpellProto()) && (holder->GetCasterGuid() == GetObjectGuid() || holder->GetTrackedAuraType() != TRACK_AURA_TYPE_NOT_TRACKED))
         {
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
-            uint32 effIndexMask = 0;
+            PetAuraData aura;
+            aura.effIndexMask = 0;
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                damage[i] = 0;
-                periodicTime[i] = 0;
+                aura.basePoints[i] = 0;
+                aura.periodicTime[i] = 0;
 
                 if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
                 {
@@ -1577,37 +1606,46 @@ void Pet::_SaveAuras()
                         continue;
                     }
 
-                    damage[i] = aur->GetModifier()->m_amount;
-                    periodicTime[i] = aur->GetModifier()->periodictime;
-                    effIndexMask |= (1 << i);
+                    aura.basePoints[i] = aur->GetModifier()->m_amount;
+                    aura.periodicTime[i] = aur->GetModifier()->periodictime;
+                    aura.effIndexMask |= (1 << i);
                 }
             }
 
-            if (!effIndexMask)
+            if (!aura.effIndexMask)
             {
                 continue;
             }
 
+            aura.casterGuid = holder->GetCasterGuid();
+            aura.itemLowGuid = holder->GetCastItemGuid().GetCounter();
+            aura.spellId = holder->GetId();
+            aura.stackCount = holder->GetStackAmount();
+            aura.remainCharges = uint8(holder->GetAuraCharges());
+            aura.maxDuration = holder->GetAuraMaxDuration();
+            aura.remainTime = holder->GetAuraDuration();
+            auras.push_back(aura);
+
             stmt.addUInt32(m_charmInfo->GetPetNumber());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            stmt.addUInt64(aura.casterGuid.GetRawValue());
+            stmt.addUInt32(aura.itemLowGuid);
+            stmt.addUInt32(aura.spellId);
+            stmt.addUInt32(aura.stackCount);
+            stmt.addUInt8(uint8(aura.remainCharges));
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                stmt.addInt32(damage[i]);
+                stmt.addInt32(aura.basePoints[i]);
             }
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                stmt.addUInt32(periodicTime[i]);
+                stmt.addUInt32(aura.periodicTime[i]);
             }
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
+            stmt.addInt32(aura.maxDuration);
+            stmt.addInt32(aura.remainTime);
+            stmt.addUInt32(aura.effIndexMask);
             stmt.Execute();
         }
     }
@@ -2053,80 +2091,61 @@ void Pet::resetTalentsForAllPetsOf(Player* owner, Pet* online_pet /*= NULL*/)
     // now need only reset for offline pets (all pets except online case)
     uint32 except_petnumber = online_pet ? online_pet->GetCharmInfo()->GetPetNumber() : 0;
 
-    QueryResult* resultPets = CharacterDatabase.PQuery(
-                                  "SELECT `id` FROM `character_pet` WHERE `owner` = '%u' AND `id` <> '%u'",
-                                  owner->GetGUIDLow(), except_petnumber);
+    std::set<uint32> petNumbers;
+    std::set<uint32> talentSpells;
 
-    // no offline pets
-    if (!resultPets)
+    PetDataMap& storedPets = owner->GetStoredPets();
+    for (PetDataMap::iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
     {
-        return;
-    }
+        if (itr->first == except_petnumber)
+        {
+            continue;
+        }
 
-    QueryResult* result = CharacterDatabase.PQuery(
-                              "SELECT DISTINCT `pet_spell`.`spell` FROM `pet_spell`, `character_pet` "
-                              "WHERE `character_pet`.`owner` = '%u' AND `character_pet`.`id` = `pet_spell`.`guid` AND `character_pet`.`id` <> %u",
-                              owner->GetGUIDLow(), except_petnumber);
+        for (std::map<uint32, uint8>::iterator spellItr = itr->second.spells.begin(); spellItr != itr->second.spells.end();)
+        {
+            if (GetTalentSpellCost(spellItr->first))
+            {
+                petNumbers.insert(itr->first);
+                talentSpells.insert(spellItr->first);
+                itr->second.spells.erase(spellItr++);
+            }
+            else
+            {
+                ++spellItr;
+            }
+        }
+    }
 
-    if (!result)
+    // no offline pets with talents
+    if (talentSpells.empty())
     {
-        delete resultPets;
         return;
     }
 
-    bool need_comma = false;
     std::ostringstream ss;
     ss << "DELETE FROM `pet_spell` WHERE `guid` IN (";
 
-    do
+    for (std::set<uint32>::const_iterator itr = petNumbers.begin(); itr != petNumbers.end(); ++itr)
     {
-        Field* fields = resultPets->Fetch();
-
-        uint32 id = fields[0].GetUInt32();
-
-        if (need_comma)
+        if (itr != petNumbers.begin())
         {
             ss << ",";
         }
 
-        ss << id;
-
-        need_comma = true;
+        ss << *itr;
     }
-    while (resultPets->NextRow());
-
-    delete resultPets;
 
     ss << ") AND `spell` IN (";
 
-    bool need_execute = false;
-    do
+    for (std::set<uint32>::const_iterator itr = talentSpells.begin(); itr != talentSpells.end(); ++itr)
     {
-        Field* fields = result->Fetch();
-
-        uint32 spell = fields[0].GetUInt32();
-
-        if (!GetTalentSpellCost(spell))
-        {
-            continue;
-        }
-
-        if (need_execute)
+        if (itr != talentSpells.begin())
         {
             ss << ",";
         }
 
-        ss << spell;
-
-        need_execute = true;
-    }
-    while (result->NextRow());
-
-    delete result;
-
-    if (!need_execute)
-    {
-        return;
+        ss << *itr;
     }
 
     ss << ")";
@@ -129,6 +129,58 @@ enum PetNameInvalidReason
 typedef UNORDERED_MAP<uint32, PetSpell> PetSpellMap;
 typedef std::vector<uint32> AutoSpellList;
 
+// row of `pet_aura`
+struct PetAuraData
+{
+    ObjectGuid casterGuid;
+    uint32 itemLowGuid;
+    uint32 spellId;
+    uint32 stackCount;
+    uint32 remainCharges;
+    int32  basePoints[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32  maxDuration;
+    int32  remainTime;
+    uint32 effIndexMask;
+};
+
+typedef std::vector<PetAuraData> PetAuraDataList;
+
+// `character_pet` row with the spells, cooldowns, auras and declined name of the pet,
+// kept by the owner from login on so summoning and stable handling do not query the DB
+struct PetData
+{
+    PetData() : entry(0), modelId(0), level(0), exp(0), reactState(0), slot(PET_SAVE_NOT_IN_SLOT), renamed(false),
+        curHealth(0), curPower(0), saveTime(0), resetTalentsCost(0), resetTalentsTime(0), createdBySpell(0), petType(0),
+        hasDeclinedName(false) {}
+
+    uint32 entry;
+    uint32 modelId;
+    uint32 level;
+    uint32 exp;
+    uint8  reactState;
+    uint32 slot;                                            // PetSaveMode
+    std::string name;
+    bool   renamed;
+    uint32 curHealth;
+    uint32 curPower;
+    std::string actionBar;
+    uint64 saveTime;
+    uint32 resetTalentsCost;
+    uint64 resetTalentsTime;
+    uint32 createdBySpell;
+    uint8  petType;
+
+    std::map<uint32, uint8> spells;                         // spell id -> ActiveStates, family passives not included
+    std::map<uint32, uint64> cooldowns;                     // spell id -> end time
+    PetAuraDataList auras;
+
+    bool hasDeclinedName;
+    DeclinedName declinedName;
+};
+
+typedef std::map<uint32 /*pet number*/, PetData> PetDataMap;
+
 #define HAPPINESS_LEVEL_SIZE        333000
 
 #define ACTIVE_SPELLS_MAX           4
@@ -226,12 +278,12 @@ class Pet : public Creature
         void CastOwnerTalentAuras();
         void CastPetAura(PetAura const* aura);
 
-        void _LoadSpellCooldowns();
-        void _SaveSpellCooldowns();
-        void _LoadAuras(uint32 timediff);
-        void _SaveAuras();
-        void _LoadSpells();
-        void _SaveSpells();
+        void _LoadSpellCooldowns(PetData const& data);
+        void _SaveSpellCooldowns(PetData& data);
+        void _LoadAuras(PetAuraDataList const& auras, uint32 timediff);
+        void _SaveAuras(PetAuraDataList& auras);
+        void _LoadSpells(PetData const& data);
+        void _SaveSpells(PetData& data);
 
         bool addSpell(uint32 spell_id, ActiveStates active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
         bool learnSpell(uint32 spell_id);
@@ -3064,6 +3064,7 @@ void Player::GiveLevel(uint32 level)
     _ApplyAllLevelScaleItemMods(false);
 
     SetLevel(level);
+    sObjectMgr.SetCharacterIdentityLevel(GetObjectGuid(), level);
 
     UpdateSkillsForLevel();
 
@@ -5149,11 +5150,13 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             CharacterDatabase.PExecute("DELETE FROM `guild_bank_eventlog` WHERE `PlayerGuid` = '%u'", lowguid);
             CharacterDatabase.PExecute("DELETE FROM `character_currencies` WHERE `guid` = '%u'", lowguid);
             CharacterDatabase.CommitTransaction();
+            sObjectMgr.RemoveCharacterIdentity(playerguid);
             break;
         }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
         case 1:
             CharacterDatabase.PExecute("UPDATE `characters` SET `deleteInfos_Name`=`name`, `deleteInfos_Account`=`account`, `deleteDate`='" UI64FMTD "', `name`='', `account`=0 WHERE `guid`=%u", uint64(time(NULL)), lowguid);
+            sObjectMgr.SetCharacterIdentityDeleted(playerguid);
             break;
         default:
             sLog.outError("Player::DeleteFromDB: Unsupported delete method: %u.", charDelete_method);
@@ -7928,19 +7931,13 @@ uint32 Player::GetZoneIdFromDB(ObjectGuid guid)
 
 uint32 Player::GetLevelFromDB(ObjectGuid guid)
 {
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `level` FROM `characters` WHERE `guid`='%u'", lowguid);
-    if (!result)
+    CharacterIdentity identity;
+    if (!sObjectMgr.GetCharacterIdentity(guid, identity))
     {
         return 0;
     }
 
-    Field* fields = result->Fetch();
-    uint32 level = fields[0].GetUInt32();
-    delete result;
-
-    return level;
+    return identity.level;
 }
 
 void Player::UpdateArea(uint32 newArea)
@@ -18432,6 +18429,9 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
     }
 
     _LoadCurrencies(holder->GetResult(PLAYER_LOGIN_QUERY_LOADCURRENCIES));
+    _LoadPets(holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETS), holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETSPELLS),
+              holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS), holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETAURAS),
+              holder->GetResult(PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES));
     _LoadSpells(holder->GetResult(PLAYER_LOGIN_QUERY_LOADSPELLS));
 
     // after spell load, learn rewarded spell if need also
@@ -19261,6 +19261,133 @@ void Player::_LoadMails(QueryResult* result)
     delete result;
 }
 
+void Player::_LoadPets(QueryResult* pets, QueryResult* spells, QueryResult* cooldowns, QueryResult* auras, QueryResult* declinedNames)
+{
+    m_storedPets.clear();
+
+    if (pets)
+    {
+        do
+        {
+            Field* fields = pets->Fetch();
+
+            PetData& data = m_storedPets[fields[0].GetUInt32()];
+            data.entry = fields[1].GetUInt32();
+            data.modelId = fields[2].GetUInt32();
+            data.level = fields[3].GetUInt32();
+            data.exp = fields[4].GetUInt32();
+            data.reactState = fields[5].GetUInt8();
+            data.slot = fields[6].GetUInt32();
+            data.name = fields[7].GetCppString();
+            data.renamed = fields[8].GetBool();
+            data.curHealth = fields[9].GetUInt32();
+            data.curPower = fields[10].GetUInt32();
+            data.actionBar = fields[11].GetCppString();
+            data.saveTime = fields[12].GetUInt64();
+            data.resetTalentsCost = fields[13].GetUInt32();
+            data.resetTalentsTime = fields[14].GetUInt64();
+            data.createdBySpell = fields[15].GetUInt32();
+            data.petType = fields[16].GetUInt8();
+        }
+        while (pets->NextRow());
+
+        delete pets;
+    }
+
+    if (spells)
+    {
+        do
+        {
+            Field* fields = spells->Fetch();
+
+            if (PetData* data = GetStoredPet(fields[0].GetUInt32()))
+            {
+                data->spells[fields[1].GetUInt32()] = fields[2].GetUInt8();
+            }
+        }
+        while (spells->NextRow());
+
+        delete spells;
+    }
+
+    if (cooldowns)
+    {
+        do
+        {
+            Field* fields = cooldowns->Fetch();
+
+            if (PetData* data = GetStoredPet(fields[0].GetUInt32()))
+            {
+                data->cooldowns[fields[1].GetUInt32()] = fields[2].GetUInt64();
+            }
+        }
+        while (cooldowns->NextRow());
+
+        delete cooldowns;
+    }
+
+    if (auras)
+    {
+        do
+        {
+            Field* fields = auras->Fetch();
+
+            PetData* data = GetStoredPet(fields[0].GetUInt32());
+            if (!data)
+            {
+                continue;
+            }
+
+            PetAuraData aura;
+            aura.casterGuid = ObjectGuid(fields[1].GetUInt64());
+            aura.itemLowGuid = fields[2].GetUInt32();
+            aura.spellId = fields[3].GetUInt32();
+            aura.stackCount = fields[4].GetUInt32();
+            aura.remainCharges = fields[5].GetUInt32();
+
+            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            {
+                aura.basePoints[i] = fields[i + 6].GetInt32();
+                aura.periodicTime[i] = fields[i + 9].GetUInt32();
+            }
+
+            aura.maxDuration = fields[12].GetInt32();
+            aura.remainTime = fields[13].GetInt32();
+            aura.effIndexMask = fields[14].GetUInt32();
+            data->auras.push_back(aura);
+        }
+        while (auras->NextRow());
+
+        delete auras;
+    }
+
+    if (declinedNames)
+    {
+        do
+        {
+            Field* fields = declinedNames->Fetch();
+
+            if (PetData* data = GetStoredPet(fields[0].GetUInt32()))
+            {
+                data->hasDeclinedName = true;
+                for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                {
+                    data->declinedName.name[i] = fields[i + 1].GetCppString();
+                }
+            }
+        }
+        while (declinedNames->NextRow());
+
+        delete declinedNames;
+    }
+}
+
+PetData* Player::GetStoredPet(uint32 petnumber)
+{
+    PetDataMap::iterator itr = m_storedPets.find(petnumber);
+    return itr != m_storedPets.end() ? &itr->second : NULL;
+}
+
 void Player::LoadPet()
 {
     // fixme: the pet should still be loaded if the player is not in world
@@ -20222,6 +20349,7 @@ void Player::SaveToDB()
     uberInsert.addUInt32(GetCreatedDate());
 
     uberInsert.Execute();
+    sObjectMgr.SetCharacterIdentity(this);
 
     if (m_mailsUpdated)                                     // save mails only when needed
     {
@@ -21083,6 +21211,7 @@ void Player::Customize(ObjectGuid guid, uint8 gender, uint8 skin, uint8 face, ui
     player_bytes2 |= facialHair;
 
     CharacterDatabase.PExecute("UPDATE `characters` SET `gender` = '%u', `playerBytes` = '%u', `playerBytes2` = '%u' WHERE `guid` = '%u'", gender, skin | (face << 8) | (hairStyle << 16) | (hairColor << 24), player_bytes2, guid.GetCounter());
+    sObjectMgr.SetCharacterIdentityGender(guid, gender);
 
     delete result;
 }
@@ -873,6 +873,11 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADCURRENCIES,
+    PLAYER_LOGIN_QUERY_LOADPETS,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLS,
+    PLAYER_LOGIN_QUERY_LOADPETSPELLCOOLDOWNS,
+    PLAYER_LOGIN_QUERY_LOADPETAURAS,
+    PLAYER_LOGIN_QUERY_LOADPETDECLINEDNAMES,
 
     MAX_PLAYER_LOGIN_QUERY
 };
@@ -2558,6 +2563,10 @@ class Player : public Unit
         void UnsummonPetTemporaryIfAny();
         void UnsummonPetIfAny();
         void ResummonPetTemporaryUnSummonedIfAny();
+
+        // all pets of the player as stored in the DB, see PetData
+        PetDataMap& GetStoredPets() { return m_storedPets; }
+        PetData* GetStoredPet(uint32 petnumber);
         bool IsPetNeedBeTemporaryUnsummoned() const { return !IsInWorld() || !IsAlive() || IsMounted() /*+in flight*/; }
 
         void SendCinematicStart(uint32 CinematicSequenceId);
@@ -2616,6 +2625,7 @@ class Player : public Unit
         void SetOriginalGroup(Group* group, int8 subgroup = -1);
 
         GridReference<Player>& GetGridRef() { return m_gridRef; }
+        void UpdateGridPosition() override { m_gridRef.UpdatePosition(GetPositionX(), GetPositionY()); WorldObject::UpdateGridPosition(); }
         MapReference& GetMapRef() { return m_mapRef; }
 
         bool IsTappedByMeOrMyGroup(Creature* creature);
@@ -2723,6 +2733,7 @@ class Player : public Unit
         void _LoadEquipmentSets(QueryResult* result);
         void _LoadBGData(QueryResult* result);
         void _LoadGlyphs(QueryResult* result);
+        void _LoadPets(QueryResult* pets, QueryResult* spells, QueryResult* cooldowns, QueryResult* auras, QueryResult* declinedNames);
         void _LoadIntoDataField(const char* data, uint32 startOffset, uint32 count);
 
         /*********************************************************/
@@ -2983,6 +2994,7 @@ class Player : public Unit
 
         // Temporary removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
+        PetDataMap m_storedPets;
 
         AchievementMgr m_achievementMgr;
         ReputationMgr  m_reputationMgr;
@@ -120,7 +120,7 @@ void Totem::Summon(Unit* owner)
         ((Creature*)owner)->AI()->JustSummoned((Creature*)this);
     }
 #ifdef ENABLE_ELUNA
-    sEluna->OnSummoned(this, owner);
+    GetEluna()->OnSummoned(this, owner);
 #endif /* ENABLE_ELUNA */
 
     // there are some totems, which exist just for their visual appeareance
@@ -637,6 +637,10 @@ Unit::Unit() :
 
     m_Visibility = VISIBILITY_ON;
     m_AINotifyScheduled = false;
+    m_AINotifyGeneration = 0;
+    m_lastBroadcastMoveFlags = 0;
+    m_lastBroadcastOrientation = 0.0f;
+    m_movementHeartbeatCount = 0;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -1350,7 +1354,7 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
 #ifdef ENABLE_ELUNA
             if (Player* killed = pVictim->ToPlayer())
             {
-                sEluna->OnPlayerKilledByCreature(killer, killed);
+                GetEluna()->OnPlayerKilledByCreature(killer, killed);
             }
 #endif /* ENABLE_ELUNA */
         }
@@ -1431,7 +1435,7 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
 
                 // Used by Eluna
 #ifdef ENABLE_ELUNA
-                sEluna->OnPVPKill(player_tap, playerVictim);
+                GetEluna()->OnPVPKill(player_tap, playerVictim);
 #endif /* ENABLE_ELUNA */
             }
         }
@@ -1663,7 +1667,7 @@ void Unit::JustKilledCreature(Creature* victim, Player* responsiblePlayer)
 
             // Used by Eluna
 #ifdef ENABLE_ELUNA
-            sEluna->OnCreatureKill(responsiblePlayer, victim);
+            GetEluna()->OnCreatureKill(responsiblePlayer, victim);
 #endif /* ENABLE_ELUNA */
     }
 
@@ -3097,11 +3101,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         }
 
         // Reduce shield amount
-        mod->m_amount -= currentAbsorb;
-        if ((*i)->GetHolder()->DropAuraCharge())
-        {
-            mod->m_amount = 0;
-        }
+        (*i)->ChangeAmount((*i)->GetHolder()->DropAuraCharge() ? 0 : mod->m_amount - currentAbsorb, false);
         // Need remove it later
         if (mod->m_amount <= 0)
         {
@@ -3181,7 +3181,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
             incanterAbsorption += currentAbsorb;
         }
 
-        (*i)->GetModifier()->m_amount -= currentAbsorb;
+        (*i)->ChangeAmount((*i)->GetModifier()->m_amount - currentAbsorb, false);
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -3360,11 +3360,7 @@ void Unit::CalculateHealAbsorb(const uint32 heal, uint32* absorb)
         RemainingHeal -= currentAbsorb;
 
         // Reduce aura amount
-        mod->m_amount -= currentAbsorb;
-        if ((*i)->GetHolder()->DropAuraCharge())
-        {
-            mod->m_amount = 0;
-        }
+        (*i)->ChangeAmount((*i)->GetHolder()->DropAuraCharge() ? 0 : mod->m_amount - currentAbsorb, false);
         // Need remove it later
         if (mod->m_amount <= 0)
         {
@@ -4812,210 +4808,176 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+Unit::AuraModifierAggregate const& Unit::GetAuraModifierAggregate(AuraType auratype, AuraModifierFilter filter, uint32 value) const
 {
-    int32 modifier = 0;
+    uint64 key = (uint64(auratype) << 34) | (uint64(filter) << 32) | value;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    AuraModifierCache::iterator itr = m_auraModifierCache.lower_bound(key);
+    if (itr != m_auraModifierCache.end() && itr->first == key)
     {
-        modifier += (*i)->GetModifier()->m_amount;
+        return itr->second;
     }
 
-    return modifier;
-}
-
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
-{
-    float multiplier = 1.0f;
+    AuraModifierAggregate aggregate;
+    aggregate.total = 0;
+    aggregate.maxPositive = 0;
+    aggregate.maxNegative = 0;
+    aggregate.multiplier = 1.0f;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
-        multiplier *= (100.0f + (*i)->GetModifier()->m_amount) / 100.0f;
-    }
-
-    return multiplier;
-}
-
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
-{
-    int32 modifier = 0;
+        Modifier* mod = (*i)->GetModifier();
+        if ((filter == AURA_MOD_FILTER_MISC_VALUE && mod->m_miscvalue != int32(value)) ||
+            (filter == AURA_MOD_FILTER_MISC_MASK && !(mod->m_miscvalue & value)))
+        {
+            continue;
+        }
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount > modifier)
+        aggregate.total += mod->m_amount;
+        aggregate.multiplier *= (100.0f + mod->m_amount) / 100.0f;
+        if (mod->m_amount > aggregate.maxPositive)
         {
-            modifier = (*i)->GetModifier()->m_amount;
+            aggregate.maxPositive = mod->m_amount;
         }
+        if (mod->m_amount < aggregate.maxNegative)
+        {
+            aggregate.maxNegative = mod->m_amount;
+        }
+    }
 
-    return modifier;
+    return m_auraModifierCache.insert(itr, AuraModifierCache::value_type(key, aggregate))->second;
 }
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+void Unit::InvalidateAuraModifierCache(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount < modifier)
-        {
-            modifier = (*i)->GetModifier()->m_amount;
-        }
+    if (m_auraModifierCache.empty())
+    {
+        return;
+    }
 
-    return modifier;
+    m_auraModifierCache.erase(m_auraModifierCache.lower_bound(uint64(auratype) << 34),
+                              m_auraModifierCache.lower_bound(uint64(auratype + 1) << 34));
 }
 
-int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    if (!misc_mask)
+    if (m_modAuras[auratype].empty())
     {
         return 0;
     }
 
-    int32 modifier = 0;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_NONE, 0).total;
+}
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
+{
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask)
-        {
-            modifier += mod->m_amount;
-        }
+        return 1.0f;
     }
-    return modifier;
+
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_NONE, 0).multiplier;
 }
 
-float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
-    if (!misc_mask)
+    if (m_modAuras[auratype].empty())
     {
-        return 1.0f;
+        return 0;
     }
 
-    float multiplier = 1.0f;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_NONE, 0).maxPositive;
+}
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+{
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask)
-        {
-            multiplier *= (100.0f + mod->m_amount) / 100.0f;
-        }
+        return 0;
     }
-    return multiplier;
+
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_NONE, 0).maxNegative;
 }
 
-int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    if (!misc_mask || m_modAuras[auratype].empty())
     {
         return 0;
     }
 
-    int32 modifier = 0;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_MASK, misc_mask).total;
+}
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
+{
+    if (!misc_mask || m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask && mod->m_amount > modifier)
-        {
-            modifier = mod->m_amount;
-        }
+        return 1.0f;
     }
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_MASK, misc_mask).multiplier;
 }
 
-int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    if (!misc_mask || m_modAuras[auratype].empty())
     {
         return 0;
     }
 
-    int32 modifier = 0;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_MASK, misc_mask).maxPositive;
+}
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
+{
+    if (!misc_mask || m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask && mod->m_amount < modifier)
-        {
-            modifier = mod->m_amount;
-        }
+        return 0;
     }
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_MASK, misc_mask).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value)
-        {
-            modifier += mod->m_amount;
-        }
+        return 0;
     }
-    return modifier;
+
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_VALUE, uint32(misc_value)).total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value)
-        {
-            multiplier *= (100.0f + mod->m_amount) / 100.0f;
-        }
+        return 1.0f;
     }
-    return multiplier;
+
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_VALUE, uint32(misc_value)).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value && mod->m_amount > modifier)
-        {
-            modifier = mod->m_amount;
-        }
+        return 0;
     }
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_VALUE, uint32(misc_value)).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    if (m_modAuras[auratype].empty())
     {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value && mod->m_amount < modifier)
-        {
-            modifier = mod->m_amount;
-        }
+        return 0;
     }
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, AURA_MOD_FILTER_MISC_VALUE, uint32(misc_value)).maxNegative;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 mask) const
@@ -5275,6 +5237,7 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     // add aura, register in lists and arrays
     holder->_AddSpellAuraHolder();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddSpellAuraHolderToProcIndex(holder);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -5297,11 +5260,49 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     return true;
 }
 
+void Unit::AddSpellAuraHolderToProcIndex(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+
+    // same flags as checked first in IsTriggeredAtSpellProcEvent
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    uint32 procFlags = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->GetProcFlags();
+    bool interruptedByDamage = (spellProto->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE) != 0;
+
+    if (!procFlags && !interruptedByDamage)
+    {
+        return;
+    }
+
+    SpellAuraProcEntry entry;
+    entry.spellId = holder->GetId();
+    entry.procFlags = procFlags;
+    entry.interruptedByDamage = interruptedByDamage;
+    entry.holder = holder;
+
+    // multimap inserts behind equal keys, keep the same order for the index
+    m_spellAuraProcIndex.insert(std::upper_bound(m_spellAuraProcIndex.begin(), m_spellAuraProcIndex.end(), entry.spellId, SpellAuraProcEntry::SpellIdLess()), entry);
+}
+
+void Unit::RemoveSpellAuraHolderFromProcIndex(SpellAuraHolder* holder)
+{
+    std::pair<SpellAuraProcIndex::iterator, SpellAuraProcIndex::iterator> range = std::equal_range(m_spellAuraProcIndex.begin(), m_spellAuraProcIndex.end(), holder->GetId(), SpellAuraProcEntry::SpellIdLess());
+    for (SpellAuraProcIndex::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->holder == holder)
+        {
+            m_spellAuraProcIndex.erase(itr);
+            return;
+        }
+    }
+}
+
 void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraModifierCache(aura->GetModifier()->m_auraname);
     }
 }
 
@@ -6008,6 +6009,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            RemoveSpellAuraHolderFromProcIndex(holder);
             break;
         }
     }
@@ -6078,6 +6080,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        InvalidateAuraModifierCache(Aur->GetModifier()->m_auraname);
     }
 
     // Set remove mode
@@ -10066,7 +10069,7 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
 #ifdef ENABLE_ELUNA
     if (GetTypeId() == TYPEID_PLAYER)
     {
-        sEluna->OnPlayerEnterCombat(ToPlayer(), enemy);
+        GetEluna()->OnPlayerEnterCombat(ToPlayer(), enemy);
     }
 #endif /* ENABLE_ELUNA */
 }
@@ -10085,7 +10088,7 @@ void Unit::ClearInCombat()
 #ifdef ENABLE_ELUNA
     if (GetTypeId() == TYPEID_PLAYER)
     {
-        sEluna->OnPlayerLeaveCombat(ToPlayer());
+        GetEluna()->OnPlayerLeaveCombat(ToPlayer());
     }
 #endif /* ENABLE_ELUNA */
 
@@ -12323,6 +12326,7 @@ void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
     {
         tAuraProcTriggerDamage.remove(aura);
     }
+    InvalidateAuraModifierCache(SPELL_AURA_PROC_TRIGGER_DAMAGE);
 }
 
 uint32 Unit::GetCreatePowers(Powers power) const
@@ -12386,6 +12390,10 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    // a pending notification stays queued at the old map, let the next map schedule its own,
+    // the entry left behind no longer matches the generation once the unit is scheduled again
+    m_AINotifyScheduled = false;
+
     Object::RemoveFromWorld();
 }
 
@@ -12809,28 +12817,39 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
 
     RemoveSpellList removedSpells;
     ProcTriggeredList procTriggered;
+
+    // only holders able to react here are indexed, no other holder can pass the checks below
+    bool damageTaken = isVictim && (procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE);
+
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (SpellAuraProcIndex::const_iterator itr = m_spellAuraProcIndex.begin(); itr != m_spellAuraProcIndex.end(); ++itr)
     {
+        if (!(itr->procFlags & procFlag) && !(damageTaken && itr->interruptedByDamage))
+        {
+            continue;
+        }
+
+        SpellAuraHolder* holder = itr->holder;
+
         // skip deleted auras (possible at recursive triggered call
-        if (itr->second->GetState() != SPELLAURAHOLDER_STATE_READY || itr->second->IsDeleted())
+        if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
         {
             continue;
         }
 
         SpellProcEventEntry const* spellProcEvent = NULL;
         // check if that aura is triggered by proc event (then it will be managed by proc handler)
-        if (!IsTriggeredAtSpellProcEvent(pTarget, itr->second, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
+        if (!IsTriggeredAtSpellProcEvent(pTarget, holder, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent))
         {
             // spell seem not managed by proc system, although some case need to be handled
 
             // only process damage case on victim
-            if (!isVictim || !(procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE))
+            if (!damageTaken)
             {
                 continue;
             }
 
-            const SpellEntry* se = itr->second->GetSpellProto();
+            const SpellEntry* se = holder->GetSpellProto();
 
             // check if the aura is interruptible by damage and if its not just added by this spell (spell who is responsible for this damage is procSpell)
             if (se->GetAuraInterruptFlags() & AURA_INTERRUPT_FLAG_DAMAGE && (!procSpell || procSpell->Id != se->Id))
@@ -12841,8 +12860,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
             continue;
         }
 
-        itr->second->SetInUse(true);                        // prevent holder deletion
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        holder->SetInUse(true);                             // prevent holder deletion
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     if (!procTriggered.empty())
@@ -14076,45 +14095,14 @@ bool Unit::IsAllowedDamageInArea(Unit* pVictim) const
     return true;
 }
 
-class RelocationNotifyEvent : public BasicEvent
-{
-    public:
-        RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
-        {
-            m_owner._SetAINotifyScheduled(true);
-        }
-
-        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
-        {
-            float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.GetTypeId() == TYPEID_PLAYER)
-            {
-                MaNGOS::PlayerRelocationNotifier notify((Player&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if(m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            m_owner._SetAINotifyScheduled(false);
-            return true;
-        }
-
-        void Abort(uint64)
-        {
-            m_owner._SetAINotifyScheduled(false);
-        }
-
-    private:
-        Unit& m_owner;
-};
-
 void Unit::ScheduleAINotify(uint32 delay)
 {
-    if (!IsAINotifyScheduled())
+    // units out of world are queued again from AddToWorld
+    if (!IsAINotifyScheduled() && IsInWorld())
     {
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
+        m_AINotifyScheduled = true;
+        ++m_AINotifyGeneration;
+        GetMap()->ScheduleRelocationNotify(this, delay);
     }
 }
 
@@ -14137,6 +14125,20 @@ void Unit::OnRelocated()
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
 
+// turning further than this (radians) since the last full relay makes a heartbeat reach every observer
+#define MOVEMENT_LOD_ORIENTATION_DELTA 0.1f
+
+bool Unit::IsMovementStateBroadcast(uint32 moveFlags, float orientation) const
+{
+    return moveFlags == m_lastBroadcastMoveFlags && fabs(orientation - m_lastBroadcastOrientation) < MOVEMENT_LOD_ORIENTATION_DELTA;
+}
+
+void Unit::SetMovementStateBroadcast(uint32 moveFlags, float orientation)
+{
+    m_lastBroadcastMoveFlags = moveFlags;
+    m_lastBroadcastOrientation = orientation;
+}
+
 /*
  * @param entry             entry of the vehicle kit
  * @param overwriteNpcEntry use to select behaviour (like accessory) for this entry instead of GetEntry()'s result
@@ -3752,6 +3752,14 @@ class Unit : public WorldObject
         // misc have plain value but we check it fit to provided values mask (mask & (1 << (misc-1)))
         float GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 mask) const;
 
+        /**
+         * Drops the cached totals of the given \ref AuraType, must be called whenever
+         * an \ref Aura of that type is added, removed or its amount changes.
+         * @param auratype the aura type whose cached totals are outdated
+         * \see Unit::m_auraModifierCache
+         */
+        void InvalidateAuraModifierCache(AuraType auratype);
+
         Aura* GetDummyAura(uint32 spell_id) const;
 
         uint32 m_AuraFlags;
@@ -3919,9 +3927,15 @@ class Unit : public WorldObject
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from Map::ProcessRelocationNotifies
+        uint32 GetAINotifyGeneration() const { return m_AINotifyGeneration; }
         void OnRelocated();
 
+        // movement state last relayed to every observer of this unit, heartbeats that keep it are sent with level of detail
+        bool IsMovementStateBroadcast(uint32 moveFlags, float orientation) const;
+        void SetMovementStateBroadcast(uint32 moveFlags, float orientation);
+        uint32 NextMovementHeartbeat() { return ++m_movementHeartbeatCount; }
+
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
 
         virtual bool CanSwim() const = 0;
@@ -3967,6 +3981,31 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+
+        /**
+         * A \ref SpellAuraHolder that can react in \ref Unit::ProcDamageAndSpellFor, either
+         * by a proc event or by being interrupted by damage
+         */
+        struct SpellAuraProcEntry
+        {
+            uint32 spellId;                                 /**< same key as in \ref Unit::m_spellAuraHolders */
+            uint32 procFlags;                               /**< proc flags from spell_proc_event or the spell itself */
+            bool interruptedByDamage;                       /**< has AURA_INTERRUPT_FLAG_DAMAGE */
+            SpellAuraHolder* holder;                        /**< indexed holder, owned by \ref Unit::m_spellAuraHolders */
+
+            /** Orders entries and spell ids by spell id for the sorted index lookups. */
+            struct SpellIdLess
+            {
+                bool operator()(uint32 spellId, SpellAuraProcEntry const& entry) const { return spellId < entry.spellId; }
+                bool operator()(SpellAuraProcEntry const& entry, uint32 spellId) const { return entry.spellId < spellId; }
+            };
+        };
+        typedef std::vector<SpellAuraProcEntry> SpellAuraProcIndex;
+
+        void AddSpellAuraHolderToProcIndex(SpellAuraHolder* holder);
+        void RemoveSpellAuraHolderFromProcIndex(SpellAuraHolder* holder);
+
+        SpellAuraProcIndex m_spellAuraProcIndex;            // subset of m_spellAuraHolders in the same order, see ProcDamageAndSpellFor
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
 
@@ -3983,6 +4022,33 @@ class Unit : public WorldObject
         uint32 m_transform;
 
         AuraList m_modAuras[TOTAL_AURAS];
+
+        /**
+         * Totals of all modifiers of one \ref AuraType matching a misc value or mask,
+         * calculated in one pass over \ref Unit::m_modAuras
+         */
+        struct AuraModifierAggregate
+        {
+            int32 total;                                    /**< sum of the amounts */
+            int32 maxPositive;                              /**< highest positive amount, 0 if none */
+            int32 maxNegative;                              /**< lowest negative amount, 0 if none */
+            float multiplier;                               /**< product of (100 + amount) / 100 */
+        };
+
+        /// Which modifiers of an aura type an \ref AuraModifierAggregate covers
+        enum AuraModifierFilter
+        {
+            AURA_MOD_FILTER_NONE        = 0,                // all modifiers
+            AURA_MOD_FILTER_MISC_VALUE  = 1,                // m_miscvalue == value
+            AURA_MOD_FILTER_MISC_MASK   = 2                 // m_miscvalue & value
+        };
+
+        /// key is (auratype << 34) | (filter << 32) | value, so all entries of one aura type are adjacent
+        typedef std::map<uint64, AuraModifierAggregate> AuraModifierCache;
+
+        AuraModifierAggregate const& GetAuraModifierAggregate(AuraType auratype, AuraModifierFilter filter, uint32 value) const;
+
+        mutable AuraModifierCache m_auraModifierCache;      // filled on demand, see InvalidateAuraModifierCache
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
@@ -4029,6 +4095,10 @@ class Unit : public WorldObject
         UnitVisibility m_Visibility;
         Position m_last_notified_position;
         bool m_AINotifyScheduled;
+        uint32 m_AINotifyGeneration;                        // bumped per scheduled notification, older queue entries are skipped
+        uint32 m_lastBroadcastMoveFlags;                    // movement flags last relayed to the whole visible set
+        float m_lastBroadcastOrientation;                   // orientation last relayed to the whole visible set
+        uint32 m_movementHeartbeatCount;                    // heartbeats relayed with level of detail, selects the mid range ones
         TimeTracker m_movesplineTimer;
 
         Diminishing m_Diminishing;
@@ -154,7 +154,7 @@ void VehicleInfo::Initialize()
             int32 basepoint0 = itr->seatId + 1;
             summoned->CastCustomSpell((Unit*)m_owner, SPELL_RIDE_VEHICLE_HARDCODED, &basepoint0, NULL, NULL, true);
 #ifdef ENABLE_ELUNA
-            sEluna->OnInstallAccessory(this, summoned);
+            m_owner->GetEluna()->OnInstallAccessory(this, summoned);
 #endif
         }
     }
@@ -201,7 +201,7 @@ void VehicleInfo::Initialize()
     m_isInitialized = true;
 
 #ifdef ENABLE_ELUNA
-    sEluna->OnInstall(this);
+    m_owner->GetEluna()->OnInstall(this);
 #endif
 }
 
@@ -281,7 +281,7 @@ void VehicleInfo::Board(Unit* passenger, uint8 seat)
     ApplySeatMods(passenger, seatEntry->m_flags);
 
 #ifdef ENABLE_ELUNA
-    sEluna->OnAddPassenger(this, passenger, seat);
+    m_owner->GetEluna()->OnAddPassenger(this, passenger, seat);
 #endif
 }
 
@@ -407,7 +407,7 @@ void VehicleInfo::UnBoard(Unit* passenger, bool changeVehicle)
         }
     }
 #ifdef ENABLE_ELUNA
-    sEluna->OnRemovePassenger(this, passenger);
+    m_owner->GetEluna()->OnRemovePassenger(this, passenger);
 #endif
 
     // Some creature vehicles get despawned after passenger unboarding
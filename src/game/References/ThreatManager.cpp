@@ -250,6 +250,18 @@ void ThreatContainer::clearReferences()
     iThreatList.clear();
 }
 
+//============================================================
+// Keep the relative order of the remaining references, the list stays sorted
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    ThreatList::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), pRef);
+    if (itr != iThreatList.end())
+    {
+        iThreatList.erase(itr);
+    }
+}
+
 //============================================================
 // Return the HostileReference of NULL, if not found
 HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
@@ -301,20 +313,28 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 //============================================================
 
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and restore the order if necessary
+// Between two updates usually only a few references change their threat, so
+// an insertion sort only moves those entries instead of resorting the whole
+// list. It is stable, references with equal threat keep their order.
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        for (size_t i = 1; i < iThreatList.size(); ++i)
+        {
+            HostileReference* ref = iThreatList[i];
+            float threat = ref->getThreat();
+
+            size_t j = i;
+            for (; j > 0 && iThreatList[j - 1]->getThreat() < threat; --j)
+            {
+                iThreatList[j] = iThreatList[j - 1];
+            }
+            iThreatList[j] = ref;
+        }
     }
     iDirty = false;
 }
@@ -330,6 +350,11 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
     bool onlySecondChoiceTargetsFound = false;
     bool checkedCurrentVictim = false;
 
+    if (iThreatList.empty())
+    {
+        return NULL;
+    }
+
     ThreatList::const_iterator lastRef = iThreatList.end();
     --lastRef;
 
@@ -31,7 +31,7 @@
 #include "UnitEvents.h"
 #include "Timer.h"
 #include "ObjectGuid.h"
-#include <list>
+#include <vector>
 
 //==============================================================
 
@@ -140,7 +140,10 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// Kept contiguous and ordered by descending threat; the order is only restored
+// in ThreatContainer::update(), so adding or removing references invalidates
+// iterators held by callers - iterate over a copy if the loop body can do that.
+typedef std::vector<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
@@ -150,10 +153,10 @@ class ThreatContainer
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
+        void remove(HostileReference* pRef);
         void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
         void clearReferences();
-        // Sort the list if necessary
+        // Restore the threat order if necessary
         void update();
     public:
         ThreatContainer() { iDirty = false; }
@@ -0,0 +1,140 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup u2w
+*/
+
+#include "OpcodeStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+OpcodeStats sOpcodeStats;
+
+namespace
+{
+    bool SortByTotalTime(OpcodeStats::Row const& a, OpcodeStats::Row const& b)
+    {
+        return a.totalUs > b.totalUs;
+    }
+}
+
+char const* GetPacketProcessingName(PacketProcessing processing)
+{
+    switch (processing)
+    {
+        case PROCESS_INPLACE:
+            return "inplace";
+        case PROCESS_THREADUNSAFE:
+            return "world";
+        case PROCESS_THREADSAFE:
+            return "map";
+    }
+
+    return "unknown";
+}
+
+OpcodeStats::OpcodeStats()
+{
+    Reset();
+}
+
+void OpcodeStats::GetRows(RowList& rows, int32 processing) const
+{
+    rows.clear();
+
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        Entry const& entry = m_entries[opcode];
+
+        uint64 count = entry.count.load(std::memory_order_relaxed);
+        if (!count)
+        {
+            continue;
+        }
+
+        if (processing >= 0 && opcodeTable[opcode].packetProcessing != PacketProcessing(processing))
+        {
+            continue;
+        }
+
+        Row row;
+        row.opcode = uint16(opcode);
+        row.count = count;
+        row.totalUs = entry.totalUs.load(std::memory_order_relaxed);
+        row.maxUs = entry.maxUs.load(std::memory_order_relaxed);
+        row.bytes = entry.bytes.load(std::memory_order_relaxed);
+        rows.push_back(row);
+    }
+
+    std::sort(rows.begin(), rows.end(), SortByTotalTime);
+}
+
+bool OpcodeStats::WriteCsv(std::string const& filename) const
+{
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    RowList rows;
+    GetRows(rows);
+
+    uint32 period = GetPeriod();
+
+    fprintf(file, "opcode,name,processing,count,total_us,avg_us,max_us,bytes,per_second\n");
+    for (RowList::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        OpcodeHandler const& handler = opcodeTable[itr->opcode];
+        fprintf(file, "0x%04X,%s,%s," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD ",%.2f\n",
+                uint32(itr->opcode), handler.name, GetPacketProcessingName(handler.packetProcessing),
+                itr->count, itr->totalUs, itr->totalUs / itr->count, itr->maxUs, itr->bytes,
+                period ? double(itr->count) / period : 0.0);
+    }
+
+    fclose(file);
+    return true;
+}
+
+void OpcodeStats::Reset()
+{
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        Entry& entry = m_entries[opcode];
+        entry.count.store(0, std::memory_order_relaxed);
+        entry.totalUs.store(0, std::memory_order_relaxed);
+        entry.maxUs.store(0, std::memory_order_relaxed);
+        entry.bytes.store(0, std::memory_order_relaxed);
+    }
+
+    m_resetTime.store(time(NULL), std::memory_order_relaxed);
+}
+
+uint32 OpcodeStats::GetPeriod() const
+{
+    return uint32(time(NULL) - m_resetTime.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,143 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup u2w
+/// @{
+/// \file
+
+#ifndef MANGOS_H_OPCODESTATS
+#define MANGOS_H_OPCODESTATS
+
+#include "Common.h"
+#include "Opcodes.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per opcode handler counters: calls, handler time and packet bytes
+ *
+ * Recording is lock free, every counter is a relaxed atomic so sessions updated
+ * from map threads can record concurrently with the world thread. A reader sees
+ * values that are each exact but not necessarily from the same instant.
+ */
+class OpcodeStats
+{
+    public:
+        /**
+         * @brief Copy of the counters of one opcode
+         *
+         */
+        struct Row
+        {
+            uint16 opcode; /**< TODO */
+            uint64 count; /**< TODO */
+            uint64 totalUs; /**< TODO */
+            uint64 maxUs; /**< TODO */
+            uint64 bytes; /**< TODO */
+        };
+
+        typedef std::vector<Row> RowList;
+
+        OpcodeStats();
+
+        /**
+         * @brief Account one handler call
+         *
+         * @param opcode
+         * @param micros time spent in the handler
+         * @param bytes packet size
+         */
+        void Record(uint16 opcode, uint32 micros, size_t bytes)
+        {
+            Entry& entry = m_entries[opcode];
+            entry.count.fetch_add(1, std::memory_order_relaxed);
+            entry.totalUs.fetch_add(micros, std::memory_order_relaxed);
+            entry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+            uint64 max = entry.maxUs.load(std::memory_order_relaxed);
+            while (micros > max && !entry.maxUs.compare_exchange_weak(max, micros, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /**
+         * @brief Collect the opcodes seen since the last reset, sorted by total handler time
+         *
+         * @param rows
+         * @param processing only opcodes of this class, or -1 for all of them
+         */
+        void GetRows(RowList& rows, int32 processing = -1) const;
+
+        /**
+         * @brief Write every opcode seen since the last reset as CSV
+         *
+         * @param filename
+         * @return bool false if the file could not be opened
+         */
+        bool WriteCsv(std::string const& filename) const;
+
+        /**
+         * @brief Clear all counters and restart the sampling period
+         *
+         */
+        void Reset();
+
+        /**
+         * @brief Seconds since the counters were last cleared
+         *
+         * @return uint32
+         */
+        uint32 GetPeriod() const;
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        struct Entry
+        {
+            std::atomic<uint64> count; /**< TODO */
+            std::atomic<uint64> totalUs; /**< TODO */
+            std::atomic<uint64> maxUs; /**< TODO */
+            std::atomic<uint64> bytes; /**< TODO */
+        };
+
+        Entry m_entries[NUM_MSG_TYPES]; /**< indexed by opcode */
+        std::atomic<time_t> m_resetTime; /**< TODO */
+};
+
+extern OpcodeStats sOpcodeStats;
+
+/**
+ * @brief Short name of a packet processing class for reports
+ *
+ * @param processing
+ * @return char const*
+ */
+char const* GetPacketProcessingName(PacketProcessing processing);
+
+#endif
+/// @}
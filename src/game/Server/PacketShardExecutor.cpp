@@ -0,0 +1,139 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup u2w
+*/
+
+#include "PacketShardExecutor.h"
+#include "WorldSession.h"
+
+PacketShardExecutor::PacketShardExecutor() : m_pending(0)
+{
+}
+
+PacketShardExecutor::~PacketShardExecutor()
+{
+    Stop();
+}
+
+void PacketShardExecutor::Start(uint32 threads)
+{
+    for (uint32 i = 0; i < threads; ++i)
+    {
+        Worker* worker = new Worker();
+        worker->thread = std::thread(&PacketShardExecutor::Run, this, worker);
+        m_workers.push_back(worker);
+    }
+}
+
+void PacketShardExecutor::Stop()
+{
+    RunQueued();
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        Worker* worker = m_workers[i];
+        {
+            std::lock_guard<std::mutex> guard(worker->lock);
+            worker->stop = true;
+        }
+        worker->wake.notify_one();
+        worker->thread.join();
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+void PacketShardExecutor::Queue(uint64 key, WorldSession* session)
+{
+    // mix the id bits, guild and account ids are mostly consecutive numbers
+    uint64 hash = key * UI64LIT(0x9E3779B97F4A7C15);
+    Worker* worker = m_workers[(hash >> 32) % m_workers.size()];
+
+    std::lock_guard<std::mutex> guard(worker->lock);
+    worker->queue.push_back(session);
+}
+
+void PacketShardExecutor::RunQueued()
+{
+    std::unique_lock<std::mutex> idleGuard(m_idleLock);
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        Worker* worker = m_workers[i];
+        {
+            std::lock_guard<std::mutex> guard(worker->lock);
+            if (worker->queue.empty())
+            {
+                continue;
+            }
+
+            m_pending += uint32(worker->queue.size());
+            worker->active = true;
+        }
+        worker->wake.notify_one();
+    }
+
+    while (m_pending)
+    {
+        m_idle.wait(idleGuard);
+    }
+}
+
+void PacketShardExecutor::Run(Worker* worker)
+{
+    for (;;)
+    {
+        WorldSession* session;
+        {
+            std::unique_lock<std::mutex> guard(worker->lock);
+            while (!worker->active && !worker->stop)
+            {
+                worker->wake.wait(guard);
+            }
+
+            if (!worker->active)
+            {
+                return;
+            }
+
+            session = worker->queue.front();
+            worker->queue.pop_front();
+            if (worker->queue.empty())
+            {
+                worker->active = false;
+            }
+        }
+
+        session->ProcessShardedPackets();
+
+        std::lock_guard<std::mutex> guard(m_idleLock);
+        if (--m_pending == 0)
+        {
+            m_idle.notify_all();
+        }
+    }
+}
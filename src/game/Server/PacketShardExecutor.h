@@ -0,0 +1,132 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup u2w
+/// @{
+/// \file
+
+#ifndef MANGOS_H_PACKETSHARDEXECUTOR
+#define MANGOS_H_PACKETSHARDEXECUTOR
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorldSession;
+
+/**
+ * @brief Resource a sharded packet handler works on, sessions sharing it are run in order
+ *
+ */
+enum PacketShardType
+{
+    PACKET_SHARD_ACCOUNT  = 1,                              // the session and its own player only
+    PACKET_SHARD_GUILD    = 2,
+    PACKET_SHARD_CHANNEL  = 3
+};
+
+/**
+ * @brief Builds the key a sharded packet is queued under
+ *
+ * @param type
+ * @param id account id, guild id or channel name hash
+ * @return uint64
+ */
+inline uint64 MakePacketShardKey(PacketShardType type, uint32 id)
+{
+    return (uint64(type) << 32) | id;
+}
+
+/**
+ * @brief Runs the sharded thread-unsafe packets of World::UpdateSessions() on worker threads
+ *
+ * Sessions are queued on the world thread while it walks the session list,
+ * RunQueued() then runs them in parallel and returns once all are done, so
+ * no other part of the world update overlaps with a sharded handler. A key
+ * always maps to the same worker and every worker handles its queue in order:
+ * handlers sharing a guild or channel never overlap and keep the order they
+ * were received in.
+ */
+class PacketShardExecutor
+{
+    public:
+        PacketShardExecutor();
+        ~PacketShardExecutor();
+
+        /**
+         * @brief
+         *
+         * @param threads number of workers and shards
+         */
+        void Start(uint32 threads);
+        /**
+         * @brief Finish the queued sessions and join the workers
+         *
+         */
+        void Stop();
+
+        /**
+         * @brief Queue the packets stored in the session for the worker of the key
+         *
+         * @param key
+         * @param session not updated again before RunQueued() returned
+         */
+        void Queue(uint64 key, WorldSession* session);
+        /**
+         * @brief Let the workers process everything queued and wait for them
+         *
+         */
+        void RunQueued();
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        struct Worker
+        {
+            Worker() : active(false), stop(false) {}
+
+            std::thread thread; /**< TODO */
+            std::mutex lock; /**< TODO */
+            std::condition_variable wake; /**< TODO */
+            std::deque<WorldSession*> queue; /**< TODO */
+            bool active; /**< set by RunQueued(), cleared once the queue is empty */
+            bool stop; /**< TODO */
+        };
+
+        void Run(Worker* worker);
+
+        std::vector<Worker*> m_workers; /**< TODO */
+        std::mutex m_idleLock; /**< TODO */
+        std::condition_variable m_idle; /**< TODO */
+        uint32 m_pending; /**< sessions handed to the workers and not processed yet */
+};
+
+#endif
+/// @}
@@ -31,6 +31,8 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
+#include "PacketShardExecutor.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
@@ -56,6 +58,9 @@
 // Warden
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include <cctype>
+#include <chrono>
+#include <functional>
 #include <mutex>
 
 // select opcodes appropriate for processing in Map::Update context for current session state
@@ -106,6 +111,22 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return !MapSessionFilterHelper(m_pSession, opHandle);
 }
 
+// picks the packets following a sharded one that can go to the same shard
+class ShardBatchFilter : public PacketFilter
+{
+    public:
+        ShardBatchFilter(WorldSession* pSession, uint64 key) : PacketFilter(pSession), m_key(key) {}
+
+        virtual bool Process(WorldPacket* packet) override
+        {
+            uint64 key;
+            return m_pSession->GetPacketShardKey(packet, key) && key == m_key;
+        }
+
+    private:
+        uint64 m_key;
+};
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale) :
     m_muteTime(mute_time), _player(NULL), m_Socket(sock), _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
@@ -148,6 +169,11 @@ WorldSession::~WorldSession()
     {
         delete packet;
     }
+
+    for (std::vector<WorldPacket*>::const_iterator itr = m_shardedPackets.begin(); itr != m_shardedPackets.end(); ++itr)
+    {
+        delete *itr;
+    }
 }
 
 void WorldSession::SizeError(WorldPacket const& packet, uint32 size) const
@@ -265,118 +291,37 @@ bool WorldSession::Update(PacketFilter& updater)
     WorldPacket* packet = NULL;
     while (m_Socket && !m_Socket->IsClosed() && _recvQueue.next(packet, updater))
     {
-        /*#if 1
-        sLog.outError( "MOEP: %s (0x%.4X)",
-                        packet->GetOpcodeName(),
-                        packet->GetOpcode());
-        #endif*/
-
-        OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
-        try
-        {
-            switch (opHandle.status)
-            {
-                case STATUS_LOGGEDIN:
-                    if (!_player)
-                    {
-                        // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
-                        if (!m_playerRecentlyLogout)
-                        {
-                            LogUnexpectedOpcode(packet, "the player has not logged in yet");
-                        }
-                    }
-                    else if (_player->IsInWorld())
-                    {
-                        ExecuteOpcode(opHandle, packet);
-                    }
-
-                    // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
-
-#ifdef ENABLE_PLAYERBOTS
-              /*      if (_player && _player->GetPlayerbotMgr())
-                    {
-                        _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(*packet);
-                    }*/
-#endif
-                    break;
-                case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
-                    if (!_player && !m_playerRecentlyLogout)
-                    {
-                        LogUnexpectedOpcode(packet, "the player has not logged in yet and not recently logout");
-                    }
-                    else
-                        // not expected _player or must checked in packet hanlder
-                    {
-                        ExecuteOpcode(opHandle, packet);
-                    }
-                    break;
-                case STATUS_TRANSFER:
-                    if (!_player)
-                    {
-                        LogUnexpectedOpcode(packet, "the player has not logged in yet");
-                    }
-                    else if (_player->IsInWorld())
-                    {
-                        LogUnexpectedOpcode(packet, "the player is still in world");
-                    }
-                    else
-                    {
-                        ExecuteOpcode(opHandle, packet);
-                    }
-                    break;
-                case STATUS_AUTHED:
-                    // prevent cheating with skip queue wait
-                    if (m_inQueue)
-                    {
-                        LogUnexpectedOpcode(packet, "the player not pass queue yet");
-                        break;
-                    }
-
-                    // single from authed time opcodes send in to after logout time
-                    // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
-                    if (packet->GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
-                    {
-                        m_playerRecentlyLogout = false;
-                    }
-
-                    ExecuteOpcode(opHandle, packet);
-                    break;
-                case STATUS_NEVER:
-                    sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
-                                  packet->GetOpcodeName(),
-                                  packet->GetOpcode());
-                    break;
-                case STATUS_UNHANDLED:
-                    DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
-                              LookupOpcodeName(packet->GetOpcode()),
-                              packet->GetOpcode());
-                    break;
-                default:
-                    sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
-                                  packet->GetOpcodeName(),
-                                  packet->GetOpcode());
-                    break;
-            }
-        }
-        catch (ByteBufferException&)
+        PacketShardExecutor* shards = updater.GetShardExecutor();
+        uint64 shardKey;
+        if (shards && GetPacketShardKey(packet, shardKey))
         {
-            sLog.outError("WorldSession::Update ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i.",
-                          packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
-            if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+            // hand over the following packets of the same shard too, a guild bank
+            // window or a mail box opening sends several of them in a row
+            ShardBatchFilter batch(this, shardKey);
+            do
             {
-                DEBUG_LOG("Dumping error causing packet:");
-                packet->hexlike();
+                if (PrepareShardedPacket(packet))
+                {
+                    m_shardedPackets.push_back(packet);
+                }
+                else
+                {
+                    delete packet;
+                }
             }
+            while (_recvQueue.next(packet, batch));
 
-            if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+            if (m_shardedPackets.empty())
             {
-                DETAIL_LOG("Disconnecting session [account id %u / address %s] for badly formatted packet.",
-                           GetAccountId(), GetRemoteAddress().c_str());
-
-                KickPlayer();
+                continue;
             }
+
+            // the rest of the queue and the logout checks wait for the next update
+            shards->Queue(shardKey, this);
+            return true;
         }
 
+        ProcessPacket(packet);
         delete packet;
     }
 
@@ -421,6 +366,205 @@ bool WorldSession::Update(PacketFilter& updater)
     return true;
 }
 
+/// Check the session state the opcode requires and run its handler
+void WorldSession::ProcessPacket(WorldPacket* packet)
+{
+    /*#if 1
+    sLog.outError( "MOEP: %s (0x%.4X)",
+                    packet->GetOpcodeName(),
+                    packet->GetOpcode());
+    #endif*/
+
+    OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
+    try
+    {
+        switch (opHandle.status)
+        {
+            case STATUS_LOGGEDIN:
+                if (!_player)
+                {
+                    // skip STATUS_LOGGEDIN opcode unexpected errors if player logout sometime ago - this can be network lag delayed packets
+                    if (!m_playerRecentlyLogout)
+                    {
+                        LogUnexpectedOpcode(packet, "the player has not logged in yet");
+                    }
+                }
+                else if (_player->IsInWorld())
+                {
+                    ExecuteOpcode(opHandle, packet);
+                }
+
+                // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
+
+#ifdef ENABLE_PLAYERBOTS
+          /*      if (_player && _player->GetPlayerbotMgr())
+                {
+                    _player->GetPlayerbotMgr()->HandleMasterIncomingPacket(*packet);
+                }*/
+#endif
+                break;
+            case STATUS_LOGGEDIN_OR_RECENTLY_LOGGEDOUT:
+                if (!_player && !m_playerRecentlyLogout)
+                {
+                    LogUnexpectedOpcode(packet, "the player has not logged in yet and not recently logout");
+                }
+                else
+                    // not expected _player or must checked in packet hanlder
+                {
+                    ExecuteOpcode(opHandle, packet);
+                }
+                break;
+            case STATUS_TRANSFER:
+                if (!_player)
+                {
+                    LogUnexpectedOpcode(packet, "the player has not logged in yet");
+                }
+                else if (_player->IsInWorld())
+                {
+                    LogUnexpectedOpcode(packet, "the player is still in world");
+                }
+                else
+                {
+                    ExecuteOpcode(opHandle, packet);
+                }
+                break;
+            case STATUS_AUTHED:
+                // prevent cheating with skip queue wait
+                if (m_inQueue)
+                {
+                    LogUnexpectedOpcode(packet, "the player not pass queue yet");
+                    break;
+                }
+
+                // single from authed time opcodes send in to after logout time
+                // and before other STATUS_LOGGEDIN_OR_RECENTLY_LOGGOUT opcodes.
+                if (packet->GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
+                {
+                    m_playerRecentlyLogout = false;
+                }
+
+                ExecuteOpcode(opHandle, packet);
+                break;
+            case STATUS_NEVER:
+                sLog.outError("SESSION: received not allowed opcode %s (0x%.4X)",
+                              packet->GetOpcodeName(),
+                              packet->GetOpcode());
+                break;
+            case STATUS_UNHANDLED:
+                DEBUG_LOG("SESSION: received not handled opcode %s (0x%.4X)",
+                          LookupOpcodeName(packet->GetOpcode()),
+                          packet->GetOpcode());
+                break;
+            default:
+                sLog.outError("SESSION: received wrong-status-req opcode %s (0x%.4X)",
+                              packet->GetOpcodeName(),
+                              packet->GetOpcode());
+                break;
+        }
+    }
+    catch (ByteBufferException&)
+    {
+        sLog.outError("WorldSession::Update ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i.",
+                      packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+        if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
+        {
+            DEBUG_LOG("Dumping error causing packet:");
+            packet->hexlike();
+        }
+
+        if (sWorld.getConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET))
+        {
+            DETAIL_LOG("Disconnecting session [account id %u / address %s] for badly formatted packet.",
+                       GetAccountId(), GetRemoteAddress().c_str());
+
+            KickPlayer();
+        }
+    }
+}
+
+bool WorldSession::GetPacketShardKey(WorldPacket const* packet, uint64& key) const
+{
+    switch (packet->GetOpcode())
+    {
+        // only queues an async query for the account's characters
+        case CMSG_CHAR_ENUM:
+            key = MakePacketShardKey(PACKET_SHARD_ACCOUNT, GetAccountId());
+            return true;
+
+        // also sent from the character screen, before any player is loaded
+        case CMSG_GUILD_QUERY:
+            if (packet->size() < sizeof(uint64))
+            {
+                return false;
+            }
+
+            key = MakePacketShardKey(PACKET_SHARD_GUILD, ObjectGuid(packet->read<uint64>(0)).GetCounter());
+            return true;
+
+        // read or reset state of the player's own guild only, opening the bank
+        // creates its tab items and stays on the world thread
+        case CMSG_GUILD_ROSTER:
+        case CMSG_GUILD_QUERY_RANKS:
+        case CMSG_GUILD_PERMISSIONS:
+        case CMSG_GUILD_EVENT_LOG_QUERY:
+        case CMSG_GUILD_BANK_LOG_QUERY:
+        case CMSG_GUILD_BANK_MONEY_WITHDRAWN:
+        case CMSG_QUERY_GUILD_BANK_TEXT:
+            if (!_player || !_player->GetGuildId())
+            {
+                return false;
+            }
+
+            key = MakePacketShardKey(PACKET_SHARD_GUILD, _player->GetGuildId());
+            return true;
+
+        case CMSG_CHANNEL_LIST:
+        case CMSG_CHANNEL_DISPLAY_LIST:
+        {
+            // the name length is the first byte, see HandleChannelListOpcode()
+            if (packet->empty() || packet->size() < size_t(1 + packet->read<uint8>(0)))
+            {
+                return false;
+            }
+
+            std::string name(reinterpret_cast<char const*>(packet->contents() + 1), packet->read<uint8>(0));
+            for (std::string::iterator itr = name.begin(); itr != name.end(); ++itr)
+            {
+                *itr = char(tolower(uint8(*itr)));
+            }
+
+            key = MakePacketShardKey(PACKET_SHARD_CHANNEL, uint32(std::hash<std::string>()(name)));
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool WorldSession::PrepareShardedPacket(WorldPacket* packet)
+{
+#ifdef ENABLE_ELUNA
+    if (!sEluna->OnPacketReceive(this, *packet))
+    {
+        return false;
+    }
+#endif /* ENABLE_ELUNA */
+
+    return true;
+}
+
+void WorldSession::ProcessShardedPackets()
+{
+    for (std::vector<WorldPacket*>::const_iterator itr = m_shardedPackets.begin(); itr != m_shardedPackets.end(); ++itr)
+    {
+        ProcessPacket(*itr);
+        delete *itr;
+    }
+
+    m_shardedPackets.clear();
+}
+
 #ifdef ENABLE_PLAYERBOTS
 void WorldSession::HandleBotPackets()
 {
@@ -590,6 +734,7 @@ void WorldSession::LogoutPlayer(bool Save)
             }
 
             guild->BroadcastEvent(GE_SIGNED_OFF, _player->GetObjectGuid(), _player->GetName());
+            guild->RemoveOnlineMember(_player);
         }
 
         ///- Remove pet
@@ -1253,7 +1398,8 @@ void WorldSession::SendRedirectClient(std::string& ip, uint16 port)
 void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet)
 {
 #ifdef ENABLE_ELUNA
-    if (!sEluna->OnPacketReceive(this, *packet))
+    // sharded packets went through the hook on the world thread already
+    if (m_shardedPackets.empty() && !sEluna->OnPacketReceive(this, *packet))
     {
         return;
     }
@@ -1266,6 +1412,8 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* pac
         _player->SetCanDelayTeleport(true);
     }
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     (this->*opHandle.handler)(*packet);
 
     if (_player)
@@ -1281,6 +1429,10 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* pac
         }
     }
 
+    // a teleport delayed by the handler is charged to the opcode that caused it
+    uint32 micros = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    sOpcodeStats.Record(packet->GetOpcode(), micros, packet->size());
+
     if (packet->rpos() < packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
     {
         LogUnprocessedTail(packet);
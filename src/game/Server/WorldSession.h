@@ -61,6 +61,7 @@ class MovementInfo;
 class WorldSession;
 
 struct OpcodeHandler;
+class PacketShardExecutor;
 
 enum AccountDataType
 {
@@ -197,6 +198,11 @@ class PacketFilter
         {
             return true;
         }
+        // executor for the sharded packets of this update, NULL to run every packet in place
+        virtual PacketShardExecutor* GetShardExecutor() const
+        {
+            return NULL;
+        }
 
     protected:
         WorldSession* const m_pSession;
@@ -221,10 +227,17 @@ class MapSessionFilter : public PacketFilter
 class WorldSessionFilter : public PacketFilter
 {
     public:
-        explicit WorldSessionFilter(WorldSession* pSession) : PacketFilter(pSession) {}
+        explicit WorldSessionFilter(WorldSession* pSession, PacketShardExecutor* shards = NULL) : PacketFilter(pSession), m_shards(shards) {}
         ~WorldSessionFilter() {}
 
         virtual bool Process(WorldPacket* packet) override;
+        virtual PacketShardExecutor* GetShardExecutor() const override
+        {
+            return m_shards;
+        }
+
+    private:
+        PacketShardExecutor* m_shards;
 };
 
 /// Player session in the World
@@ -339,6 +352,11 @@ class WorldSession
 
         bool Update(PacketFilter& updater);
 
+        /// Whether the packet may run on a shard worker, and the resource it is serialized on
+        bool GetPacketShardKey(WorldPacket const* packet, uint64& key) const;
+        /// Run the packets handed to the shard executor, called on its worker thread
+        void ProcessShardedPackets();
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -990,7 +1008,9 @@ class WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo, ObjectGuid const& guid) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
+        void ProcessPacket(WorldPacket* packet);
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet);
+        bool PrepareShardedPacket(WorldPacket* packet);
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, const char* reason);
@@ -1024,6 +1044,7 @@ class WorldSession
         TutorialDataState m_tutorialState;
         AddonsList m_addonsList;
         ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        std::vector<WorldPacket*> m_shardedPackets;         // queued on the shard executor, the session is skipped until they ran
 };
 #endif
 /// @}
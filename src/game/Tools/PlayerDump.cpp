@@ -493,6 +493,7 @@ DumpReturn PlayerDumpWriter::WriteDump(const std::string& file, uint32 guid)
 DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, std::string name, uint32 guid)
 {
     bool nameInvalidated = false;                           // set when name changed or will requested changed at next login
+    CharacterIdentity identity;                             // of the loaded character, known to ObjectMgr once committed
 
     // check character count
     uint32 charcount = sAccountMgr.GetCharactersCount(account);
@@ -715,6 +716,12 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                     nameInvalidated = true;
                 }
 
+                identity.name = getnth(line, 3);            // characters.name
+                identity.account = account;
+                identity.race = uint8(atoi(getnth(line, 4).c_str()));
+                identity.playerClass = uint8(atoi(getnth(line, 5).c_str()));
+                identity.gender = uint8(atoi(getnth(line, 6).c_str()));
+                identity.level = uint32(atoi(getnth(line, 7).c_str()));
                 break;
             }
             case DTT_INVENTORY:
@@ -921,6 +928,8 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
 
     CharacterDatabase.CommitTransaction();
 
+    sObjectMgr.SetCharacterIdentity(ObjectGuid(HIGHGUID_PLAYER, guid), identity);
+
     // FIXME: current code with post-updating guids not safe for future per-map threads
     sObjectMgr.m_ItemGuids.Set(sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed() + items.size());
     sObjectMgr.m_MailIds.Set(sObjectMgr.m_MailIds.GetNextAfterMaxUsed() +  mails.size());
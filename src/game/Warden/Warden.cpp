@@ -29,6 +29,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "ByteBuffer.h"
+#include <openssl/md5.h>
 #include <openssl/sha.h>
 #include "World.h"
 #include "Util.h"
@@ -36,6 +37,14 @@
 #include "AccountMgr.h"
 #include "GameTime.h"
 
+WardenModuleHash::WardenModuleHash(uint8 const* data, uint32 length)
+{
+    MD5_CTX ctx;
+    MD5_Init(&ctx);
+    MD5_Update(&ctx, data, length);
+    MD5_Final(Id, &ctx);
+}
+
 Warden::Warden() : _session(NULL), _inputCrypto(16), _outputCrypto(16), _checkTimer(10000/*10 sec*/), _clientResponseTimer(0),
                    _module(NULL), _state(WardenState::STATE_INITIAL)
 {
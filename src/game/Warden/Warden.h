@@ -145,6 +145,14 @@ struct ClientWardenModule
     uint8* CompressedData;
 };
 
+// MD5 of a module, held in a function local static so it is computed once and not per session
+struct WardenModuleHash
+{
+    WardenModuleHash(uint8 const* data, uint32 length);
+
+    uint8 Id[16];
+};
+
 class WorldSession;
 
 class Warden
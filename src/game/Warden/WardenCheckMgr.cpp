@@ -29,10 +29,12 @@
 #include "WorldSession.h"
 #include "Log.h"
 #include "Database/DatabaseEnv.h"
+#include "HMACSHA1.h"
+#include "Util.h"
 #include "WardenCheckMgr.h"
 #include "Warden.h"
 
-WardenCheckMgr::WardenCheckMgr() : m_lock(0), CheckStore(), CheckResultStore() { }
+WardenCheckMgr::WardenCheckMgr() : m_lock(0), CheckStore(), CheckResultStore(), BuildStore() { }
 
 WardenCheckMgr::~WardenCheckMgr()
 {
@@ -48,6 +50,7 @@ WardenCheckMgr::~WardenCheckMgr()
 
     CheckStore.clear();
     CheckResultStore.clear();
+    BuildStore.clear();
 }
 
 void WardenCheckMgr::LoadWardenChecks()
@@ -150,9 +153,136 @@ void WardenCheckMgr::LoadWardenChecks()
         ++count;
     } while (result->NextRow());
 
+    delete result;
+
+    // index the checks by id and assemble the requests once instead of per session
+    for (CheckMap::const_iterator it = CheckStore.begin(); it != CheckStore.end(); ++it)
+    {
+        std::vector<WardenCheck*>& checks = BuildStore[it->first].Checks;
+        if (checks.size() <= it->second->CheckId)
+        {
+            checks.resize(it->second->CheckId + 1, NULL);
+        }
+        checks[it->second->CheckId] = it->second;
+    }
+
+    for (CheckResultMap::const_iterator it = CheckResultStore.begin(); it != CheckResultStore.end(); ++it)
+    {
+        std::vector<WardenCheckResult*>& results = BuildStore[it->first].Results;
+        if (results.size() <= it->second->Id)
+        {
+            results.resize(it->second->Id + 1, NULL);
+        }
+        results[it->second->Id] = it->second;
+    }
+
     sLog.outString(">> Loaded %u warden checks.", count);
 
-    delete result;
+    BuildCheckBatches();
+}
+
+void WardenCheckMgr::BuildCheckBatches()
+{
+    ACE_WRITE_GUARD(LOCK, g, m_lock)
+
+    uint32 batches = 0;
+    for (BuildCheckMap::iterator it = BuildStore.begin(); it != BuildStore.end(); ++it)
+    {
+        std::list<uint16> ids;
+
+        CollectCheckIds(true, it->first, ids);
+        BuildCheckBatches(it->second, true, ids);
+
+        CollectCheckIds(false, it->first, ids);
+        BuildCheckBatches(it->second, false, ids);
+
+        batches += it->second.MemBatches.size() + it->second.OtherBatches.size();
+    }
+
+    sLog.outString(">> Assembled %u warden check batches.", batches);
+}
+
+void WardenCheckMgr::BuildCheckBatches(BuildChecks& checks, bool isMemCheck, std::list<uint16> const& ids)
+{
+    std::vector<WardenCheckBatch>& batches = isMemCheck ? checks.MemBatches : checks.OtherBatches;
+    batches.clear();
+
+    uint32 perBatch = sWorld.getConfig(isMemCheck ? CONFIG_UINT32_WARDEN_NUM_MEM_CHECKS : CONFIG_UINT32_WARDEN_NUM_OTHER_CHECKS);
+    if (!perBatch || ids.empty())
+    {
+        return;
+    }
+
+    // sessions used to work off their check lists from the back, keep that order
+    std::list<uint16>::const_reverse_iterator itr = ids.rbegin();
+    while (itr != ids.rend())
+    {
+        batches.push_back(WardenCheckBatch());
+        WardenCheckBatch& batch = batches.back();
+
+        uint8 index = 1;                                    // string references, mem batches never have any
+
+        for (uint32 i = 0; i < perBatch && itr != ids.rend(); ++i, ++itr)
+        {
+            WardenCheck* wd = checks.Checks[*itr];
+
+            batch.Ids.push_back(*itr);
+            batch.TypeOffsets.push_back(uint32(batch.Requests.wpos()));
+            batch.Requests << uint8(wd->Type);
+
+            switch (wd->Type)
+            {
+                case MEM_CHECK:
+                {
+                    batch.Requests << uint8(0x00);
+                    batch.Requests << uint32(wd->Address);
+                    batch.Requests << uint8(wd->Length);
+                    break;
+                }
+                case PAGE_CHECK_A:
+                case PAGE_CHECK_B:
+                {
+                    batch.Requests.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
+                    batch.Requests << uint32(wd->Address);
+                    batch.Requests << uint8(wd->Length);
+                    break;
+                }
+                case MPQ_CHECK:
+                case LUA_STR_CHECK:
+                {
+                    batch.Strings << uint8(wd->Str.size());
+                    batch.Strings.append(wd->Str.c_str(), wd->Str.size());
+                    batch.Requests << uint8(index++);
+                    break;
+                }
+                case DRIVER_CHECK:
+                {
+                    batch.Strings << uint8(wd->Str.size());
+                    batch.Strings.append(wd->Str.c_str(), wd->Str.size());
+                    batch.Requests.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
+                    batch.Requests << uint8(index++);
+                    break;
+                }
+                case MODULE_CHECK:
+                {
+                    // seed and HMAC must not repeat, WardenWin fills them in for every request
+                    WardenModuleRequest module;
+                    module.Offset = uint32(batch.Requests.wpos());
+                    module.Name = wd->Str;
+                    batch.Modules.push_back(module);
+
+                    batch.Requests << uint32(0);
+                    for (int b = 0; b < SHA_DIGEST_LENGTH; ++b)
+                    {
+                        batch.Requests << uint8(0);
+                    }
+                    break;
+                }
+                default:
+                    break;                                  // PROC_CHECK support missing
+            }
+        }
+    }
 }
 
 void WardenCheckMgr::LoadWardenOverrides()
@@ -215,12 +345,10 @@ WardenCheck* WardenCheckMgr::GetWardenDataById(uint16 build, uint16 id)
     WardenCheck* result = NULL;
 
     ACE_READ_GUARD_RETURN(LOCK, g, m_lock, result)
-    for (CheckMap::iterator it = CheckStore.lower_bound(build); it != CheckStore.upper_bound(build); ++it)
+    BuildCheckMap::const_iterator it = BuildStore.find(build);
+    if (it != BuildStore.end() && id < it->second.Checks.size())
     {
-        if (it->second->CheckId == id)
-        {
-            result = it->second;
-        }
+        result = it->second.Checks[id];
     }
 
     return result;
@@ -231,23 +359,46 @@ WardenCheckResult* WardenCheckMgr::GetWardenResultById(uint16 build, uint16 id)
     WardenCheckResult* result = NULL;
 
     ACE_READ_GUARD_RETURN(LOCK, g, m_lock, result)
-    for (CheckResultMap::iterator it = CheckResultStore.lower_bound(build); it != CheckResultStore.upper_bound(build); ++it)
+    BuildCheckMap::const_iterator it = BuildStore.find(build);
+    if (it != BuildStore.end() && id < it->second.Results.size())
     {
-        if (it->second->Id == id)
-        {
-            result = it->second;
-        }
+        result = it->second.Results[id];
     }
 
     return result;
 }
 
+bool WardenCheckMgr::GetWardenCheckBatch(bool isMemCheck, uint16 build, uint32 index, WardenCheckBatch& batch)
+{
+    // copied under the lock, a config reload may reassemble the batches meanwhile
+    ACE_READ_GUARD_RETURN(LOCK, g, m_lock, false)
+    BuildCheckMap::const_iterator it = BuildStore.find(build);
+    if (it == BuildStore.end())
+    {
+        return false;
+    }
+
+    std::vector<WardenCheckBatch> const& batches = isMemCheck ? it->second.MemBatches : it->second.OtherBatches;
+    if (batches.empty())
+    {
+        return false;
+    }
+
+    batch = batches[index % batches.size()];
+    return true;
+}
+
 void WardenCheckMgr::GetWardenCheckIds(bool isMemCheck, uint16 build, std::list<uint16>& idl)
+{
+    ACE_READ_GUARD(LOCK, g, m_lock)
+    CollectCheckIds(isMemCheck, build, idl);
+}
+
+void WardenCheckMgr::CollectCheckIds(bool isMemCheck, uint16 build, std::list<uint16>& idl) const
 {
     idl.clear(); //just to be sure
 
-    ACE_READ_GUARD(LOCK, g, m_lock)
-    for (CheckMap::iterator it = CheckStore.lower_bound(build); it != CheckStore.upper_bound(build); ++it)
+    for (CheckMap::const_iterator it = CheckStore.lower_bound(build); it != CheckStore.upper_bound(build); ++it)
     {
         if (isMemCheck)
         {
@@ -27,7 +27,9 @@
 #define _WARDENCHECKMGR_H
 
 #include <map>
+#include <vector>
 #include "BigNumber.h"
+#include "ByteBuffer.h"
 
 enum WardenActions
 {
@@ -54,6 +56,23 @@ struct WardenCheckResult
     BigNumber Result;                                       // MEM_CHECK
 };
 
+// MODULE_CHECK of a batch, its seed and HMAC are generated for every request
+struct WardenModuleRequest
+{
+    uint32 Offset;                                          // position of the seed in Requests, the HMAC follows it
+    std::string Name;                                       // module name the HMAC is computed over
+};
+
+// Checks sent together in one request, assembled when the checks are loaded
+struct WardenCheckBatch
+{
+    std::vector<uint16> Ids;                                // in the order the client answers them
+    ByteBuffer Strings;                                     // names referenced by MPQ, LUA and DRIVER checks
+    ByteBuffer Requests;                                    // check data, type bytes are not xored yet
+    std::vector<uint32> TypeOffsets;                        // positions of the type bytes in Requests
+    std::vector<WardenModuleRequest> Modules;               // module checks, their seed and HMAC are zero in Requests
+};
+
 class WardenCheckMgr
 {
     private:
@@ -70,8 +89,12 @@ class WardenCheckMgr
         WardenCheck* GetWardenDataById(uint16 /*build*/, uint16 /*id*/);
         WardenCheckResult* GetWardenResultById(uint16 /*build*/, uint16 /*id*/);
         void GetWardenCheckIds(bool isMemCheck /* true = MEM */, uint16 build, std::list<uint16>& list);
+        // copies batch number index, wraps around; false if the build has no such checks
+        bool GetWardenCheckBatch(bool isMemCheck /* true = MEM */, uint16 build, uint32 index, WardenCheckBatch& batch);
 
         void LoadWardenChecks();
+        // reassembles the batches, called when Warden.NumMemChecks / Warden.NumOtherChecks may have changed
+        void BuildCheckBatches();
         void LoadWardenOverrides();
 
     private:
@@ -79,9 +102,23 @@ class WardenCheckMgr
         typedef std::multimap< uint16, WardenCheck* > CheckMap;
         typedef std::multimap< uint16, WardenCheckResult* > CheckResultMap;
 
+        // flat lookup tables of one build, indexed by check id
+        struct BuildChecks
+        {
+            std::vector<WardenCheck*> Checks;
+            std::vector<WardenCheckResult*> Results;
+            std::vector<WardenCheckBatch> MemBatches;
+            std::vector<WardenCheckBatch> OtherBatches;
+        };
+        typedef std::map< uint16, BuildChecks > BuildCheckMap;
+
+        void CollectCheckIds(bool isMemCheck, uint16 build, std::list<uint16>& idl) const;
+        void BuildCheckBatches(BuildChecks& checks, bool isMemCheck, std::list<uint16> const& ids);
+
         LOCK           m_lock;
         CheckMap       CheckStore;
         CheckResultMap CheckResultStore;
+        BuildCheckMap  BuildStore;
 
 };
 
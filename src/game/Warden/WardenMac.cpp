@@ -87,11 +87,9 @@ ClientWardenModule* WardenMac::GetModuleForClient()
     memcpy(mod->CompressedData, Module_0DBBF209A27B1E279A9FEC5C168A15F7_Data, len);
     memcpy(mod->Key, Module_0DBBF209A27B1E279A9FEC5C168A15F7_Key, 16);
 
-    // md5 hash
-    MD5_CTX ctx;
-    MD5_Init(&ctx);
-    MD5_Update(&ctx, mod->CompressedData, len);
-    MD5_Final((uint8*)&mod->Id, &ctx);
+    // md5 hash, the module is the same for every client
+    static WardenModuleHash const hash(Module_0DBBF209A27B1E279A9FEC5C168A15F7_Data, len);
+    memcpy(mod->Id, hash.Id, 16);
 
     return mod;
 }
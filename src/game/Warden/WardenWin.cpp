@@ -31,7 +31,6 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "ByteBuffer.h"
-#include <openssl/md5.h>
 #include "Database/DatabaseEnv.h"
 #include "World.h"
 #include "Player.h"
@@ -41,7 +40,7 @@
 #include "WardenCheckMgr.h"
 #include "GameTime.h"
 
-WardenWin::WardenWin() : Warden(), _serverTicks(0) {}
+WardenWin::WardenWin() : Warden(), _serverTicks(0), _memBatchIndex(urand(0, 0xFFFF)), _otherBatchIndex(urand(0, 0xFFFF)) {}
 
 WardenWin::~WardenWin() { }
 
@@ -82,11 +81,9 @@ ClientWardenModule* WardenWin::GetModuleForClient()
     memcpy(mod->CompressedData, Module.Module, length);
     memcpy(mod->Key, Module.ModuleKey, 16);
 
-    // md5 hash
-    MD5_CTX ctx;
-    MD5_Init(&ctx);
-    MD5_Update(&ctx, mod->CompressedData, length);
-    MD5_Final((uint8*)&mod->Id, &ctx);
+    // md5 hash, the module is the same for every client
+    static WardenModuleHash const hash(Module.Module, length);
+    memcpy(mod->Id, hash.Id, 16);
 
     return mod;
 }
@@ -165,77 +162,23 @@ void WardenWin::RequestData()
     sLog.outWarden("Request data");
 
     uint16 build = _session->GetClientBuild();
-    uint16 id = 0;
-    uint8 type = 0;
-    WardenCheck* wd = NULL;
 
-    // If all checks were done, fill the todo list again
-    if (_memChecksTodo.empty())
-    {
-        sWardenCheckMgr->GetWardenCheckIds(true, build, _memChecksTodo);
-    }
-
-    if (_otherChecksTodo.empty())
-    {
-        sWardenCheckMgr->GetWardenCheckIds(false, build, _otherChecksTodo);
-    }
+    // requests are assembled when the checks are loaded, a session only walks through them
+    WardenCheckBatch memBatch;
+    WardenCheckBatch otherBatch;
+    bool hasMemBatch = sWardenCheckMgr->GetWardenCheckBatch(true, build, _memBatchIndex++, memBatch);
+    bool hasOtherBatch = sWardenCheckMgr->GetWardenCheckBatch(false, build, _otherBatchIndex++, otherBatch);
 
     _serverTicks = GameTime::GetGameTimeMS();
 
     _currentChecks.clear();
 
-    // Build check request
-    for (uint16 i = 0; i < sWorld.getConfig(CONFIG_UINT32_WARDEN_NUM_MEM_CHECKS); ++i)
-    {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_memChecksTodo.empty())
-        {
-            break;
-        }
-
-        // Get check id from the end and remove it from todo
-        id = _memChecksTodo.back();
-        _memChecksTodo.pop_back();
-
-        // Add the id to the list sent in this cycle
-        _currentChecks.push_back(id);
-    }
-
     ByteBuffer buff;
     buff << uint8(WARDEN_SMSG_CHEAT_CHECKS_REQUEST);
 
-    for (uint16 i = 0; i < sWorld.getConfig(CONFIG_UINT32_WARDEN_NUM_OTHER_CHECKS); ++i)
+    if (hasOtherBatch)
     {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_otherChecksTodo.empty())
-        {
-            break;
-        }
-
-        // Get check id from the end and remove it from todo
-        id = _otherChecksTodo.back();
-        _otherChecksTodo.pop_back();
-
-        // Add the id to the list sent in this cycle
-        _currentChecks.push_back(id);
-
-        // if we are here, the function is guaranteed to not return NULL
-        // but ... who knows
-        wd = sWardenCheckMgr->GetWardenDataById(build, id);
-        if (wd)
-        {
-            switch (wd->Type)
-            {
-                case MPQ_CHECK:
-                case LUA_STR_CHECK:
-                case DRIVER_CHECK:
-                    buff << uint8(wd->Str.size());
-                    buff.append(wd->Str.c_str(), wd->Str.size());
-                    break;
-                default:
-                    break;
-            }
-        }
+        buff.append(otherBatch.Strings);
     }
 
     uint8 xorByte = _inputKey[0];
@@ -244,66 +187,16 @@ void WardenWin::RequestData()
     buff << uint8(0x00);
     buff << uint8(TIMING_CHECK ^ xorByte);
 
-    uint8 index = 1;
-
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    if (hasMemBatch)
     {
-        wd = sWardenCheckMgr->GetWardenDataById(build, *itr);
+        AppendCheckBatch(buff, memBatch, xorByte);
+    }
 
-        type = wd->Type;
-        buff << uint8(type ^ xorByte);
-        switch (type)
-        {
-            case MEM_CHECK:
-            {
-                buff << uint8(0x00);
-                buff << uint32(wd->Address);
-                buff << uint8(wd->Length);
-                break;
-            }
-            case PAGE_CHECK_A:
-            case PAGE_CHECK_B:
-            {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
-                buff << uint32(wd->Address);
-                buff << uint8(wd->Length);
-                break;
-            }
-            case MPQ_CHECK:
-            case LUA_STR_CHECK:
-            {
-                buff << uint8(index++);
-                break;
-            }
-            case DRIVER_CHECK:
-            {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
-                buff << uint8(index++);
-                break;
-            }
-            case MODULE_CHECK:
-            {
-                uint32 seed = rand32();
-                buff << uint32(seed);
-                HMACSHA1 hmac(4, (uint8*)&seed);
-                hmac.UpdateData(wd->Str);
-                hmac.Finalize();
-                buff.append(hmac.GetDigest(), hmac.GetLength());
-                break;
-            }
-            /*case PROC_CHECK:
-            {
-                buff.append(wd->i.AsByteArray(0, false).get(), wd->i.GetNumBytes());
-                buff << uint8(index++);
-                buff << uint8(index++);
-                buff << uint32(wd->Address);
-                buff << uint8(wd->Length);
-                break;
-            }*/
-            default:
-                break;                                      // Should never happen
-        }
+    if (hasOtherBatch)
+    {
+        AppendCheckBatch(buff, otherBatch, xorByte);
     }
+
     buff << uint8(xorByte);
     buff.hexlike();
 
@@ -316,7 +209,7 @@ void WardenWin::RequestData()
 
     std::stringstream stream;
     stream << "Sent check id's: ";
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
     {
         stream << *itr << " ";
     }
@@ -326,6 +219,31 @@ void WardenWin::RequestData()
     Warden::RequestData();
 }
 
+void WardenWin::AppendCheckBatch(ByteBuffer& buff, WardenCheckBatch const& batch, uint8 xorByte)
+{
+    size_t start = buff.wpos();
+    buff.append(batch.Requests);
+
+    for (std::vector<uint32>::const_iterator itr = batch.TypeOffsets.begin(); itr != batch.TypeOffsets.end(); ++itr)
+    {
+        buff[start + *itr] ^= xorByte;
+    }
+
+    // a fresh seed per request, recorded answers must not match a later one
+    for (std::vector<WardenModuleRequest>::const_iterator itr = batch.Modules.begin(); itr != batch.Modules.end(); ++itr)
+    {
+        uint32 seed = rand32();
+        HMACSHA1 hmac(4, (uint8*)&seed);
+        hmac.UpdateData(itr->Name);
+        hmac.Finalize();
+
+        buff.put<uint32>(start + itr->Offset, seed);
+        buff.put(start + itr->Offset + 4, hmac.GetDigest(), hmac.GetLength());
+    }
+
+    _currentChecks.insert(_currentChecks.end(), batch.Ids.begin(), batch.Ids.end());
+}
+
 void WardenWin::HandleData(ByteBuffer &buff)
 {
     sLog.outWarden("Handle data");
@@ -369,7 +287,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
     uint8 type;
     uint16 checkFailed = 0;
 
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
     {
         rd = sWardenCheckMgr->GetWardenDataById(_session->GetClientBuild(), *itr);
         rs = sWardenCheckMgr->GetWardenResultById(_session->GetClientBuild(), *itr);
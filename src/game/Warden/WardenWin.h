@@ -87,10 +87,12 @@ class WardenWin : public Warden
         void HandleData(ByteBuffer &buff) override;
 
     private:
+        void AppendCheckBatch(ByteBuffer& buff, WardenCheckBatch const& batch, uint8 xorByte);
+
         uint32 _serverTicks;
-        std::list<uint16> _otherChecksTodo;
-        std::list<uint16> _memChecksTodo;
-        std::list<uint16> _currentChecks;
+        uint32 _memBatchIndex;                       // next batches to send, sessions start at random ones
+        uint32 _otherBatchIndex;
+        std::vector<uint16> _currentChecks;
 };
 
 #endif
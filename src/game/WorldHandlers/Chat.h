@@ -246,6 +246,8 @@ class ChatHandler
         bool HandleDebugAnimCommand(char* args);
         bool HandleDebugArenaCommand(char* args);
         bool HandleDebugBattlegroundCommand(char* args);
+        bool HandleDebugDbScriptsCommand(char* args);
+        bool HandleDebugPacketPoolCommand(char* args);
         bool HandleDebugGetItemStateCommand(char* args);
         bool HandleDebugGetItemValueCommand(char* args);
         bool HandleDebugGetLootRecipientCommand(char* args);
@@ -560,6 +562,9 @@ class ChatHandler
         bool HandleServerLogFilterCommand(char* args);
         bool HandleServerLogLevelCommand(char* args);
         bool HandleServerMotdCommand(char* args);
+        bool HandleServerOpcodeStatsCommand(char* args);
+        bool HandleServerOpcodeStatsCsvCommand(char* args);
+        bool HandleServerOpcodeStatsResetCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
         bool HandleServerResetAllRaidCommand(char* args);
         bool HandleServerRestartCommand(char* args);
@@ -147,6 +147,27 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
     }
 }
 
+void MovementLodDeliverer::Visit(CameraMapType& m)
+{
+    // cached positions are the viewpoints, a far sight camera may be far away from its owner
+    m.visitInRange(i_mover->GetPositionX(), i_mover->GetPositionY(), i_radius, *this);
+}
+
+void MovementLodDeliverer::operator()(Camera* camera)
+{
+    Player* owner = camera->GetOwner();
+
+    if (!owner->InSamePhase(i_phaseMask) || owner == i_skipped_receiver)
+    {
+        return;
+    }
+
+    if (WorldSession* session = owner->GetSession())
+    {
+        session->SendPacket(i_message);
+    }
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
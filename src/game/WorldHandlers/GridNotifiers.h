@@ -83,6 +83,26 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    /**
+     * Relays a movement heartbeat to the cameras within the radius the caller picked
+     * for its level of detail band, using the cells' cached camera positions.
+     */
+    struct MovementLodDeliverer
+    {
+        WorldObject const* i_mover;
+        uint32        i_phaseMask;
+        WorldPacket*  i_message;
+        Player const* i_skipped_receiver;
+        float         i_radius;
+
+        MovementLodDeliverer(WorldObject const* mover, WorldPacket* msg, Player const* skipped, float radius)
+            : i_mover(mover), i_phaseMask(mover->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped), i_radius(radius) {}
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        void operator()(Camera* camera);
+    };
+
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
@@ -128,24 +148,21 @@ namespace MaNGOS
         void Visit(CreatureMapType&);
     };
 
-    struct PlayerRelocationNotifier
+    /**
+     * Relocation notifier for all units that moved near one cell: every unit found
+     * in the visited cell is matched against each of the movers.
+     */
+    struct RelocationBatchNotifier
     {
-        Player& i_player;
-        PlayerRelocationNotifier(Player& pl) : i_player(pl) {}
+        std::vector<Player*> const& i_players;
+        std::vector<Creature*> const& i_creatures;
+        RelocationBatchNotifier(std::vector<Player*> const& players, std::vector<Creature*> const& creatures)
+            : i_players(players), i_creatures(creatures) {}
         template<class T> void Visit(GridRefManager<T>&) {}
+        void Visit(PlayerMapType&);
         void Visit(CreatureMapType&);
     };
 
-    struct CreatureRelocationNotifier
-    {
-        Creature& i_creature;
-        CreatureRelocationNotifier(Creature& c) : i_creature(c) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
-#ifdef WIN32
-        template<> void Visit(PlayerMapType&);
-#endif
-    };
-
     struct DynamicObjectUpdater
     {
         DynamicObject& i_dynobject;
@@ -1391,9 +1408,6 @@ namespace MaNGOS
     };
 
 #ifndef WIN32
-    template<> void PlayerRelocationNotifier::Visit<Creature>(CreatureMapType&);
-    template<> void CreatureRelocationNotifier::Visit<Player>(PlayerMapType&);
-    template<> void CreatureRelocationNotifier::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Player>(PlayerMapType&);
 #endif
@@ -85,55 +85,55 @@ inline void CreatureCreatureRelocationWorker(Creature* c1, Creature* c2)
     }
 }
 
-inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType& m)
+inline void MaNGOS::RelocationBatchNotifier::Visit(PlayerMapType& m)
 {
-    if (!i_player.IsAlive() || i_player.IsTaxiFlying())
+    if (i_creatures.empty())
     {
         return;
     }
 
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        Creature* c = iter->getSource();
-        if (c->IsAlive())
+        Player* player = iter->getSource();
+        if (!player->IsAlive() || player->IsTaxiFlying())
         {
-            PlayerCreatureRelocationWorker(&i_player, c);
+            continue;
         }
-    }
-}
 
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType& m)
-{
-    if (!i_creature.IsAlive())
-    {
-        return;
-    }
-
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Player* player = iter->getSource();
-        if (player->IsAlive() && !player->IsTaxiFlying())
+        for (std::vector<Creature*>::const_iterator itr = i_creatures.begin(); itr != i_creatures.end(); ++itr)
         {
-            PlayerCreatureRelocationWorker(player, &i_creature);
+            if ((*itr)->IsAlive())
+            {
+                PlayerCreatureRelocationWorker(player, *itr);
+            }
         }
     }
 }
 
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType& m)
+inline void MaNGOS::RelocationBatchNotifier::Visit(CreatureMapType& m)
 {
-    if (!i_creature.IsAlive())
-    {
-        return;
-    }
-
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Creature* c = iter->getSource();
-        if (c != &i_creature && c->IsAlive())
+        if (!c->IsAlive())
         {
-            CreatureCreatureRelocationWorker(c, &i_creature);
+            continue;
+        }
+
+        for (std::vector<Player*>::const_iterator itr = i_players.begin(); itr != i_players.end(); ++itr)
+        {
+            if ((*itr)->IsAlive() && !(*itr)->IsTaxiFlying())
+            {
+                PlayerCreatureRelocationWorker(*itr, c);
+            }
+        }
+
+        for (std::vector<Creature*>::const_iterator itr = i_creatures.begin(); itr != i_creatures.end(); ++itr)
+        {
+            if (*itr != c && (*itr)->IsAlive())
+            {
+                CreatureCreatureRelocationWorker(c, *itr);
+            }
         }
     }
 }
@@ -423,6 +423,7 @@ void WorldSession::HandleGuildPromoteOpcode(WorldPacket& recvPacket)
     uint32 newRankId = slot->RankId - 1;                    // when promoting player, rank is decreased
 
     slot->ChangeRank(newRankId);
+    guild->InvalidateRoster();
     // Put record into guild log
     guild->LogGuildEvent(GUILD_EVENT_LOG_PROMOTE_PLAYER, GetPlayer()->GetObjectGuid(), slot->guid, newRankId);
 
@@ -487,6 +488,7 @@ void WorldSession::HandleGuildDemoteOpcode(WorldPacket& recvPacket)
     uint32 newRankId = slot->RankId + 1;                    // when demoting player, rank is increased
 
     slot->ChangeRank(newRankId);
+    guild->InvalidateRoster();
     // Put record into guild log
     guild->LogGuildEvent(GUILD_EVENT_LOG_DEMOTE_PLAYER, GetPlayer()->GetObjectGuid(), slot->guid, newRankId);
 
@@ -579,6 +581,7 @@ void WorldSession::HandleGuildSetRankOpcode(WorldPacket& recvPacket)
     }
 
     slot->ChangeRank(newRankId);
+    guild->InvalidateRoster();
     // Put record into guild log
     guild->LogGuildEvent(promote ? GUILD_EVENT_LOG_PROMOTE_PLAYER : GUILD_EVENT_LOG_DEMOTE_PLAYER, GetPlayer()->GetObjectGuid(), slot->guid, newRankId);
 
@@ -742,6 +745,7 @@ void WorldSession::HandleGuildLeaderOpcode(WorldPacket& recvPacket)
     guild->SetLeader(slot->guid);
     // NOTE: GR_OFFICER might not actually be officer rank
     oldSlot->ChangeRank(GR_OFFICER);
+    guild->InvalidateRoster();
 
     guild->BroadcastEvent(GE_LEADER_CHANGED, oldLeader->GetName(), name.c_str());
 }
@@ -822,6 +826,7 @@ void WorldSession::HandleGuildSetNoteOpcode(WorldPacket& recvPacket)
         slot->SetPNOTE(note);
     }
 
+    guild->InvalidateRoster();
     guild->Roster(this);
 }
 
@@ -46,6 +46,7 @@
 #include "Calendar.h"
 #include "Chat.h"
 #include "Weather.h"
+#include "G3D/Vector3.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -53,7 +54,7 @@
 Map::~Map()
 {
 #ifdef ENABLE_ELUNA
-    sEluna->OnDestroy(this);
+    GetEluna()->OnDestroy(this);
 #endif /* ENABLE_ELUNA */
 
     UnloadAll(true);
@@ -87,6 +88,15 @@ Map::~Map()
 
     delete m_weatherSystem;
     m_weatherSystem = NULL;
+
+#ifdef ENABLE_ELUNA
+    // after the objects, their timed events are registered with the state
+    if (m_eluna)
+    {
+        Eluna::DestroyMapState(m_eluna);
+        m_eluna = NULL;
+    }
+#endif /* ENABLE_ELUNA */
 }
 
 void Map::LoadMapAndVMap(int gx, int gy)
@@ -105,10 +115,14 @@ void Map::LoadMapAndVMap(int gx, int gy)
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
-      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
+      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_movementLodNearDistance(0.0f), m_movementLodMidDistance(0.0f), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL)
+      m_scriptTime(0), i_data(NULL)
+#ifdef ENABLE_ELUNA
+      , m_eluna(NULL)
+#endif /* ENABLE_ELUNA */
+      , m_losCacheGeneration(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -134,7 +148,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
 
     m_weatherSystem = new WeatherSystem(this);
 #ifdef ENABLE_ELUNA
-    sEluna->OnCreate(this);
+    m_eluna = Eluna::CreateMapState(this);
+    GetEluna()->OnCreate(this);
 #endif /* ENABLE_ELUNA */
 }
 
@@ -142,6 +157,8 @@ void Map::InitVisibilityDistance()
 {
     // init visibility for continents
     m_VisibleDistance = World::GetMaxVisibleDistanceOnContinents();
+    m_movementLodNearDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_CONTINENTS);
+    m_movementLodMidDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_MID_CONTINENTS);
 }
 
 // Template specialization of utility methods
@@ -348,8 +365,8 @@ bool Map::Add(Player* player)
     UpdateObjectVisibility(player, cell, p);
 
 #ifdef ENABLE_ELUNA
-    sEluna->OnMapChanged(player);
-    sEluna->OnPlayerEnter(this, player);
+    GetEluna()->OnMapChanged(player);
+    GetEluna()->OnPlayerEnter(this, player);
 #endif /* ENABLE_ELUNA */
 
     if (i_data)
@@ -505,6 +522,7 @@ bool Map::loaded(const GridPair& p) const
 
 void Map::Update(const uint32& t_diff)
 {
+    m_scriptTime += t_diff;
     m_dyn_tree.update(t_diff);
 
     /// update worldsessions for existing players
@@ -531,6 +549,12 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    ///- Respawn dead creatures that are due, they are not polled by their own updates
+    if (!m_respawnSchedule.empty())
+    {
+        ProcessRespawnSchedule();
+    }
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -615,6 +639,8 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    ProcessRelocationNotifies(t_diff);
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -639,7 +665,11 @@ void Map::Update(const uint32& t_diff)
     }
 
 #ifdef ENABLE_ELUNA
-    sEluna->OnUpdate(this, t_diff);
+    if (m_eluna)
+    {
+        m_eluna->UpdateMapState(t_diff);
+    }
+    GetEluna()->OnUpdate(this, t_diff);
 #endif /* ENABLE_ELUNA */
 
     if (i_data)
@@ -650,10 +680,50 @@ void Map::Update(const uint32& t_diff)
     m_weatherSystem->UpdateWeathers(t_diff);
 }
 
+#ifdef ENABLE_ELUNA
+Eluna* Map::GetEluna() const
+{
+    return m_eluna ? m_eluna : sEluna;
+}
+
+Eluna** Map::GetElunaHandle()
+{
+    return m_eluna ? &m_eluna : &Eluna::GEluna;
+}
+#endif /* ENABLE_ELUNA */
+
+void Map::ScheduleRespawn(ObjectGuid guid, time_t respawnTime)
+{
+    m_respawnSchedule.insert(RespawnScheduleMap::value_type(respawnTime, guid));
+}
+
+void Map::ProcessRespawnSchedule()
+{
+    time_t now = time(NULL);
+
+    while (!m_respawnSchedule.empty())
+    {
+        RespawnScheduleMap::iterator itr = m_respawnSchedule.begin();
+        if (itr->first > now)
+        {
+            break;
+        }
+
+        ObjectGuid guid = itr->second;
+        m_respawnSchedule.erase(itr);
+
+        // unloaded with its grid meanwhile, loading it again schedules it again
+        if (Creature* creature = GetAnyTypeCreature(guid))
+        {
+            creature->RespawnIfDue();
+        }
+    }
+}
+
 void Map::Remove(Player* player, bool remove)
 {
 #ifdef ENABLE_ELUNA
-    sEluna->OnPlayerLeave(this, player);
+    GetEluna()->OnPlayerLeave(this, player);
 #endif /* ENABLE_ELUNA */
 
     if (i_data)
@@ -837,6 +907,115 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     MANGOS_ASSERT(CheckGridIntegrity(creature, true));
 }
 
+// orders the cell/mover pairs of the relocation pass by cell only
+struct CellMoverLess
+{
+    bool operator()(std::pair<uint32, Unit*> const& a, std::pair<uint32, Unit*> const& b) const
+    {
+        return a.first < b.first;
+    }
+};
+
+void Map::ScheduleRelocationNotify(Unit* unit, uint32 delay)
+{
+    RelocationNotifyRequest request;
+    request.guid = unit->GetObjectGuid();
+    request.generation = unit->GetAINotifyGeneration();
+    request.delay = delay;
+    m_relocationNotifyQueue.push_back(request);
+}
+
+void Map::ProcessRelocationNotifies(uint32 diff)
+{
+    if (m_relocationNotifyQueue.empty())
+    {
+        return;
+    }
+
+    // collect the due units, the others wait for a later tick
+    std::vector<Unit*> movers;
+    size_t waiting = 0;
+    for (size_t i = 0; i < m_relocationNotifyQueue.size(); ++i)
+    {
+        RelocationNotifyRequest request = m_relocationNotifyQueue[i];
+        if (request.delay > diff)
+        {
+            request.delay -= diff;
+            m_relocationNotifyQueue[waiting++] = request;
+            continue;
+        }
+
+        // the unit may have left the map or been removed and queued again meanwhile
+        Unit* unit = GetUnit(request.guid);
+        if (!unit || unit->GetMap() != this || !unit->IsInWorld() || !unit->IsAINotifyScheduled() || unit->GetAINotifyGeneration() != request.generation)
+        {
+            continue;
+        }
+
+        unit->_SetAINotifyScheduled(false);
+        if (unit->IsPositionValid())
+        {
+            movers.push_back(unit);
+        }
+    }
+    m_relocationNotifyQueue.resize(waiting);
+
+    if (movers.empty())
+    {
+        return;
+    }
+
+    // list every cell each mover has to look at, then order by cell so that
+    // every cell is visited once for all movers interested in it
+    float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+    typedef std::pair<uint32, Unit*> CellMover;
+    std::vector<CellMover> cellMovers;
+    for (std::vector<Unit*>::const_iterator itr = movers.begin(); itr != movers.end(); ++itr)
+    {
+        Unit* mover = *itr;
+        CellArea area = Cell::CalculateCellArea(mover->GetPositionX(), mover->GetPositionY(), radius + mover->GetObjectBoundingRadius());
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                cellMovers.push_back(CellMover((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x, mover));
+            }
+        }
+    }
+    std::stable_sort(cellMovers.begin(), cellMovers.end(), CellMoverLess());
+
+    std::vector<Player*> players;
+    std::vector<Creature*> creatures;
+    MaNGOS::RelocationBatchNotifier notifier(players, creatures);
+    TypeContainerVisitor<MaNGOS::RelocationBatchNotifier, GridTypeMapContainer > grid_notifier(notifier);
+    TypeContainerVisitor<MaNGOS::RelocationBatchNotifier, WorldTypeMapContainer > world_notifier(notifier);
+
+    for (size_t i = 0; i < cellMovers.size();)
+    {
+        uint32 cell_id = cellMovers[i].first;
+        players.clear();
+        creatures.clear();
+        for (; i < cellMovers.size() && cellMovers[i].first == cell_id; ++i)
+        {
+            Unit* mover = cellMovers[i].second;
+            if (mover->GetTypeId() == TYPEID_PLAYER)
+            {
+                players.push_back((Player*)mover);
+            }
+            else
+            {
+                creatures.push_back((Creature*)mover);
+            }
+        }
+
+        CellPair pair(cell_id % TOTAL_NUMBER_OF_CELLS_PER_MAP, cell_id / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_notifier);
+        Visit(cell, world_notifier);
+    }
+}
+
 bool Map::CreatureCellRelocation(Creature* c, const Cell& new_cell)
 {
     Cell const& old_cell = c->GetCurrentCell();
@@ -1125,11 +1304,11 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 #ifdef ENABLE_ELUNA
     if (Creature* creature = obj->ToCreature())
     {
-        sEluna->OnRemove(creature);
+        GetEluna()->OnRemove(creature);
     }
     else if (GameObject* gameobject = obj->ToGameObject())
     {
-        sEluna->OnRemove(gameobject);
+        GetEluna()->OnRemove(gameobject);
     }
 #endif /* ENABLE_ELUNA */
 
@@ -1549,6 +1728,8 @@ void DungeonMap::InitVisibilityDistance()
 {
     // init visibility distance for instances
     m_VisibleDistance = World::GetMaxVisibleDistanceInInstances();
+    m_movementLodNearDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_INSTANCES);
+    m_movementLodMidDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_MID_INSTANCES);
 }
 
 /*
@@ -1840,6 +2021,8 @@ void BattleGroundMap::InitVisibilityDistance()
 {
     // init visibility distance for BG/Arenas
     m_VisibleDistance = World::GetMaxVisibleDistanceInBGArenas();
+    m_movementLodNearDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_BGARENAS);
+    m_movementLodMidDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_LOD_MID_BGARENAS);
 }
 
 bool BattleGroundMap::CanEnter(Player* player)
@@ -1904,6 +2087,12 @@ bool Map::CanEnter(Player* player)
     return true;
 }
 
+/// Key of the script schedule index
+static inline uint64 MakeScriptScheduleKey(DBScriptType type, uint32 id)
+{
+    return (uint64(type) << 32) | id;
+}
+
 /// Put scripts in the execution queue
 bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* target, ScriptExecutionParam execParams /*=SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE_TARGET*/)
 {
@@ -1929,11 +2118,12 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        std::pair<ScriptScheduleIndex::const_iterator, ScriptScheduleIndex::const_iterator> range = m_scriptScheduleIndex.equal_range(MakeScriptScheduleKey(type, id));
+        for (ScriptScheduleIndex::const_iterator searchItr = range.first; searchItr != range.second; ++searchItr)
         {
-            if (searchItr->second.IsSameScript(type, id,
-                                               (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
-                                               (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
+            if (searchItr->second->second.IsSameScript(type, id,
+                                                       (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE) ? sourceGuid : ObjectGuid(),
+                                                       (execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET) ? targetGuid : ObjectGuid(), ownerGuid))
             {
                 DEBUG_LOG("DB-SCRIPTS: Process table `dbscripts [type=%d]` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", type, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
                 return true;
@@ -1945,11 +2135,7 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
     ScriptChain const* s2 = &(s->second);
     for (ScriptChain::const_iterator iter = s2->begin(); iter != s2->end(); ++iter)
     {
-        ScriptAction sa(type, this, sourceGuid, targetGuid, ownerGuid, &(*iter));
-
-        m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + iter->delay), sa));
-
-        sScriptMgr.IncreaseScheduledScriptsCount();
+        ScheduleScriptStep(iter->delay, ScriptAction(type, this, sourceGuid, targetGuid, ownerGuid, &(*iter)));
     }
 
     return true;
@@ -1964,55 +2150,82 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     ObjectGuid targetGuid = target ? target->GetObjectGuid() : ObjectGuid();
     ObjectGuid ownerGuid  = source->isType(TYPEMASK_ITEM) ? ((Item*)source)->GetOwnerGuid() : ObjectGuid();
 
-    ScriptAction sa(DBS_INTERNAL, this, sourceGuid, targetGuid, ownerGuid, &script);
+    ScheduleScriptStep(delay, ScriptAction(DBS_INTERNAL, this, sourceGuid, targetGuid, ownerGuid, &script));
+}
 
-    m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
+/// Queue a step to run delay seconds from now
+void Map::ScheduleScriptStep(uint32 delay, ScriptAction const& step)
+{
+    ScriptScheduleMap::iterator itr = m_scriptSchedule.insert(ScriptScheduleMap::value_type(m_scriptTime + uint64(delay) * IN_MILLISECONDS, step));
+    m_scriptScheduleIndex.insert(ScriptScheduleIndex::value_type(MakeScriptScheduleKey(step.GetType(), step.GetId()), itr));
 
     sScriptMgr.IncreaseScheduledScriptsCount();
 }
 
-/// Process queued scripts
-void Map::ScriptsProcess()
+void Map::UnscheduleScriptStep(ScriptScheduleMap::iterator itr)
 {
-    if (m_scriptSchedule.empty())
+    std::pair<ScriptScheduleIndex::iterator, ScriptScheduleIndex::iterator> range = m_scriptScheduleIndex.equal_range(MakeScriptScheduleKey(itr->second.GetType(), itr->second.GetId()));
+    for (ScriptScheduleIndex::iterator idxItr = range.first; idxItr != range.second; ++idxItr)
     {
-        return;
+        if (idxItr->second == itr)
+        {
+            m_scriptScheduleIndex.erase(idxItr);
+            break;
+        }
     }
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= sWorld.GetGameTime()))
+    m_scriptSchedule.erase(itr);
+
+    sScriptMgr.DecreaseScheduledScriptCount();
+}
+
+/// Process queued scripts
+void Map::ScriptsProcess()
+{
+    ///- Process overdue queued scripts, the multimap is sorted by due time
+    while (!m_scriptSchedule.empty())
     {
-        if (iter->second.HandleScriptStep())
+        ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
+        if (iter->first > m_scriptTime)
         {
-            // Terminate following script steps of this script
-            DBScriptType type = iter->second.GetType();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
+            break;
+        }
 
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
-            {
-                if (rmItr->second.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
-                {
-                    m_scriptSchedule.erase(rmItr++);
-                    sScriptMgr.DecreaseScheduledScriptCount();
-                }
-                else
-                {
-                    ++rmItr;
-                }
-            }
+        uint32 lag = uint32(m_scriptTime - iter->first);
+        ++m_scriptStats.executed;
+        m_scriptStats.totalLag += lag;
+        if (lag > m_scriptStats.maxLag)
+        {
+            m_scriptStats.maxLag = lag;
         }
-        else
+
+        if (!iter->second.HandleScriptStep())
         {
-            m_scriptSchedule.erase(iter);
+            UnscheduleScriptStep(iter);
+            continue;
+        }
 
-            sScriptMgr.DecreaseScheduledScriptCount();
+        // Terminate following script steps of this script, the current one included
+        DBScriptType type = iter->second.GetType();
+        uint32 id = iter->second.GetId();
+        ObjectGuid sourceGuid = iter->second.GetSourceGuid();
+        ObjectGuid targetGuid = iter->second.GetTargetGuid();
+        ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
+
+        std::pair<ScriptScheduleIndex::iterator, ScriptScheduleIndex::iterator> range = m_scriptScheduleIndex.equal_range(MakeScriptScheduleKey(type, id));
+        for (ScriptScheduleIndex::iterator rmItr = range.first; rmItr != range.second;)
+        {
+            if (rmItr->second->second.IsSameScript(type, id, sourceGuid, targetGuid, ownerGuid))
+            {
+                m_scriptSchedule.erase(rmItr->second);
+                m_scriptScheduleIndex.erase(rmItr++);
+                sScriptMgr.DecreaseScheduledScriptCount();
+            }
+            else
+            {
+                ++rmItr;
+            }
         }
-        iter = m_scriptSchedule.begin();
     }
 }
 
@@ -2297,8 +2510,133 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+    bool found;
+    uint64 key = MakeLineOfSightKey(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+    LineOfSightCacheEntry* entry = FindLineOfSightEntry(key, found);
+    if (found)
+    {
+        return entry->inLineOfSight;
+    }
+
+    bool result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
+                  && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+
+    if (entry)
+    {
+        entry->key = key;
+        entry->checkTime = getMSTime();
+        entry->generation = m_losCacheGeneration;
+        entry->inLineOfSight = result;
+    }
+
+    return result;
+}
+
+/**
+ * Line of sight from one point to many, cached results are used where valid and the
+ * dynamic tree is searched once for the rest instead of once per target
+ */
+void Map::IsInLineOfSight(float srcX, float srcY, float srcZ, LineOfSightTarget* targets, uint32 count, uint32 phasemask) const
+{
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+
+    std::vector<uint32> pending;
+    std::vector<G3D::Vector3> ends;
+    std::vector<uint64> keys;
+    pending.reserve(count);
+    ends.reserve(count);
+    keys.reserve(count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        LineOfSightTarget& target = targets[i];
+
+        bool found;
+        uint64 key = MakeLineOfSightKey(srcX, srcY, srcZ, target.x, target.y, target.z, phasemask);
+        if (LineOfSightCacheEntry* entry = FindLineOfSightEntry(key, found))
+        {
+            if (found)
+            {
+                target.inLineOfSight = entry->inLineOfSight;
+                continue;
+            }
+        }
+
+        target.inLineOfSight = vMapManager->isInLineOfSight(GetId(), srcX, srcY, srcZ, target.x, target.y, target.z);
+        pending.push_back(i);
+        ends.push_back(G3D::Vector3(target.x, target.y, target.z));
+        keys.push_back(key);
+    }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    bool* results = new bool[pending.size()];
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        results[i] = targets[pending[i]].inLineOfSight;
+    }
+
+    m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, &ends[0], results, uint32(pending.size()), phasemask);
+
+    uint32 now = getMSTime();
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        targets[pending[i]].inLineOfSight = results[i];
+
+        bool found;
+        if (LineOfSightCacheEntry* entry = FindLineOfSightEntry(keys[i], found))
+        {
+            entry->key = keys[i];
+            entry->checkTime = now;
+            entry->generation = m_losCacheGeneration;
+            entry->inLineOfSight = results[i];
+        }
+    }
+
+    delete[] results;
+}
+
+uint64 Map::MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask)
+{
+    // half yard steps, both directions of a line share the key
+    int32 a[3] = { int32(floor(x1 * 2.0f)), int32(floor(y1 * 2.0f)), int32(floor(z1 * 2.0f)) };
+    int32 b[3] = { int32(floor(x2 * 2.0f)), int32(floor(y2 * 2.0f)), int32(floor(z2 * 2.0f)) };
+    if (std::lexicographical_compare(b, b + 3, a, a + 3))
+    {
+        std::swap_ranges(a, a + 3, b);
+    }
+
+    uint64 key = UI64LIT(0xCBF29CE484222325) ^ phasemask;
+    for (int i = 0; i < 3; ++i)
+    {
+        key = (key ^ uint32(a[i])) * UI64LIT(0x100000001B3);
+        key = (key ^ uint32(b[i])) * UI64LIT(0x100000001B3);
+    }
+    return key;
+}
+
+Map::LineOfSightCacheEntry* Map::FindLineOfSightEntry(uint64 key, bool& found) const
+{
+    found = false;
+
+    uint32 cacheTime = sWorld.getConfig(CONFIG_UINT32_VMAP_LOS_CACHE_TIME);
+    if (!cacheTime)
+    {
+        return NULL;
+    }
+
+    if (m_losCache.empty())
+    {
+        m_losCache.resize(LOS_CACHE_SIZE);
+    }
+
+    // the low key bits depend on the low coordinate bits only, mix all of them into the slot
+    LineOfSightCacheEntry& entry = m_losCache[((key * UI64LIT(0x9E3779B97F4A7C15)) >> 32) % LOS_CACHE_SIZE];
+    found = entry.key == key && entry.generation == m_losCacheGeneration && GetMSTimeDiffToNow(entry.checkTime) < cacheTime;
+    return &entry;
 }
 
 /**
@@ -2406,11 +2744,13 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    InvalidateLineOfSightCache();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    InvalidateLineOfSightCache();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
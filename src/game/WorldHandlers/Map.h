@@ -63,6 +63,9 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+#ifdef ENABLE_ELUNA
+class Eluna;
+#endif /* ENABLE_ELUNA */
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -71,6 +74,13 @@ class WeatherSystem;
 #pragma pack(push,1)
 #endif
 
+// one end point of a batched line of sight check, see Map::IsInLineOfSight
+struct LineOfSightTarget
+{
+    float x, y, z;
+    bool inLineOfSight;                                     // result of the check
+};
+
 struct InstanceTemplate
 {
     uint32 map;                                             // instance map
@@ -141,11 +151,20 @@ class Map : public GridRefManager<NGridType>
         void MessageDistBroadcast(WorldObject const*, WorldPacket*, float dist);
 
         float GetVisibilityDistance() const { return m_VisibleDistance; }
+        /** Observers closer than this receive every movement heartbeat of a mover, 0 disables the heartbeat level of detail */
+        float GetMovementLodNearDistance() const { return m_movementLodNearDistance; }
+        /** Observers between the near and this distance receive only every Nth heartbeat, farther ones only movement state changes */
+        float GetMovementLodMidDistance() const { return m_movementLodMidDistance; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
         void PlayerRelocation(Player*, float x, float y, float z, float angl);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float orientation);
+        /**
+         * Queues the AI relocation notification of a moved unit. Due units are handled
+         * together once per map tick, see ProcessRelocationNotifies.
+         */
+        void ScheduleRelocationNotify(Unit* unit, uint32 delay);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
@@ -244,6 +263,18 @@ class Map : public GridRefManager<NGridType>
         bool ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* target, ScriptExecutionParam execParams = SCRIPT_EXEC_PARAM_NONE);
         void ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target);
 
+        // counters of the script steps handled by this map since it was created
+        struct ScriptScheduleStats
+        {
+            ScriptScheduleStats() : executed(0), totalLag(0), maxLag(0) {}
+
+            uint64 executed;
+            uint64 totalLag;                                // ms between due time and execution, summed over all steps
+            uint32 maxLag;                                  // ms
+        };
+        size_t GetScheduledScriptCount() const { return m_scriptSchedule.size(); }
+        ScriptScheduleStats const& GetScriptScheduleStats() const { return m_scriptStats; }
+
         // must called with AddToWorld
         void AddToActive(WorldObject* obj);
         // must called with RemoveFromWorld
@@ -290,16 +321,30 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(uint32 phasemask, float x, float y, float z) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        // checks every target against the same source, the dynamic tree is searched once for all of them
+        void IsInLineOfSight(float srcX, float srcY, float srcZ, LineOfSightTarget* targets, uint32 count, uint32 phasemask) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        // models changed position, phase or collision state, cached line of sight results are outdated
+        void InvalidateLineOfSightCache() { ++m_losCacheGeneration; }
 
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
 
+        // Dead creature is checked for respawn at the given time, see Creature::RespawnIfDue
+        void ScheduleRespawn(ObjectGuid guid, time_t respawnTime);
+
+#ifdef ENABLE_ELUNA
+        // Lua state running the hooks of this map, its own one with Eluna.MapStates enabled, else the global one
+        Eluna* GetEluna() const;
+        // Stable address of the state pointer for the timed events of the objects on this map
+        Eluna** GetElunaHandle();
+#endif /* ENABLE_ELUNA */
+
         // Teleport all players in that map to choosed location
         void TeleportAllPlayersTo(TeleportLocation loc);
         // Random on map generation
@@ -330,6 +375,7 @@ class Map : public GridRefManager<NGridType>
         void SendRemoveTransports(Player* player);
 
         bool CreatureCellRelocation(Creature* c, const Cell& new_cell);
+        void ProcessRelocationNotifies(uint32 diff);
 
         bool loaded(const GridPair&) const;
         void EnsureGridCreated(const GridPair&);
@@ -353,6 +399,7 @@ class Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void ProcessRespawnSchedule();
 
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
@@ -364,6 +411,17 @@ class Map : public GridRefManager<NGridType>
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
         float m_VisibleDistance;
+        float m_movementLodNearDistance;                    /**< observers within this distance get every movement heartbeat, 0 disables the level of detail */
+        float m_movementLodMidDistance;                     /**< observers up to this distance get every MidRate-th heartbeat, farther ones none */
+
+        struct RelocationNotifyRequest
+        {
+            ObjectGuid guid;
+            uint32 generation;                              // Unit::GetAINotifyGeneration() when queued
+            uint32 delay;                                   // ms left before the unit is notified
+        };
+        typedef std::vector<RelocationNotifyRequest> RelocationNotifyQueue;
+        RelocationNotifyQueue m_relocationNotifyQueue;
         MapPersistentState* m_persistentState;
 
         MapRefManager m_mapRefManager;
@@ -387,11 +445,28 @@ class Map : public GridRefManager<NGridType>
 
         std::set<WorldObject*> i_objectsToRemove;
 
-        typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
+        // steps by due time in ms of m_scriptTime
+        typedef std::multimap<uint64, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
+        // steps by script type and id, limits uniqueness checks and termination to the steps of one script
+        typedef std::multimap<uint64, ScriptScheduleMap::iterator> ScriptScheduleIndex;
+        ScriptScheduleIndex m_scriptScheduleIndex;
+        uint64 m_scriptTime;                                // ms, advanced by every map update
+        ScriptScheduleStats m_scriptStats;
+
+        void ScheduleScriptStep(uint32 delay, ScriptAction const& step);
+        void UnscheduleScriptStep(ScriptScheduleMap::iterator itr);
+
+        // entries can be outdated, the creature state is checked again when due
+        typedef std::multimap<time_t, ObjectGuid> RespawnScheduleMap;
+        RespawnScheduleMap m_respawnSchedule;
 
         InstanceData* i_data;
 
+#ifdef ENABLE_ELUNA
+        Eluna* m_eluna;                                     // NULL unless Eluna.MapStates is enabled
+#endif /* ENABLE_ELUNA */
+
         // Map local low guid counters
         ObjectGuidGenerator<HIGHGUID_UNIT> m_CreatureGuids;
         ObjectGuidGenerator<HIGHGUID_GAMEOBJECT> m_GameObjectGuids;
@@ -412,6 +487,23 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // recent line of sight results, direct mapped by a hash of the rounded end points and the phase mask
+        struct LineOfSightCacheEntry
+        {
+            uint64 key;
+            uint32 checkTime;                               // getMSTime() of the check
+            uint32 generation;                              // m_losCacheGeneration of the check
+            bool inLineOfSight;
+        };
+        enum { LOS_CACHE_SIZE = 2048 };
+
+        static uint64 MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask);
+        // slot of the key or NULL if the cache is disabled, found is set if it holds a result still valid
+        LineOfSightCacheEntry* FindLineOfSightEntry(uint64 key, bool& found) const;
+
+        mutable std::vector<LineOfSightCacheEntry> m_losCache; // allocated by the first check with vmap.losCacheTime set
+        uint32 m_losCacheGeneration;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 };
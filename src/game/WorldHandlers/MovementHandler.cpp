@@ -386,7 +386,19 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
 
     WorldPacket data(SMSG_PLAYER_MOVE, recv_data.size());
     data << movementInfo;
-    mover->SendMessageToSetExcept(&data, _player);
+
+    // a heartbeat that keeps movement state and direction only refines the position the
+    // observers already extrapolate, so distant ones get it at a reduced rate or not at all
+    float orientation = movementInfo.GetPos()->o;
+    if (opcode == MSG_MOVE_HEARTBEAT && mover->IsMovementStateBroadcast(movementInfo.GetMovementFlags(), orientation))
+    {
+        mover->SendMovementHeartbeatToSetExcept(&data, _player, mover->NextMovementHeartbeat());
+    }
+    else
+    {
+        mover->SetMovementStateBroadcast(movementInfo.GetMovementFlags(), orientation);
+        mover->SendMessageToSetExcept(&data, _player);
+    }
 }
 
 void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
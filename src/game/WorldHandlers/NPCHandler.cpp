@@ -589,27 +589,26 @@ void WorldSession::SendStablePet(ObjectGuid guid)
         ++num;
     }
 
-    //                                                      0        1     2        3        4
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `owner`, `id`, `entry`, `level`, `name` FROM `character_pet` WHERE `owner` = '%u' AND `slot` >= '%u' AND `slot` <= '%u' ORDER BY `slot`",
-                          _player->GetGUIDLow(), PET_SAVE_FIRST_STABLE_SLOT, PET_SAVE_LAST_STABLE_SLOT);
-
-    if (result)
+    // stabled pets ordered by slot
+    std::map<uint32, std::pair<uint32, PetData const*> > stabled;
+    PetDataMap const& storedPets = _player->GetStoredPets();
+    for (PetDataMap::const_iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
     {
-        do
+        if (itr->second.slot >= PET_SAVE_FIRST_STABLE_SLOT && itr->second.slot <= PET_SAVE_LAST_STABLE_SLOT)
         {
-            Field* fields = result->Fetch();
-
-            data << uint32(fields[1].GetUInt32());          // petnumber
-            data << uint32(fields[2].GetUInt32());          // creature entry
-            data << uint32(fields[3].GetUInt32());          // level
-            data << fields[4].GetString();                  // name
-            data << uint8(2);                               // 1 = current, 2/3 = in stable (any from 4,5,... create problems with proper show)
-
-            ++num;
+            stabled[itr->second.slot] = std::make_pair(itr->first, &itr->second);
         }
-        while (result->NextRow());
+    }
 
-        delete result;
+    for (std::map<uint32, std::pair<uint32, PetData const*> >::const_iterator itr = stabled.begin(); itr != stabled.end(); ++itr)
+    {
+        data << uint32(itr->second.first);                  // petnumber
+        data << uint32(itr->second.second->entry);          // creature entry
+        data << uint32(itr->second.second->level);          // level
+        data << itr->second.second->name;                   // name
+        data << uint8(2);                                   // 1 = current, 2/3 = in stable (any from 4,5,... create problems with proper show)
+
+        ++num;
     }
 
     data.put<uint8>(wpos, num);                             // set real data to placeholder
@@ -676,30 +675,18 @@ void WorldSession::HandleStablePet(WorldPacket& recv_data)
         return;
     }
 
-    uint32 free_slot = 1;
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `owner`,`slot`,`id` FROM `character_pet` WHERE `owner` = '%u' AND `slot` >= '%u' AND `slot` <= '%u' ORDER BY `slot`",
-                          _player->GetGUIDLow(), PET_SAVE_FIRST_STABLE_SLOT, PET_SAVE_LAST_STABLE_SLOT);
-    if (result)
+    std::set<uint32> usedSlots;
+    PetDataMap const& storedPets = _player->GetStoredPets();
+    for (PetDataMap::const_iterator itr = storedPets.begin(); itr != storedPets.end(); ++itr)
     {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            uint32 slot = fields[1].GetUInt32();
-
-            // slots ordered in query, and if not equal then free
-            if (slot != free_slot)
-            {
-                break;
-            }
-
-            // this slot not free, skip
-            ++free_slot;
-        }
-        while (result->NextRow());
+        usedSlots.insert(itr->second.slot);
+    }
 
-        delete result;
+    // first stable slot not taken by another pet
+    uint32 free_slot = PET_SAVE_FIRST_STABLE_SLOT;
+    while (free_slot <= PET_SAVE_LAST_STABLE_SLOT && usedSlots.find(free_slot) != usedSlots.end())
+    {
+        ++free_slot;
     }
 
     if (free_slot > 0 && free_slot <= GetPlayer()->m_stableSlots)
@@ -729,14 +716,11 @@ void WorldSession::HandleUnstablePet(WorldPacket& recv_data)
 
     uint32 creature_id = 0;
 
+    if (PetData const* stored = _player->GetStoredPet(petnumber))
     {
-        QueryResult* result = CharacterDatabase.PQuery("SELECT `entry` FROM `character_pet` WHERE `owner` = '%u' AND `id` = '%u' AND `slot` >='%u' AND `slot` <= '%u'",
-                              _player->GetGUIDLow(), petnumber, PET_SAVE_FIRST_STABLE_SLOT, PET_SAVE_LAST_STABLE_SLOT);
-        if (result)
+        if (stored->slot >= PET_SAVE_FIRST_STABLE_SLOT && stored->slot <= PET_SAVE_LAST_STABLE_SLOT)
         {
-            Field* fields = result->Fetch();
-            creature_id = fields[0].GetUInt32();
-            delete result;
+            creature_id = stored->entry;
         }
     }
 
@@ -828,19 +812,15 @@ void WorldSession::HandleStableSwapPet(WorldPacket& recv_data)
     }
 
     // find swapped pet slot in stable
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `slot`,`entry` FROM `character_pet` WHERE `owner` = '%u' AND `id` = '%u'",
-                          _player->GetGUIDLow(), pet_number);
-    if (!result)
+    PetData const* stored = _player->GetStoredPet(pet_number);
+    if (!stored)
     {
         SendStableResult(STABLE_ERR_STABLE);
         return;
     }
 
-    Field* fields = result->Fetch();
-
-    uint32 slot        = fields[0].GetUInt32();
-    uint32 creature_id = fields[1].GetUInt32();
-    delete result;
+    uint32 slot        = stored->slot;
+    uint32 creature_id = stored->entry;
 
     if (!creature_id)
     {
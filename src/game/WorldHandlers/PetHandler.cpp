@@ -620,6 +620,17 @@ void WorldSession::HandlePetRename(WorldPacket& recv_data)
         }
     }
 
+    if (PetData* stored = _player->GetStoredPet(pet->GetCharmInfo()->GetPetNumber()))
+    {
+        stored->name = name;
+        stored->renamed = true;
+        if (isdeclined)
+        {
+            stored->hasDeclinedName = true;
+            stored->declinedName = declinedname;
+        }
+    }
+
     CharacterDatabase.BeginTransaction();
     if (isdeclined)
     {
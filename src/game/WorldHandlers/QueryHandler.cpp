@@ -40,23 +40,18 @@
 #include "MapManager.h"
 #include "SQLStorages.h"
 
-void WorldSession::SendNameQueryOpcode(Player* p)
+static void BuildNameQueryResponse(WorldPacket& data, ObjectGuid guid, std::string const& name, uint8 race, uint8 gender, uint8 pClass, DeclinedName const* names)
 {
-    if (!p)
-    {
-        return;
-    }
-
     // guess size
-    WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 1 + 1 + 1 + 1 + 10));
-    data << p->GetPackGUID();                               // player guid
+    data.Initialize(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 1 + 1 + 1 + 1 + 1 + 10));
+    data << guid.WriteAsPacked();                           // player guid
     data << uint8(0);                                       // added in 3.1; if > 1, then end of packet
-    data << p->GetName();                                   // played name
+    data << name;                                           // played name
     data << uint8(0);                                       // realm name for cross realm BG usage
-    data << uint8(p->getRace());
-    data << uint8(p->getGender());
-    data << uint8(p->getClass());
-    if (DeclinedName const* names = p->GetDeclinedNames())
+    data << uint8(race);
+    data << uint8(gender);
+    data << uint8(pClass);
+    if (names)
     {
         data << uint8(1);                                   // is declined
         for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
@@ -68,12 +63,44 @@ void WorldSession::SendNameQueryOpcode(Player* p)
     {
         data << uint8(0);                                   // is not declined
     }
+}
 
+void WorldSession::SendNameQueryOpcode(Player* p)
+{
+    if (!p)
+    {
+        return;
+    }
+
+    WorldPacket data;
+    BuildNameQueryResponse(data, p->GetObjectGuid(), p->GetName(), p->getRace(), p->getGender(), p->getClass(), p->GetDeclinedNames());
     SendPacket(&data);
 }
 
 void WorldSession::SendNameQueryOpcodeFromDB(ObjectGuid guid)
 {
+    // without declined names everything needed is in the identity cache
+    if (!sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
+    {
+        CharacterIdentity identity;
+        if (!sObjectMgr.GetCharacterIdentity(guid, identity))
+        {
+            return;
+        }
+
+        WorldPacket data;
+        if (identity.name.empty())
+        {
+            BuildNameQueryResponse(data, guid, GetMangosString(LANG_NON_EXIST_CHARACTER), 0, 0, 0, NULL);
+        }
+        else
+        {
+            BuildNameQueryResponse(data, guid, identity.name, identity.race, identity.gender, identity.playerClass, NULL);
+        }
+        SendPacket(&data);
+        return;
+    }
+
     CharacterDatabase.AsyncPQuery(&WorldSession::SendNameQueryOpcodeFromDBCallBack, GetAccountId(),
                                   !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
                                   //   ------- Query Without Declined Names --------
@@ -119,30 +146,19 @@ void WorldSession::SendNameQueryOpcodeFromDBCallBack(QueryResult* result, uint32
         pClass       = fields[4].GetUInt8();
     }
 
-    // guess size
-    WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 1 + 1 + 1 + 1 + 1 + 10));
-    data << ObjectGuid(HIGHGUID_PLAYER, lowguid).WriteAsPacked();
-    data << uint8(0);                                       // added in 3.1; if > 1, then end of packet
-    data << name;
-    data << uint8(0);                                       // realm name for cross realm BG usage
-    data << uint8(pRace);                                   // race
-    data << uint8(pGender);                                 // gender
-    data << uint8(pClass);                                  // class
-
     // if the first declined name field (5) is empty, the rest must be too
-    if (sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) && !fields[5].GetCppString().empty())
+    DeclinedName declinedNames;
+    bool declined = sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) && !fields[5].GetCppString().empty();
+    if (declined)
     {
-        data << uint8(1);                                   // is declined
-        for (int i = 5; i < MAX_DECLINED_NAME_CASES + 5; ++i)
+        for (int i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
         {
-            data << fields[i].GetCppString();
+            declinedNames.name[i] = fields[i + 5].GetCppString();
         }
     }
-    else
-    {
-        data << uint8(0);                                   // is not declined
-    }
 
+    WorldPacket data;
+    BuildNameQueryResponse(data, ObjectGuid(HIGHGUID_PLAYER, lowguid), name, pRace, pGender, pClass, declined ? &declinedNames : NULL);
     session->SendPacket(&data);
     delete result;
 }
@@ -2573,7 +2573,7 @@ CreatureAI* ScriptMgr::GetCreatureAI(Creature* pCreature)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (CreatureAI* luaAI = sEluna->GetAI(pCreature))
+    if (CreatureAI* luaAI = pCreature->GetEluna()->GetAI(pCreature))
     {
         return luaAI;
     }
@@ -2609,7 +2609,7 @@ bool ScriptMgr::OnGossipHello(Player* pPlayer, Creature* pCreature)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnGossipHello(pPlayer, pCreature))
+    if (pCreature->GetEluna()->OnGossipHello(pPlayer, pCreature))
     {
         return true;
     }
@@ -2626,7 +2626,7 @@ bool ScriptMgr::OnGossipHello(Player* pPlayer, GameObject* pGameObject)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnGossipHello(pPlayer, pGameObject))
+    if (pGameObject->GetEluna()->OnGossipHello(pPlayer, pGameObject))
     {
         return true;
     }
@@ -2659,7 +2659,7 @@ bool ScriptMgr::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32 send
     if (code)
     {
         // Used by Eluna
-        if (sEluna->OnGossipSelectCode(pPlayer, pCreature, sender, action, code))
+        if (pCreature->GetEluna()->OnGossipSelectCode(pPlayer, pCreature, sender, action, code))
         {
             return true;
         }
@@ -2667,7 +2667,7 @@ bool ScriptMgr::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32 send
     else
     {
         // Used by Eluna
-        if (sEluna->OnGossipSelect(pPlayer, pCreature, sender, action))
+        if (pCreature->GetEluna()->OnGossipSelect(pPlayer, pCreature, sender, action))
         {
             return true;
         }
@@ -2694,14 +2694,14 @@ bool ScriptMgr::OnGossipSelect(Player* pPlayer, GameObject* pGameObject, uint32
 #ifdef ENABLE_ELUNA
     if (code)
     {
-        if (sEluna->OnGossipSelectCode(pPlayer, pGameObject, sender, action, code))
+        if (pGameObject->GetEluna()->OnGossipSelectCode(pPlayer, pGameObject, sender, action, code))
         {
             return true;
         }
     }
     else
     {
-        if (sEluna->OnGossipSelect(pPlayer, pGameObject, sender, action))
+        if (pGameObject->GetEluna()->OnGossipSelect(pPlayer, pGameObject, sender, action))
         {
             return true;
         }
@@ -2747,7 +2747,7 @@ bool ScriptMgr::OnQuestAccept(Player* pPlayer, Creature* pCreature, Quest const*
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnQuestAccept(pPlayer, pCreature, pQuest))
+    if (pCreature->GetEluna()->OnQuestAccept(pPlayer, pCreature, pQuest))
     {
         return true;
     }
@@ -2764,7 +2764,7 @@ bool ScriptMgr::OnQuestAccept(Player* pPlayer, GameObject* pGameObject, Quest co
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnQuestAccept(pPlayer, pGameObject, pQuest))
+    if (pGameObject->GetEluna()->OnQuestAccept(pPlayer, pGameObject, pQuest))
     {
         return true;
     }
@@ -2781,7 +2781,7 @@ bool ScriptMgr::OnQuestAccept(Player* pPlayer, Item* pItem, Quest const* pQuest)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnQuestAccept(pPlayer, pItem, pQuest))
+    if (pPlayer->GetEluna()->OnQuestAccept(pPlayer, pItem, pQuest))
     {
         return true;
     }
@@ -2798,7 +2798,7 @@ bool ScriptMgr::OnQuestRewarded(Player* pPlayer, Creature* pCreature, Quest cons
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnQuestReward(pPlayer, pCreature, pQuest, reward))
+    if (pCreature->GetEluna()->OnQuestReward(pPlayer, pCreature, pQuest, reward))
     {
         return true;
     }
@@ -2815,7 +2815,7 @@ bool ScriptMgr::OnQuestRewarded(Player* pPlayer, GameObject* pGameObject, Quest
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnQuestReward(pPlayer, pGameObject, pQuest, reward))
+    if (pGameObject->GetEluna()->OnQuestReward(pPlayer, pGameObject, pQuest, reward))
     {
         return true;
     }
@@ -2832,7 +2832,7 @@ uint32 ScriptMgr::GetDialogStatus(Player* pPlayer, Creature* pCreature)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (uint32 dialogId = sEluna->GetDialogStatus(pPlayer, pCreature))
+    if (uint32 dialogId = pCreature->GetEluna()->GetDialogStatus(pPlayer, pCreature))
     {
         return dialogId;
     }
@@ -2849,7 +2849,7 @@ uint32 ScriptMgr::GetDialogStatus(Player* pPlayer, GameObject* pGameObject)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (uint32 dialogId = sEluna->GetDialogStatus(pPlayer, pGameObject))
+    if (uint32 dialogId = pGameObject->GetEluna()->GetDialogStatus(pPlayer, pGameObject))
     {
         return dialogId;
     }
@@ -2865,7 +2865,7 @@ uint32 ScriptMgr::GetDialogStatus(Player* pPlayer, GameObject* pGameObject)
 bool ScriptMgr::OnGameObjectUse(Player* pPlayer, GameObject* pGameObject)
 {
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnGameObjectUse(pPlayer, pGameObject))
+    if (pGameObject->GetEluna()->OnGameObjectUse(pPlayer, pGameObject))
     {
         return true;
     }
@@ -2893,7 +2893,7 @@ bool ScriptMgr::OnItemUse(Player* pPlayer, Item* pItem, SpellCastTargets const&
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (!sEluna->OnUse(pPlayer, pItem, targets))
+    if (!pPlayer->GetEluna()->OnUse(pPlayer, pItem, targets))
     {
         return true;
     }
@@ -2910,7 +2910,7 @@ bool ScriptMgr::OnAreaTrigger(Player* pPlayer, AreaTriggerEntry const* atEntry)
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnAreaTrigger(pPlayer, atEntry))
+    if (pPlayer->GetEluna()->OnAreaTrigger(pPlayer, atEntry))
     {
         return true;
     }
@@ -2946,7 +2946,7 @@ bool ScriptMgr::OnEffectDummy(Unit* pCaster, uint32 spellId, SpellEffectIndex ef
     // Used by Eluna
 #ifdef ENABLE_ELUNA
     if (pTarget->ToCreature())
-        if (sEluna->OnDummyEffect(pCaster, spellId, effIndex, pTarget->ToCreature()))
+        if (pCaster->GetEluna()->OnDummyEffect(pCaster, spellId, effIndex, pTarget->ToCreature()))
         {
             return true;
         }
@@ -2963,7 +2963,7 @@ bool ScriptMgr::OnEffectDummy(Unit* pCaster, uint32 spellId, SpellEffectIndex ef
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnDummyEffect(pCaster, spellId, effIndex, pTarget))
+    if (pCaster->GetEluna()->OnDummyEffect(pCaster, spellId, effIndex, pTarget))
     {
         return true;
     }
@@ -2980,7 +2980,7 @@ bool ScriptMgr::OnEffectDummy(Unit* pCaster, uint32 spellId, SpellEffectIndex ef
 {
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    if (sEluna->OnDummyEffect(pCaster, spellId, effIndex, pTarget))
+    if (pCaster->GetEluna()->OnDummyEffect(pCaster, spellId, effIndex, pTarget))
     {
         return true;
     }
@@ -857,6 +857,8 @@ void Spell::FillTargetMap()
             }
         }
 
+        PrepareTargetsLineOfSight(tmpUnitLists[effToIndex[i]]);
+
         for (UnitList::iterator itr = tmpUnitLists[effToIndex[i]].begin(); itr != tmpUnitLists[effToIndex[i]].end();)
         {
             if (!CheckTarget(*itr, SpellEffectIndex(i)))
@@ -1416,7 +1418,7 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
             (classOpt->SpellFamilyFlags & UI64LIT(0x0004000000000000)))
             if(Aura* dummy = unitTarget->GetDummyAura(m_spellInfo->Id))
             {
-                dummy->GetModifier()->m_amount = damageInfo.damage;
+                dummy->ChangeAmount(damageInfo.damage, false);
             }
 
         caster->DealSpellDamage(&damageInfo, true);
@@ -4070,7 +4072,7 @@ void Spell::cast(bool skipCheck)
 
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-        sEluna->OnSpellCast(m_caster->ToPlayer(), this, skipCheck);
+        m_caster->GetEluna()->OnSpellCast(m_caster->ToPlayer(), this, skipCheck);
 #endif /* ENABLE_ELUNA */
     }
 
@@ -9000,6 +9002,49 @@ CurrentSpellTypes Spell::GetCurrentContainer()
     }
 }
 
+/**
+ * Checks the line of sight from the casting object to all targets at once, the checks done
+ * by CheckTarget for each target are then answered by the line of sight cache of the map
+ */
+void Spell::PrepareTargetsLineOfSight(UnitList const& targetUnitMap)
+{
+    if (targetUnitMap.size() < 2 || !sWorld.getConfig(CONFIG_UINT32_VMAP_LOS_CACHE_TIME))
+    {
+        return;
+    }
+
+    if (m_spellInfo->HasAttribute(SPELL_ATTR_EX2_IGNORE_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, NULL, SPELL_ATTR_EX2_IGNORE_LOS))
+    {
+        return;
+    }
+
+    WorldObject* caster = GetCastingObject();
+    if (!caster)
+    {
+        return;
+    }
+
+    std::vector<LineOfSightTarget> targets;
+    targets.reserve(targetUnitMap.size());
+    for (UnitList::const_iterator itr = targetUnitMap.begin(); itr != targetUnitMap.end(); ++itr)
+    {
+        if (*itr == m_caster || !(*itr)->IsInMap(caster))
+        {
+            continue;
+        }
+
+        // same end points as WorldObject::IsWithinLOS
+        LineOfSightTarget target = { (*itr)->GetPositionX(), (*itr)->GetPositionY(), (*itr)->GetPositionZ() + 2.0f, true };
+        targets.push_back(target);
+    }
+
+    if (targets.size() > 1)
+    {
+        caster->GetMap()->IsInLineOfSight(caster->GetPositionX(), caster->GetPositionY(), caster->GetPositionZ() + 2.0f,
+                                          &targets[0], uint32(targets.size()), caster->GetPhaseMask());
+    }
+}
+
 bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
 {
     SpellEffectEntry const* spellEffect = m_spellInfo->GetSpellEffect(eff);
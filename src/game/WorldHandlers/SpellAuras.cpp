@@ -1027,13 +1027,26 @@ void Aura::ApplyModifier(bool apply, bool Real)
     SetInUse(true);
     if (aura < TOTAL_AURAS)
     {
+        // handlers may recalculate m_amount while the aura is already in the target's mod list
+        GetTarget()->InvalidateAuraModifierCache(aura);
         (*this.*AuraHandler [aura])(apply, Real);
+        GetTarget()->InvalidateAuraModifierCache(aura);
     }
 
     SetInUse(false);
     GetHolder()->SetInUse(false);
 }
 
+void Aura::ChangeAmount(int32 amount, bool update)
+{
+    m_modifier.m_amount = amount;
+    GetTarget()->InvalidateAuraModifierCache(m_modifier.m_auraname);
+    if (update)
+    {
+        GetHolder()->SendAuraUpdate(false);
+    }
+}
+
 bool Aura::isAffectedOnSpell(SpellEntry const* spell) const
 {
     return spell->IsFitToFamily(GetSpellProto()->GetSpellFamilyName(), GetAuraSpellClassMask());
@@ -1430,7 +1443,8 @@ void Aura::TriggerSpell()
                             return;
                         }
 
-                        ThreatList const& tList = target->GetThreatManager().getThreatList();
+                        // copy, dropping the threat can change the list
+                        ThreatList tList = target->GetThreatManager().getThreatList();
                         for (ThreatList::const_iterator itr = tList.begin(); itr != tList.end(); ++itr)
                         {
                             Unit* pUnit = target->GetMap()->GetUnit((*itr)->getUnitGuid());
@@ -2024,7 +2038,8 @@ void Aura::TriggerSpell()
                     case 69012:                             // Explosive Barrage
                     {
                         // Summon an Exploding Orb for each player in combat with the caster
-                        ThreatList const& threatList = target->GetThreatManager().getThreatList();
+                        // copy, casting can add new references to the list
+                        ThreatList threatList = target->GetThreatManager().getThreatList();
                         for (ThreatList::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                         {
                             if (Unit* expectedTarget = target->GetMap()->GetUnit((*itr)->getUnitGuid()))
@@ -2111,14 +2126,14 @@ void Aura::TriggerSpell()
                         // Reset reapply counter at move
                         if (((Player*)triggerTarget)->isMoving())
                         {
-                            m_modifier.m_amount = 6;
+                            ChangeAmount(6, false);
                             return;
                         }
 
                         // We are standing at the moment
                         if (m_modifier.m_amount > 0)
                         {
-                            --m_modifier.m_amount;
+                            ChangeAmount(m_modifier.m_amount - 1, false);
                             return;
                         }
 
@@ -9614,7 +9629,7 @@ void Aura::PeriodicDummyTick()
                 // Search SPELL_AURA_MOD_POWER_REGEN aura for this spell and add bonus
                 if (Aura* aura = GetHolder()->GetAuraByEffectIndex(SpellEffectIndex(GetEffIndex() - 1)))
                 {
-                    aura->GetModifier()->m_amount = m_modifier.m_amount;
+                    aura->ChangeAmount(m_modifier.m_amount, false);
                     ((Player*)target)->UpdateManaRegen();
                     // Disable continue
                     m_isPeriodic = false;
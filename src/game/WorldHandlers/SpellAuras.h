@@ -504,14 +504,7 @@ class  Aura
             }
         }
         void ApplyModifier(bool apply, bool Real = false);
-        void ChangeAmount(int32 amount, bool update = true)
-        {
-            m_modifier.m_amount = amount;
-            if (update)
-            {
-                GetHolder()->SendAuraUpdate(false);
-            }
-        }
+        void ChangeAmount(int32 amount, bool update = true);
 
         void UpdateAura(uint32 diff) { SetInUse(true); Update(diff); SetInUse(false); }
 
@@ -6979,12 +6979,12 @@ bool Spell::DoSummonVehicle(CreatureSummonPositions& list, SummonPropertiesEntry
 #ifdef ENABLE_ELUNA
     if (Unit* summoner = m_caster->ToUnit())
     {
-        sEluna->OnSummoned(spawnCreature, summoner);
+        m_caster->GetEluna()->OnSummoned(spawnCreature, summoner);
     }
     else if (m_originalCaster)
         if (Unit* summoner = m_originalCaster->ToUnit())
         {
-            sEluna->OnSummoned(spawnCreature, summoner);
+            m_caster->GetEluna()->OnSummoned(spawnCreature, summoner);
         }
 #endif /* ENABLE_ELUNA */
     return true;
@@ -11947,7 +11947,7 @@ void Spell::EffectDuel(SpellEffectEntry const* effect)
 
     // Used by Eluna
 #ifdef ENABLE_ELUNA
-    sEluna->OnDuelRequest(target, caster);
+    m_caster->GetEluna()->OnDuelRequest(target, caster);
 #endif /* ENABLE_ELUNA */
 }
 
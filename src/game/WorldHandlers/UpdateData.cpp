@@ -47,10 +47,12 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::AddUpdateBlock(const ByteBuffer& block)
+size_t UpdateData::AddUpdateBlock(const ByteBuffer& block)
 {
+    size_t pos = m_data.wpos();
     m_data.append(block);
     ++m_blockCount;
+    return pos;
 }
 
 void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
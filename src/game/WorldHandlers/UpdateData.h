@@ -65,7 +65,8 @@ class UpdateData
 
         void AddOutOfRangeGUID(GuidSet& guids);
         void AddOutOfRangeGUID(ObjectGuid const& guid);
-        void AddUpdateBlock(const ByteBuffer& block);
+        size_t AddUpdateBlock(const ByteBuffer& block);     // returns the position of the block, see PatchUpdateBlock
+        void PatchUpdateBlock(size_t pos, uint32 value) { m_data.put<uint32>(pos, value); }
         bool BuildPacket(WorldPacket* packet);
         bool HasData() { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
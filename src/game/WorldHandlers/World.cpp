@@ -82,6 +82,7 @@
 #include "revision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "PacketShardExecutor.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -126,6 +127,7 @@ World::World(): mail_timer(0), mail_timer_expires(0), m_NextMonthlyQuestReset(0)
     m_startTime = m_gameTime;
     m_maxActiveSessionCount = 0;
     m_maxQueuedSessionCount = 0;
+    m_packetShards = NULL;
     m_NextCurrencyReset = 0;
     m_NextDailyQuestReset = 0;
     m_NextWeeklyQuestReset = 0;
@@ -178,6 +180,8 @@ World::~World()
         delete session;
     }
 
+    delete m_packetShards;
+
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 }
@@ -187,6 +191,9 @@ void World::CleanupsBeforeStop()
 {
     KickAll();                                       // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
+
+    delete m_packetShards;                           // joins the workers, sessions run in place from now on
+    m_packetShards = NULL;
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
 #ifdef ENABLE_ELUNA
     Eluna::Uninitialize();
@@ -623,6 +630,11 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
+    if (configNoReload(reload, CONFIG_UINT32_PACKET_SHARD_THREADS, "PacketShardThreads", 0))
+    {
+        setConfigMinMax(CONFIG_UINT32_PACKET_SHARD_THREADS, "PacketShardThreads", 0, 0, 64);
+    }
+
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
     {
         setConfig(CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT);
@@ -965,6 +977,26 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInFlight = MAX_VISIBILITY_DISTANCE - m_VisibleObjectGreyDistance;
     }
 
+    // movement heartbeat level of detail, near distance 0 (default) disables it for the map type
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_CONTINENTS, "Visibility.MovementLOD.Near.Continents", 0.0f);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_MID_CONTINENTS,  "Visibility.MovementLOD.Mid.Continents",  70.0f);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_INSTANCES,  "Visibility.MovementLOD.Near.Instances",  0.0f);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_MID_INSTANCES,   "Visibility.MovementLOD.Mid.Instances",   90.0f);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_NEAR_BGARENAS,   "Visibility.MovementLOD.Near.BGArenas",   0.0f);
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_LOD_MID_BGARENAS,    "Visibility.MovementLOD.Mid.BGArenas",    120.0f);
+    setConfigMin(CONFIG_UINT32_MOVEMENT_LOD_MID_RATE, "Visibility.MovementLOD.MidRate", 2, 1);
+
+    for (int i = CONFIG_FLOAT_MOVEMENT_LOD_NEAR_CONTINENTS; i < CONFIG_FLOAT_MOVEMENT_LOD_MID_BGARENAS; i += 2)
+    {
+        eConfigFloatValues nearIndex = eConfigFloatValues(i);
+        eConfigFloatValues midIndex = eConfigFloatValues(i + 1);
+        if (getConfig(midIndex) < getConfig(nearIndex))
+        {
+            sLog.outError("Visibility.MovementLOD.Mid.* (%f) can't be less than matching Near distance (%f), using Near distance.", getConfig(midIndex), getConfig(nearIndex));
+            setConfig(midIndex, getConfig(nearIndex));
+        }
+    }
+
     ///- Load the CharDelete related config options
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_METHOD, "CharDelete.Method", 0, 0, 1);
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0, 0, getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL));
@@ -1009,6 +1041,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
+    setConfigMinMax(CONFIG_UINT32_VMAP_LOS_CACHE_TIME, "vmap.losCacheTime", 250, 0, 5000);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
     std::string ignoreSpellIds = sConfig.GetStringDefault("vmap.ignoreSpellIds", "");
@@ -1032,6 +1065,12 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_ELUNA_ENABLED, "Eluna.Enabled", true);
 
+    // check batches are sized by Warden.NumMemChecks / Warden.NumOtherChecks
+    if (reload)
+    {
+        sWardenCheckMgr->BuildCheckBatches();
+    }
+
 #ifdef ENABLE_ELUNA
     if (reload)
     {
@@ -1413,6 +1452,9 @@ void World::SetInitialWorldSettings()
     sLog.outString();
 
     ///- Load dynamic data tables from the database
+    sLog.outString("Loading Character identities...");
+    sObjectMgr.LoadCharacterIdentities();                   // must be before anything resolving offline player names
+
     sLog.outString("Loading Auctions...");
     sAuctionMgr.LoadAuctionItems();
     sAuctionMgr.LoadAuctions();
@@ -1570,6 +1612,13 @@ void World::SetInitialWorldSettings()
     sMapMgr.Initialize();
     sLog.outString();
 
+    if (uint32 shardThreads = getConfig(CONFIG_UINT32_PACKET_SHARD_THREADS))
+    {
+        sLog.outString("Starting %u packet shard threads", shardThreads);
+        m_packetShards = new PacketShardExecutor();
+        m_packetShards->Start(shardThreads);
+    }
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -2342,7 +2391,7 @@ void World::UpdateSessions(uint32 /*diff*/)
         ++next;
         ///- and remove not active sessions from the list
         WorldSession* pSession = itr->second;
-        WorldSessionFilter updater(pSession);
+        WorldSessionFilter updater(pSession, m_packetShards);
 
         if (!pSession->Update(updater))
         {
@@ -2351,6 +2400,12 @@ void World::UpdateSessions(uint32 /*diff*/)
             delete pSession;
         }
     }
+
+    ///- Run the packets the sessions handed to the shard workers
+    if (m_packetShards)
+    {
+        m_packetShards->RunQueued();
+    }
 }
 
 // This handles the issued and queued CLI/RA commands
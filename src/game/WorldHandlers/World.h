@@ -43,6 +43,7 @@ class Object;
 class ObjectGuid;
 class WorldPacket;
 class WorldSession;
+class PacketShardExecutor;
 class Player;
 class Weather;
 class SqlResultQueue;
@@ -233,6 +234,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_WARDEN_DB_LOGLEVEL,
 
     CONFIG_UINT32_AUTOBROADCAST_INTERVAL,
+    CONFIG_UINT32_MOVEMENT_LOD_MID_RATE,
+    CONFIG_UINT32_PACKET_SHARD_THREADS,
+    CONFIG_UINT32_VMAP_LOS_CACHE_TIME,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -323,6 +327,12 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_MOVEMENT_LOD_NEAR_CONTINENTS,
+    CONFIG_FLOAT_MOVEMENT_LOD_MID_CONTINENTS,
+    CONFIG_FLOAT_MOVEMENT_LOD_NEAR_INSTANCES,
+    CONFIG_FLOAT_MOVEMENT_LOD_MID_INSTANCES,
+    CONFIG_FLOAT_MOVEMENT_LOD_NEAR_BGARENAS,
+    CONFIG_FLOAT_MOVEMENT_LOD_MID_BGARENAS,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -734,6 +744,7 @@ class World
         uint32 mail_timer_expires;
 
         SessionMap m_sessions;
+        PacketShardExecutor* m_packetShards;                // NULL when every thread-unsafe packet runs on the world thread
         uint32 m_maxActiveSessionCount;
         uint32 m_maxQueuedSessionCount;
 
@@ -24,6 +24,9 @@
 
 #include "BIH.h"
 
+#include <thread>
+#include <exception>
+
 void BIH::buildHierarchy(std::vector<uint32>& tempTree, buildData& dat, BuildStats& stats)
 {
     // create space for the first node
@@ -254,6 +257,11 @@ void BIH::subdivide(int left, int right, std::vector<uint32>& tempTree, buildDat
     nodeBoxL.hi[axis] = clipL;
     nodeBoxR.lo[axis] = clipR;
     // recurse
+    if (nl > 0 && nr >= BIH_PARALLEL_MIN_PRIMS &&
+        subdivideParallel(left, right, rightOrig, tempTree, dat, gridBoxL, nodeBoxL, gridBoxR, nodeBoxR, nextIndex, depth, stats))
+    {
+        return;
+    }
     if (nl > 0)
     {
         subdivide(left, right, tempTree, dat, gridBoxL, nodeBoxL, nextIndex, depth + 1, stats);
@@ -272,6 +280,91 @@ void BIH::subdivide(int left, int right, std::vector<uint32>& tempTree, buildDat
     }
 }
 
+bool BIH::subdivideParallel(int left, int right, int rightOrig, std::vector<uint32>& tempTree, buildData& dat,
+                            AABound& gridBoxL, AABound& nodeBoxL, AABound& gridBoxR, AABound& nodeBoxR,
+                            int nextIndex, int depth, BuildStats& stats)
+{
+    if (dat.spareThreads->fetch_sub(1) <= 0)
+    {
+        ++(*dat.spareThreads);
+        return false;
+    }
+
+    // the right subtree gets its own node array with the root in the first node,
+    // the left one is built in place, exactly as the serial build would do
+    std::vector<uint32> rightTree(3, 0);
+    BuildStats rightStats;
+    std::exception_ptr rightError;
+    std::thread worker([&]()
+    {
+        try
+        {
+            subdivide(right + 1, rightOrig, rightTree, dat, gridBoxR, nodeBoxR, 0, depth + 1, rightStats);
+        }
+        catch (...)
+        {
+            rightError = std::current_exception();
+        }
+    });
+
+    std::exception_ptr leftError;
+    try
+    {
+        subdivide(left, right, tempTree, dat, gridBoxL, nodeBoxL, nextIndex, depth + 1, stats);
+    }
+    catch (...)
+    {
+        leftError = std::current_exception();
+    }
+
+    worker.join();
+    ++(*dat.spareThreads);
+
+    if (leftError)
+    {
+        std::rethrow_exception(leftError);
+    }
+    if (rightError)
+    {
+        std::rethrow_exception(rightError);
+    }
+
+    // a serial build appends the right subtree after the left one, do the same
+    mergeSubtree(tempTree, nextIndex + 3, rightTree);
+    stats.merge(rightStats);
+    return true;
+}
+
+void BIH::mergeSubtree(std::vector<uint32>& tempTree, int nodeIndex, const std::vector<uint32>& subTree)
+{
+    // subtree nodes behind its root move from index 3 to the current end of the tree
+    uint32 offset = tempTree.size() - 3;
+    tempTree.reserve(tempTree.size() + subTree.size() - 3);
+
+    for (size_t i = 0; i < subTree.size(); i += 3)
+    {
+        uint32 node = subTree[i];
+        // leaves reference objects, all other nodes reference their child nodes
+        if ((node >> 30) != 3)
+        {
+            node = (node & (7u << 29)) | ((node & ~(7u << 29)) + offset);
+        }
+
+        if (i == 0)
+        {
+            tempTree[nodeIndex + 0] = node;
+            tempTree[nodeIndex + 1] = subTree[1];
+            tempTree[nodeIndex + 2] = subTree[2];
+        }
+        else
+        {
+            tempTree.push_back(node);
+            tempTree.push_back(subTree[i + 1]);
+            tempTree.push_back(subTree[i + 2]);
+        }
+    }
+}
+
 bool BIH::WriteToFile(FILE* wf) const
 {
     uint32 treeSize = tree.size();
@@ -316,6 +409,23 @@ void BIH::BuildStats::updateLeaf(int depth, int n)
     ++numLeavesN[nl];
 }
 
+void BIH::BuildStats::merge(const BuildStats& other)
+{
+    numNodes += other.numNodes;
+    numLeaves += other.numLeaves;
+    sumObjects += other.sumObjects;
+    minObjects = std::min(minObjects, other.minObjects);
+    maxObjects = std::max(maxObjects, other.maxObjects);
+    sumDepth += other.sumDepth;
+    minDepth = std::min(minDepth, other.minDepth);
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    for (int i = 0; i < 6; ++i)
+    {
+        numLeavesN[i] += other.numLeavesN[i];
+    }
+    numBVH2 += other.numBVH2;
+}
+
 void BIH::BuildStats::printStats()
 {
     printf("Tree stats:\n");
@@ -32,12 +32,15 @@
 #include <Platform/Define.h>
 
 #include <stdexcept>
+#include <atomic>
 #include <vector>
 #include <algorithm>
 #include <limits>
 #include <cmath>
 
 #define MAX_STACK_SIZE 64
+// subtrees with fewer primitives than this are never handed to another thread
+#define BIH_PARALLEL_MIN_PRIMS 8192
 
 #ifdef _MSC_VER
 #define isnan(x) _isnan(x)
@@ -130,8 +133,9 @@ class BIH
          * @param getBounds
          * @param leafSize
          * @param printStats
+         * @param buildThreads max threads used to build large trees, the result does not depend on it
          */
-        void build(const PrimArray& primitives, BoundsFunc& getBounds, uint32 leafSize = 3, bool printStats = false)
+        void build(const PrimArray& primitives, BoundsFunc& getBounds, uint32 leafSize = 3, bool printStats = false, uint32 buildThreads = 1)
         {
             if (primitives.size() == 0)
             {
@@ -143,6 +147,8 @@ class BIH
             dat.numPrims = primitives.size();
             dat.indices = new uint32[dat.numPrims];
             dat.primBound = new AABox[dat.numPrims];
+            std::atomic<int> spareThreads(int(buildThreads) - 1);
+            dat.spareThreads = &spareThreads;
             getBounds(primitives[0], bounds);
             for (uint32 i = 0; i < dat.numPrims; ++i)
             {
@@ -174,17 +180,50 @@ class BIH
          * @return uint32
          */
         uint32 primCount() { return objects.size(); }
+        /**
+         * @brief true if both trees would be written to the same file
+         *
+         * @param other
+         * @return bool
+         */
+        bool operator==(const BIH& other) const
+        {
+            return tree == other.tree && objects == other.objects &&
+                bounds.low() == other.bounds.low() && bounds.high() == other.bounds.high();
+        }
+
+        /**
+         * @brief order of the primitives in the leaves, a leaf covers a continuous range of it
+         *
+         * @return const std::vector<uint32>
+         */
+        const std::vector<uint32>& primOrder() const { return objects; }
 
         template<typename RayCallback>
         /**
          * @brief
          *
          * @param r
-         * @param intersectCallback
+         * @param intersectCallback called with each primitive index of the leaves the ray passes
          * @param maxDist
          * @param stopAtFirst
          */
         void IntersectRay(const Ray& r, RayCallback& intersectCallback, float& maxDist, bool stopAtFirst = false) const
+        {
+            LeafPrimitivesCallback<RayCallback> leafCallback(intersectCallback, objects, stopAtFirst);
+            IntersectRayLeaves(r, leafCallback, maxDist, stopAtFirst);
+        }
+
+        template<typename LeafCallback>
+        /**
+         * @brief IntersectRay() for callbacks testing a whole leaf at once
+         *
+         * @param r
+         * @param leafCallback called with the range of primOrder() positions of each leaf the ray passes
+         * @param maxDist
+         * @param stopAtFirst
+         */
+        void IntersectRayLeaves(const Ray& r, LeafCallback& leafCallback, float& maxDist, bool stopAtFirst = false) const
         {
             float intervalMin = -1.f;
             float intervalMax = -1.f;
@@ -296,15 +335,9 @@ class BIH
                         {
                             // leaf - test some objects
                             int n = tree[node + 1];
-                            while (n > 0)
+                            if (n > 0 && leafCallback(r, uint32(offset), uint32(n), maxDist) && stopAtFirst)
                             {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
-                                if (stopAtFirst && hit)
-                                {
-                                    return;
-                                }
-                                --n;
-                                ++offset;
+                                return;
                             }
                             break;
                         }
@@ -477,7 +510,33 @@ class BIH
             AABox* primBound; /**< TODO */
             uint32 numPrims; /**< TODO */
             int maxPrims; /**< TODO */
+            std::atomic<int>* spareThreads; /**< threads still free to take a subtree */
         };
+        template<typename RayCallback>
+        /**
+         * @brief Passes the primitives of a leaf one by one to an IntersectRay() callback
+         *
+         */
+        struct LeafPrimitivesCallback
+        {
+            LeafPrimitivesCallback(RayCallback& callback, const std::vector<uint32>& prims, bool stopAtFirst) :
+                cb(callback), objects(prims), stop(stopAtFirst) {}
+            bool operator()(const Ray& r, uint32 first, uint32 count, float& maxDist)
+            {
+                for (uint32 i = first; i < first + count; ++i)
+                {
+                    if (cb(r, objects[i], maxDist, stop) && stop)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            RayCallback& cb; /**< TODO */
+            const std::vector<uint32>& objects; /**< TODO */
+            bool stop; /**< TODO */
+        };
+
         /**
          * @brief
          *
@@ -540,6 +599,12 @@ class BIH
                  * @param n
                  */
                 void updateLeaf(int depth, int n);
+                /**
+                 * @brief adds the stats of a subtree built separately
+                 *
+                 * @param other
+                 */
+                void merge(const BuildStats& other);
                 /**
                  * @brief
                  *
@@ -585,6 +650,24 @@ class BIH
          * @param stats
          */
         void subdivide(int left, int right, std::vector<uint32>& tempTree, buildData& dat, AABound& gridBox, AABound& nodeBox, int nodeIndex, int depth, BuildStats& stats);
+
+        /**
+         * @brief builds both subtrees of a node, the right one on another thread
+         *
+         * @return bool false if no thread was available, nothing is built then
+         */
+        bool subdivideParallel(int left, int right, int rightOrig, std::vector<uint32>& tempTree, buildData& dat,
+                               AABound& gridBoxL, AABound& nodeBoxL, AABound& gridBoxR, AABound& nodeBoxR,
+                               int nextIndex, int depth, BuildStats& stats);
+
+        /**
+         * @brief appends a separately built subtree, its root is copied to nodeIndex
+         *
+         * @param tempTree
+         * @param nodeIndex
+         * @param subTree
+         */
+        static void mergeSubtree(std::vector<uint32>& tempTree, int nodeIndex, const std::vector<uint32>& subTree);
 };
 
 #endif // _BIH_H
@@ -196,4 +196,28 @@ class BIHWrap
             MDLCallback<IsectCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
             m_tree.intersectPoint(p, temp_cb);
         }
+
+        template<typename BoxCallback>
+        /**
+         * @brief Calls back every object whose bounds overlap the box
+         *
+         * @param box
+         * @param intersectCallback
+         */
+        void intersectBox(const G3D::AABox& box, BoxCallback& intersectCallback)
+        {
+            balance();
+            for (int i = 0; i < m_objects.size(); ++i)
+            {
+                if (const T* obj = m_objects[i])
+                {
+                    G3D::AABox bounds;
+                    BoundsFunc::getBounds2(obj, bounds);
+                    if (bounds.intersects(box))
+                    {
+                        intersectCallback(*obj);
+                    }
+                }
+            }
+        }
 };
@@ -280,6 +280,57 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
     return !callback.did_hit;
 }
 
+struct DynamicTreeBoxCallback
+{
+    std::vector<const GameObjectModel*>& models;
+    DynamicTreeBoxCallback(std::vector<const GameObjectModel*>& found) : models(found) {}
+    void operator()(const GameObjectModel& obj) { models.push_back(&obj); }
+};
+
+void DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, const Vector3* ends, bool* results, uint32 count, uint32 phasemask) const
+{
+    Vector3 v1(x1, y1, z1);
+    G3D::AABox box(v1, v1);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        box.merge(ends[i]);
+    }
+
+    // the grid cells are far larger than an area spell, few models are left to test against every ray
+    std::vector<const GameObjectModel*> models;
+    DynamicTreeBoxCallback callback(models);
+    impl.intersectBox(box, callback);
+    if (models.empty())
+    {
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (!results[i])
+        {
+            continue;
+        }
+
+        float maxDist = (ends[i] - v1).magnitude();
+        if (!G3D::fuzzyGt(maxDist, 0))
+        {
+            continue;
+        }
+
+        G3D::Ray r(v1, (ends[i] - v1) / maxDist);
+        for (std::vector<const GameObjectModel*>::const_iterator itr = models.begin(); itr != models.end(); ++itr)
+        {
+            float distance = maxDist;
+            if ((*itr)->IntersectRay(r, distance, true, phasemask))
+            {
+                results[i] = false;
+                break;
+            }
+        }
+    }
+}
+
 float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist, uint32 phasemask) const
 {
     Vector3 v(x, y, z);
@@ -66,6 +66,18 @@ class DynamicMapTree
          * @return bool
          */
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        /**
+         * @brief Line of sight from one point to many, the models near all rays are collected once
+         *
+         * @param x1
+         * @param y1
+         * @param z1
+         * @param ends end point of every ray
+         * @param results cleared for the rays a model blocks, rays already cleared are not tested
+         * @param count
+         * @param phasemask
+         */
+        void isInLineOfSight(float x1, float y1, float z1, const G3D::Vector3* ends, bool* results, uint32 count, uint32 phasemask) const;
         /**
          * @brief
          *
@@ -33,6 +33,8 @@
 
 #include "Errors.h"
 
+#include <algorithm>
+
 using G3D::Vector2;
 using G3D::Vector3;
 using G3D::AABox;
@@ -376,6 +378,25 @@ class RegularGrid2D
                 node->IntersectRay(ray, intersectCallback, max_dist);
             }
         }
+
+        template<typename BoxCallback>
+        /**
+         * @brief Calls back the values stored in the cells the box touches whose bounds overlap it
+         *
+         * @param box
+         * @param intersectCallback
+         */
+        void intersectBox(const AABox& box, BoxCallback& intersectCallback)
+        {
+            Cell low = Cell::ComputeCell(box.low().x, box.low().y);
+            Cell high = Cell::ComputeCell(box.high().x, box.high().y);
+            for (int x = std::max(low.x, 0); x <= std::min(high.x, CELL_NUMBER - 1); ++x)
+                for (int y = std::max(low.y, 0); y <= std::min(high.y, CELL_NUMBER - 1); ++y)
+                    if (Node* node = nodes[x][y])
+                    {
+                        node->intersectBox(box, intersectCallback);
+                    }
+        }
 };
 
 #undef CELL_SIZE
@@ -31,6 +31,8 @@
 #include <iomanip>
 #include <sstream>
 #include <iomanip>
+#include <thread>
+#include <atomic>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -62,12 +64,14 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads)
     {
         iCurrentUniqueNameId = 0;
         iFilterMethod = NULL;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
+        iThreads = threads ? threads : 1;
+        iCheckOutput = false;
         // mkdir(iDestDir);
         // init();
     }
@@ -77,6 +81,38 @@ namespace VMAP
         // delete iCoordModelMapping;
     }
 
+    bool TileAssembler::runTasks(size_t count, const std::function<bool(size_t)>& task)
+    {
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count && !failed; i = next++)
+            {
+                if (!task(i))
+                {
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32 i = 1; i < iThreads && i < count; ++i)
+        {
+            threads.push_back(std::thread(worker));
+        }
+
+        worker();
+
+        for (std::vector<std::thread>::iterator itr = threads.begin(); itr != threads.end(); ++itr)
+        {
+            itr->join();
+        }
+
+        return !failed;
+    }
+
     bool TileAssembler::convertWorld2()
     {
         bool success = readMapSpawns();
@@ -86,161 +122,192 @@ namespace VMAP
         }
 
         // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
+            maps.push_back(map_iter);
+        }
 
-            std::cout << "Calculating model bounds for map " << map_iter->first << std::endl;
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                    {
-                        break;
-                    }
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    // TODO: remove extractor hack and uncomment below line:
-                    // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+        std::vector<std::set<std::string> > mapModelFiles(maps.size());
+        success = runTasks(maps.size(), [&](size_t i)
+        {
+            return convertMap(maps[i]->first, *maps[i]->second, mapModelFiles[i]);
+        });
 
-            std::cout << "Creating map tree..." << std::endl;
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        for (uint32 i = 0; i < mapModelFiles.size(); ++i)
+        {
+            spawnedModelFiles.insert(mapModelFiles[i].begin(), mapModelFiles[i].end());
+        }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
-            {
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
-            }
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // export objects
+        std::cout <<  std::endl << "Converting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        bool modelsConverted = runTasks(modelFiles.size(), [&](size_t i)
+        {
+            printf("Converting %s\n", modelFiles[i].c_str());
+            if (!convertRawFile(modelFiles[i]))
             {
-                success = false;
-                std::cout << "Can not open " << mapfilename.str();
-                break;
+                printf("error converting %s\n", modelFiles[i].c_str());
+                return false;
             }
+            return true;
+        });
+
+        // cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success && modelsConverted;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapID, MapSpawns& spawns, std::set<std::string>& modelFiles)
+    {
+        bool success = true;
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
 
-            // general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8)
+        printf("Calculating model bounds for map %u\n", mapID);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
+                if (!calculateTransformedBound(entry->second))
+                {
+                    break;
+                }
             }
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = false;
+                // TODO: remove extractor hack and uncomment below line:
+                // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
             }
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1)
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
+
+        printf("Creating map tree for map %u...\n", mapID);
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds, 3, false, iThreads);
+
+        if (iCheckOutput && iThreads > 1)
+        {
+            BIH checkTree;
+            checkTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds, 3, false, 1);
+            if (!(checkTree == pTree))
             {
-                success = false;
+                printf("error: map tree of map %u differs from single threaded build\n", mapID);
+                return false;
             }
-            if (success)
+        }
+
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
+        {
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        }
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapID << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Can not open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        // general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8)
+        {
+            success = false;
+        }
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1)
+        {
+            success = false;
+        }
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1)
+        {
+            success = false;
+        }
+        if (success)
+        {
+            success = pTree.WriteToFile(mapfile);
+        }
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1)
+        {
+            success = false;
+        }
+
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::WriteToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
             {
-                success = pTree.WriteToFile(mapfile);
+                continue;
             }
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1)
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << "/" << std::setw(3) << mapID << "_";
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+            FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
+            // file header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8)
             {
                 success = false;
             }
-
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1)
             {
-                success = ModelSpawn::WriteToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                success = false;
             }
-
-            fclose(mapfile);
-
-            // <====
-
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+            // write tile spawns
+            for (uint32 s = 0; s < nSpawns; ++s)
             {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
-                {
-                    continue;
-                }
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // file header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8)
+                if (s && tile != tileEntries.end())
                 {
-                    success = false;
+                    ++tile;
                 }
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1)
+                const ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                success = success && ModelSpawn::WriteToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1)
                 {
                     success = false;
                 }
-                // write tile spawns
-                for (uint32 s = 0; s < nSpawns; ++s)
-                {
-                    if (s && tile != tileEntries.end())
-                    {
-                        ++tile;
-                    }
-                    const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::WriteToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1)
-                    {
-                        success = false;
-                    }
-                }
-                fclose(tilefile);
-            }
-            // break; // test, extract only first map; TODO: remove this line
-        }
-
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-
-        // export objects
-        std::cout <<  std::endl << "Converting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
-        {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
             }
+            fclose(tilefile);
         }
 
-        // cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
-        {
-            delete map_iter->second;
-        }
         return success;
     }
 
@@ -375,13 +442,35 @@ namespace VMAP
         {
             std::vector<GroupModel> groupsArray;
 
+            bool checkGroups = iCheckOutput && iThreads > 1;
             uint32 groups = raw_model.groupsArray.size();
             for (uint32 g = 0; g < groups; ++g)
             {
                 GroupModel_Raw& raw_group = raw_model.groupsArray[g];
+
+                // SetMeshData takes the geometry, keep a copy for the reference build
+                std::vector<Vector3> checkVertices;
+                std::vector<MeshTriangle> checkTriangles;
+                if (checkGroups)
+                {
+                    checkVertices = raw_group.vertexArray;
+                    checkTriangles = raw_group.triangles;
+                }
+
                 groupsArray.push_back(GroupModel(raw_group.mogpflags, raw_group.GroupWMOID, raw_group.bounds));
-                groupsArray.back().SetMeshData(raw_group.vertexArray, raw_group.triangles);
+                groupsArray.back().SetMeshData(raw_group.vertexArray, raw_group.triangles, iThreads);
                 groupsArray.back().setLiquidData(raw_group.liquid);
+
+                if (checkGroups)
+                {
+                    GroupModel checkGroup(raw_group.mogpflags, raw_group.GroupWMOID, raw_group.bounds);
+                    checkGroup.SetMeshData(checkVertices, checkTriangles, 1);
+                    if (!(checkGroup.GetMeshTree() == groupsArray.back().GetMeshTree()))
+                    {
+                        printf("error: group %u of '%s' differs from single threaded build\n", g, pModelFilename.c_str());
+                        return false;
+                    }
+                }
             }
 
             model.SetGroupModels(groupsArray);
@@ -29,6 +29,7 @@
 #include <G3D/Matrix3.h>
 #include <map>
 #include <set>
+#include <functional>
 
 #include "ModelInstance.h"
 #include "WorldModel.h"
@@ -171,6 +172,26 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId; /**< TODO */
             MapData mapData; /**< TODO */
             std::set<std::string> spawnedModelFiles; /**< TODO */
+            uint32 iThreads; /**< number of threads converting maps and models */
+            bool iCheckOutput; /**< rebuild every tree single threaded and compare */
+
+            /**
+             * @brief runs task(0) ... task(count - 1) on the worker threads
+             *
+             * @param count
+             * @param task
+             * @return bool false if any task failed, no new tasks are started then
+             */
+            bool runTasks(size_t count, const std::function<bool(size_t)>& task);
+            /**
+             * @brief calculates the spawn bounds of a map and writes its tree and tile files
+             *
+             * @param mapID
+             * @param spawns
+             * @param modelFiles receives the names of all models spawned on the map
+             * @return bool
+             */
+            bool convertMap(uint32 mapID, MapSpawns& spawns, std::set<std::string>& modelFiles);
 
         public:
             /**
@@ -178,8 +199,9 @@ namespace VMAP
              *
              * @param pSrcDirName
              * @param pDestDirName
+             * @param threads
              */
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 1);
             /**
              * @brief
              *
@@ -224,6 +246,12 @@ namespace VMAP
              * @param )
              */
             void setModelNameFilterMethod(bool (*pFilterMethod)(char* pName)) { iFilterMethod = pFilterMethod; }
+            /**
+             * @brief verify that threaded tree builds match single threaded ones
+             *
+             * @param check
+             */
+            void setCheckOutput(bool check) { iCheckOutput = check; }
             /**
              * @brief
              *
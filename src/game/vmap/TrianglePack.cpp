@@ -0,0 +1,214 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TrianglePack.h"
+#include "WorldModel.h"
+
+#include <cmath>
+#include <limits>
+
+#ifdef VMAP_TRIANGLE_SSE
+#include <emmintrin.h>
+#endif
+
+using G3D::Vector3;
+
+namespace VMAP
+{
+    static const float EPS = 1e-5f;
+
+    void TrianglePack::build(const std::vector<Vector3>& vertices, const std::vector<MeshTriangle>& triangles, const std::vector<uint32>& order)
+    {
+        clear();
+
+        m_size = uint32(order.size());
+        for (int c = 0; c < MAX_COMPONENTS; ++c)
+        {
+            m_data[c].resize(m_size + 3, 0.0f);
+        }
+
+        for (uint32 i = 0; i < m_size; ++i)
+        {
+            const MeshTriangle& tri = triangles[order[i]];
+            const Vector3& v0 = vertices[tri.idx0];
+            const Vector3 e1 = vertices[tri.idx1] - v0;
+            const Vector3 e2 = vertices[tri.idx2] - v0;
+
+            m_data[V0_X][i] = v0.x;
+            m_data[V0_Y][i] = v0.y;
+            m_data[V0_Z][i] = v0.z;
+            m_data[E1_X][i] = e1.x;
+            m_data[E1_Y][i] = e1.y;
+            m_data[E1_Z][i] = e1.z;
+            m_data[E2_X][i] = e2.x;
+            m_data[E2_Y][i] = e2.y;
+            m_data[E2_Z][i] = e2.z;
+        }
+    }
+
+    void TrianglePack::clear()
+    {
+        for (int c = 0; c < MAX_COMPONENTS; ++c)
+        {
+            std::vector<float>().swap(m_data[c]);
+        }
+        m_size = 0;
+    }
+
+    bool TrianglePack::IntersectRayScalar(const G3D::Ray& ray, uint32 first, uint32 count, float& distance) const
+    {
+        const Vector3& dir = ray.direction();
+        const Vector3& org = ray.origin();
+        bool hit = false;
+
+        for (uint32 i = first; i < first + count; ++i)
+        {
+            const Vector3 v0(m_data[V0_X][i], m_data[V0_Y][i], m_data[V0_Z][i]);
+            const Vector3 e1(m_data[E1_X][i], m_data[E1_Y][i], m_data[E1_Z][i]);
+            const Vector3 e2(m_data[E2_X][i], m_data[E2_Y][i], m_data[E2_Z][i]);
+
+            const Vector3 p(dir.cross(e2));
+            const float a = e1.dot(p);
+            if (fabs(a) < EPS)
+            {
+                continue;
+            }
+
+            const float f = 1.0f / a;
+            const Vector3 s(org - v0);
+            const float u = f * s.dot(p);
+            if ((u < 0.0f) || (u > 1.0f))
+            {
+                continue;
+            }
+
+            const Vector3 q(s.cross(e1));
+            const float v = f * dir.dot(q);
+            if ((v < 0.0f) || ((u + v) > 1.0f))
+            {
+                continue;
+            }
+
+            const float t = f * e2.dot(q);
+            if ((t > 0.0f) && (t < distance))
+            {
+                distance = t;
+                hit = true;
+            }
+        }
+
+        return hit;
+    }
+
+#ifdef VMAP_TRIANGLE_SSE
+    bool TrianglePack::IntersectRaySSE(const G3D::Ray& ray, uint32 first, uint32 count, float& distance) const
+    {
+        // lanes of a block that hold triangles of the range, indexed by the number of them
+        static const uint32 laneMasks[5][4] =
+        {
+            { 0, 0, 0, 0 },
+            { 0xFFFFFFFF, 0, 0, 0 },
+            { 0xFFFFFFFF, 0xFFFFFFFF, 0, 0 },
+            { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 },
+            { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF }
+        };
+
+        const __m128 dx = _mm_set1_ps(ray.direction().x);
+        const __m128 dy = _mm_set1_ps(ray.direction().y);
+        const __m128 dz = _mm_set1_ps(ray.direction().z);
+        const __m128 ox = _mm_set1_ps(ray.origin().x);
+        const __m128 oy = _mm_set1_ps(ray.origin().y);
+        const __m128 oz = _mm_set1_ps(ray.origin().z);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 eps = _mm_set1_ps(EPS);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+
+        __m128 closest = _mm_set1_ps(distance);
+        bool hit = false;
+
+        for (uint32 i = first; i < first + count; i += 4)
+        {
+            uint32 lanes = first + count - i;
+            __m128 valid = _mm_loadu_ps(reinterpret_cast<const float*>(laneMasks[lanes < 4 ? lanes : 4]));
+
+            const __m128 e1x = _mm_loadu_ps(&m_data[E1_X][i]);
+            const __m128 e1y = _mm_loadu_ps(&m_data[E1_Y][i]);
+            const __m128 e1z = _mm_loadu_ps(&m_data[E1_Z][i]);
+            const __m128 e2x = _mm_loadu_ps(&m_data[E2_X][i]);
+            const __m128 e2y = _mm_loadu_ps(&m_data[E2_Y][i]);
+            const __m128 e2z = _mm_loadu_ps(&m_data[E2_Z][i]);
+
+            // p = dir x e2, a = e1 . p
+            const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            valid = _mm_andnot_ps(_mm_cmplt_ps(_mm_and_ps(a, absMask), eps), valid);
+            if (!_mm_movemask_ps(valid))
+            {
+                continue;
+            }
+
+            const __m128 f = _mm_div_ps(one, a);
+
+            // s = org - v0, u = f * (s . p)
+            const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(&m_data[V0_X][i]));
+            const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(&m_data[V0_Y][i]));
+            const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(&m_data[V0_Z][i]));
+            const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)));
+            valid = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)), valid);
+
+            // q = s x e1, v = f * (dir . q)
+            const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+            const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+            const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+            const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)));
+            valid = _mm_andnot_ps(_mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)), valid);
+
+            // t = f * (e2 . q)
+            const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+            valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, closest)));
+            if (!_mm_movemask_ps(valid))
+            {
+                continue;
+            }
+
+            // closest hit of the block in every lane
+            __m128 hits = _mm_or_ps(_mm_and_ps(valid, t), _mm_andnot_ps(valid, inf));
+            hits = _mm_min_ps(hits, _mm_shuffle_ps(hits, hits, _MM_SHUFFLE(2, 3, 0, 1)));
+            hits = _mm_min_ps(hits, _mm_shuffle_ps(hits, hits, _MM_SHUFFLE(1, 0, 3, 2)));
+            closest = hits;
+            hit = true;
+        }
+
+        if (hit)
+        {
+            distance = _mm_cvtss_f32(closest);
+        }
+        return hit;
+    }
+#endif
+}
@@ -0,0 +1,140 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_TRIANGLEPACK
+#define MANGOS_H_TRIANGLEPACK
+
+#include <G3D/Vector3.h>
+#include <G3D/Ray.h>
+
+#include "Platform/Define.h"
+
+#include <vector>
+
+// SSE2 is part of every x86-64 target, 32 bit builds only get it when asked for
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VMAP_TRIANGLE_SSE
+#endif
+
+namespace VMAP
+{
+    class MeshTriangle;
+
+    /**
+     * @brief Triangles of a mesh prepared for ray tests
+     *
+     * Each triangle is stored as its first vertex and its two edges, every
+     * component in an array of its own (structure of arrays) so four triangles
+     * are loaded into SSE registers at once. The triangles are kept in the
+     * order of the mesh BIH leaves, a leaf is then a continuous range.
+     */
+    class TrianglePack
+    {
+        public:
+            /**
+             * @brief
+             *
+             */
+            TrianglePack() : m_size(0) {}
+
+            /**
+             * @brief
+             *
+             * @param vertices
+             * @param triangles
+             * @param order triangle index of every position, BIH::primOrder() of the mesh tree
+             */
+            void build(const std::vector<G3D::Vector3>& vertices, const std::vector<MeshTriangle>& triangles, const std::vector<uint32>& order);
+            /**
+             * @brief
+             *
+             */
+            void clear();
+            /**
+             * @brief
+             *
+             * @return uint32
+             */
+            uint32 size() const { return m_size; }
+
+            /**
+             * @brief Tests the ray against the triangles [first, first + count), see RTR2 ch. 13.7
+             *
+             * @param ray
+             * @param first
+             * @param count
+             * @param distance lowered to the closest hit
+             * @return bool true if a triangle was hit closer than distance
+             */
+            bool IntersectRay(const G3D::Ray& ray, uint32 first, uint32 count, float& distance) const
+            {
+#ifdef VMAP_TRIANGLE_SSE
+                return IntersectRaySSE(ray, first, count, distance);
+#else
+                return IntersectRayScalar(ray, first, count, distance);
+#endif
+            }
+
+            /**
+             * @brief One triangle at a time, for targets without SSE2 and as reference for the SSE kernel
+             *
+             * @param ray
+             * @param first
+             * @param count
+             * @param distance
+             * @return bool
+             */
+            bool IntersectRayScalar(const G3D::Ray& ray, uint32 first, uint32 count, float& distance) const;
+#ifdef VMAP_TRIANGLE_SSE
+            /**
+             * @brief Four triangles at a time
+             *
+             * @param ray
+             * @param first
+             * @param count
+             * @param distance
+             * @return bool
+             */
+            bool IntersectRaySSE(const G3D::Ray& ray, uint32 first, uint32 count, float& distance) const;
+#endif
+
+        private:
+            /**
+             * @brief
+             *
+             */
+            enum Component
+            {
+                V0_X, V0_Y, V0_Z,
+                E1_X, E1_Y, E1_Z,
+                E2_X, E2_Y, E2_Z,
+                MAX_COMPONENTS
+            };
+
+            std::vector<float> m_data[MAX_COMPONENTS]; /**< padded by three so the last block can always be loaded */
+            uint32 m_size; /**< TODO */
+    };
+}
+
+#endif
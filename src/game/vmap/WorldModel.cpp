@@ -41,59 +41,6 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle& tri, std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, float& distance)
-    {
-        static const float EPS = 1e-5f;
-
-        // See RTR2 ch. 13.7 for the algorithm.
-
-        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
-        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
-        const Vector3 p(ray.direction().cross(e2));
-        const float a = e1.dot(p);
-
-        if (fabs(a) < EPS)
-        {
-            // Determinant is ill-conditioned; abort early
-            return false;
-        }
-
-        const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
-        const float u = f * s.dot(p);
-
-        if ((u < 0.0f) || (u > 1.0f))
-        {
-            // We hit the plane of the m_geometry, but outside the m_geometry
-            return false;
-        }
-
-        const Vector3 q(s.cross(e1));
-        const float v = f * ray.direction().dot(q);
-
-        if ((v < 0.0f) || ((u + v) > 1.0f))
-        {
-            // We hit the plane of the triangle, but outside the triangle
-            return false;
-        }
-
-        const float t = f * e2.dot(q);
-
-        if ((t > 0.0f) && (t < distance))
-        {
-            // This is a new hit, closer than the previous one
-            distance = t;
-
-            /* baryCoord[0] = 1.0 - u - v;
-            baryCoord[1] = u;
-            baryCoord[2] = v; */
-
-            return true;
-        }
-        // This hit is after the previous hit, so ignore it
-        return false;
-    }
-
     class TriBoundFunc
     {
         public:
@@ -309,7 +256,7 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel& other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), meshTriangles(other.meshTriangles), iLiquid(0)
     {
         if (other.iLiquid)
         {
@@ -317,12 +264,13 @@ namespace VMAP
         }
     }
 
-    void GroupModel::SetMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri)
+    void GroupModel::SetMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri, uint32 buildThreads)
     {
         vertices.swap(vert);
         triangles.swap(tri);
         TriBoundFunc bFunc(vertices);
-        meshTree.build(triangles, bFunc);
+        meshTree.build(triangles, bFunc, 3, false, buildThreads);
+        meshTriangles.build(vertices, triangles, meshTree.primOrder());
     }
 
     bool GroupModel::WriteToFile(FILE* wf)
@@ -425,6 +373,7 @@ namespace VMAP
         uint32 count =0;
         triangles.clear();
         vertices.clear();
+        meshTriangles.clear();
         delete iLiquid;
         iLiquid = 0;
 
@@ -501,6 +450,10 @@ namespace VMAP
         {
             result = meshTree.ReadFromFile(rf);
         }
+        if (result)
+        {
+            meshTriangles.build(vertices, triangles, meshTree.primOrder());
+        }
 
         // read liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4))
@@ -520,19 +473,16 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
-        bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
+        GModelRayCallback(const TrianglePack& tris): triangles(tris), hit(false) {}
+        bool operator()(const G3D::Ray& ray, uint32 first, uint32 count, float& distance)
         {
-            bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
-            if (result)
+            if (triangles.IntersectRay(ray, first, count, distance))
             {
                 hit = true;
             }
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const TrianglePack& triangles;
         bool hit;
     };
 
@@ -542,8 +492,8 @@ namespace VMAP
         {
             return false;
         }
-        GModelRayCallback callback(triangles, vertices);
-        meshTree.IntersectRay(ray, callback, distance, stopAtFirstHit);
+        GModelRayCallback callback(meshTriangles);
+        meshTree.IntersectRayLeaves(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
 
@@ -553,7 +503,6 @@ namespace VMAP
         {
             return false;
         }
-        GModelRayCallback callback(triangles, vertices);
         Vector3 rPos = pos - 0.1f * down;
         float dist = G3D::inf();
         G3D::Ray ray(rPos, down);
@@ -30,6 +30,7 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include "BIH.h"
+#include "TrianglePack.h"
 
 #include "Platform/Define.h"
 
@@ -202,8 +203,9 @@ namespace VMAP
              *
              * @param vert
              * @param tri
+             * @param buildThreads max threads used to build the BIH
              */
-            void SetMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri);
+            void SetMeshData(std::vector<Vector3>& vert, std::vector<MeshTriangle>& tri, uint32 buildThreads = 1);
             /**
              * @brief
              *
@@ -274,6 +276,12 @@ namespace VMAP
              * @return uint32
              */
             uint32 GetWmoID() const { return iGroupWMOID; }
+            /**
+             * @brief
+             *
+             * @return const BIH
+             */
+            const BIH& GetMeshTree() const { return meshTree; }
         protected:
             G3D::AABox iBound;  /**< TODO */
             uint32 iMogpFlags;  /**< 0x8 outdor; 0x2000 indoor */
@@ -281,6 +289,7 @@ namespace VMAP
             std::vector<Vector3> vertices; /**< TODO */
             std::vector<MeshTriangle> triangles; /**< TODO */
             BIH meshTree; /**< TODO */
+            TrianglePack meshTriangles; /**< the triangles again, in leaf order for the ray tests */
             WmoLiquid* iLiquid; /**< TODO */
 
 #ifdef MMAP_GENERATOR
@@ -0,0 +1,1094 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup loadbot
+    \brief Client side of the realmd and world protocols for build 15595.
+*/
+
+#include "BotSession.h"
+#include "BotStats.h"
+#include "Auth/AuthCodes.h"
+#include "Auth/LogonSRP6.h"
+#include "Auth/Sha1.h"
+#include "Util.h"
+// defines the movement sequence arrays, must only be included by this file
+#include "movement/MovementStructures.h"
+
+#include <ace/INET_Addr.h>
+#include <ace/Reactor.h>
+#include <ace/SOCK_Connector.h>
+#include <ace/os_include/netinet/os_tcp.h>
+
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    const uint16 CLIENT_BUILD           = 15595;
+    const uint32 CONNECT_TIMEOUT        = 5;                // seconds, realmd and world connect
+    const uint32 HEARTBEAT_INTERVAL     = 500;              // ms
+    const uint32 WALK_DURATION          = 4000;             // ms, one leg of the back and forth walk
+    const uint32 PAUSE_DURATION         = 1000;             // ms between two legs
+    const uint32 CHAT_INTERVAL          = 15000;            // ms
+    const uint32 CAST_INTERVAL          = 20000;            // ms
+    const uint32 AUCTION_INTERVAL       = 30000;            // ms
+    const uint32 PING_INTERVAL          = 30000;            // ms, the server counts faster pings as flooding
+    const uint32 BOT_MOVEFLAG_FORWARD   = 0x00000001;
+    const float  BOT_RUN_SPEED          = 7.0f;
+    const uint8  REALM_PROOF_SIZE       = 32;               // sAuthLogonProof_S for 2.4.3 and later
+
+    uint64 NowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Name used in the latency report, only the opcodes the bots send are listed
+     *
+     * LookupOpcodeName() is not used because it would pull the whole handler table into the link.
+     *
+     * @param opcode
+     * @return const char
+     */
+    char const* RequestName(uint16 opcode)
+    {
+        switch (opcode)
+        {
+            case CMSG_AUTH_SESSION:         return "CMSG_AUTH_SESSION";
+            case CMSG_CHAR_ENUM:            return "CMSG_CHAR_ENUM";
+            case CMSG_CHAR_CREATE:          return "CMSG_CHAR_CREATE";
+            case CMSG_PLAYER_LOGIN:         return "CMSG_PLAYER_LOGIN";
+            case CMSG_MESSAGECHAT_SAY:      return "CMSG_MESSAGECHAT_SAY";
+            case CMSG_CAST_SPELL:           return "CMSG_CAST_SPELL";
+            case CMSG_AUCTION_LIST_ITEMS:   return "CMSG_AUCTION_LIST_ITEMS";
+            case CMSG_PING:                 return "CMSG_PING";
+            default:                        return "UNKNOWN";
+        }
+    }
+
+    /**
+     * @brief Character name for an account number, letters only so the server accepts it
+     *
+     * @param index
+     * @return std::string
+     */
+    std::string CharacterName(uint32 index)
+    {
+        std::string name = "Bot";
+        char letters[5];
+        for (int i = 3; i >= 0; --i)
+        {
+            letters[i] = char('a' + index % 26);
+            index /= 26;
+        }
+        letters[4] = '\0';
+        return name + letters;
+    }
+
+    bool RecvExact(ACE_SOCK_Stream& stream, void* buf, size_t len)
+    {
+        ACE_Time_Value timeout(CONNECT_TIMEOUT);
+        return stream.recv_n(buf, len, &timeout) == ssize_t(len);
+    }
+
+    bool SendExact(ACE_SOCK_Stream& stream, ByteBuffer const& pkt)
+    {
+        ACE_Time_Value timeout(CONNECT_TIMEOUT);
+        return stream.send_n(pkt.contents(), pkt.size(), &timeout) == ssize_t(pkt.size());
+    }
+}
+
+BotSession::BotSession(BotConfig const& config, uint32 index, std::string const& account, LatencyStats& stats)
+    : m_config(config), m_index(index), m_account(account), m_stats(stats), m_state(BOT_STATE_NEW),
+      m_headerDecrypted(0), m_mapId(0), m_x(0.0f), m_y(0.0f), m_z(0.0f), m_o(0.0f), m_moving(false),
+      m_legStartMs(0), m_lastMoveMs(0), m_nextChatMs(0), m_nextCastMs(0), m_nextAuctionMs(0), m_nextPingMs(0),
+      m_castCount(0), m_pingCounter(0), m_nowMs(0)
+{
+    for (size_t i = 0; i < m_account.size(); ++i)
+    {
+        m_account[i] = toupper(m_account[i]);
+    }
+}
+
+BotSession::~BotSession()
+{
+    Close();
+}
+
+bool BotSession::Open(ACE_Reactor* reactor)
+{
+    std::string worldAddress;
+    if (!RealmLogon(worldAddress))
+    {
+        m_state = BOT_STATE_CLOSED;
+        return false;
+    }
+
+    if (!m_config.worldAddress.empty())
+    {
+        worldAddress = m_config.worldAddress;
+    }
+
+    if (!ConnectWorld(worldAddress))
+    {
+        m_state = BOT_STATE_CLOSED;
+        return false;
+    }
+
+    this->reactor(reactor);
+    if (reactor->register_handler(this, ACE_Event_Handler::READ_MASK) == -1)
+    {
+        Fail("reactor registration failed");
+        return false;
+    }
+
+    m_state = BOT_STATE_AUTH_CHALLENGE;
+    return true;
+}
+
+void BotSession::Fail(char const* reason)
+{
+    if (m_error.empty())
+    {
+        m_error = reason;
+    }
+
+    Close();
+}
+
+void BotSession::Close()
+{
+    if (m_peer.get_handle() != ACE_INVALID_HANDLE)
+    {
+        if (reactor())
+        {
+            reactor()->remove_handler(this, ACE_Event_Handler::READ_MASK | ACE_Event_Handler::DONT_CALL);
+        }
+
+        m_peer.close();
+    }
+
+    m_pending.clear();
+    m_state = BOT_STATE_CLOSED;
+}
+
+bool BotSession::RealmLogon(std::string& worldAddress)
+{
+    ACE_INET_Addr addr(m_config.realmPort, m_config.realmHost.c_str());
+    ACE_SOCK_Connector connector;
+    ACE_SOCK_Stream realm;
+    ACE_Time_Value timeout(CONNECT_TIMEOUT);
+
+    if (connector.connect(realm, addr, &timeout) == -1)
+    {
+        m_error = "realmd connect failed";
+        return false;
+    }
+
+    // sAuthLogonChallenge_C, the strings go out reversed like the client sends them
+    ByteBuffer pkt;
+    pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
+    pkt << uint8(8);
+    pkt << uint16(30 + m_account.size());
+    pkt.append("WoW", 4);
+    pkt << uint8(4) << uint8(3) << uint8(4);
+    pkt << uint16(CLIENT_BUILD);
+    pkt.append("68x", 4);
+    pkt.append("niW", 4);
+    pkt.append("SUne", 4);
+    pkt << uint32(0);                                       // timezone bias
+    pkt << uint32(0x0100007F);                              // 127.0.0.1
+    pkt << uint8(m_account.size());
+    pkt.append(m_account.c_str(), m_account.size());
+
+    uint64 sentUs = NowMicros();
+    uint8 head[3];
+    if (!SendExact(realm, pkt) || !RecvExact(realm, head, sizeof(head)))
+    {
+        realm.close();
+        m_error = "no logon challenge reply";
+        return false;
+    }
+
+    if (head[2] != WOW_SUCCESS)
+    {
+        realm.close();
+        m_error = "logon challenge refused";
+        return false;
+    }
+
+    // B[32], g_len, g[1], N_len, N[32], s[32], unk3[16], security flags
+    uint8 challenge[32 + 1 + 1 + 1 + 32 + 32 + 16 + 1];
+    if (!RecvExact(realm, challenge, sizeof(challenge)))
+    {
+        realm.close();
+        m_error = "short logon challenge reply";
+        return false;
+    }
+
+    m_stats.Add("AUTH_LOGON_CHALLENGE", uint32(NowMicros() - sentUs));
+
+    if (challenge[sizeof(challenge) - 1] != 0)
+    {
+        realm.close();
+        m_error = "account needs a pin, matrix or token";
+        return false;
+    }
+
+    BigNumber B, g, N, s;
+    B.SetBinary(challenge, 32);
+    g.SetBinary(challenge + 33, 1);
+    N.SetBinary(challenge + 35, 32);
+    s.SetBinary(challenge + 67, 32);
+
+    std::string password = m_config.password.empty() ? m_account : m_config.password;
+    for (size_t i = 0; i < password.size(); ++i)
+    {
+        password[i] = toupper(password[i]);
+    }
+
+    Sha1Hash passDigest;
+    passDigest.UpdateData(m_account + ":" + password);
+    passDigest.Finalize();
+
+    BigNumber A, M1;
+    LogonSRP6::MakeClientSession(m_account, passDigest.GetDigest(), N, g, s, B, A, K, M1);
+
+    // sAuthLogonProof_C, no CRC and no extra security keys
+    pkt.clear();
+    pkt << uint8(CMD_AUTH_LOGON_PROOF);
+    uint8 bytes[32];
+    LogonSRP6::PackBytes(A, bytes, 32);
+    pkt.append(bytes, 32);
+    LogonSRP6::PackBytes(M1, bytes, 20);
+    pkt.append(bytes, 20);
+    for (int i = 0; i < 20; ++i)
+    {
+        pkt << uint8(0);
+    }
+    pkt << uint8(0);                                        // number of keys
+    pkt << uint8(0);                                        // security flags
+
+    sentUs = NowMicros();
+    uint8 proof[REALM_PROOF_SIZE];
+    if (!SendExact(realm, pkt) || !RecvExact(realm, proof, 2))
+    {
+        realm.close();
+        m_error = "no logon proof reply";
+        return false;
+    }
+
+    if (proof[1] != WOW_SUCCESS || !RecvExact(realm, proof + 2, REALM_PROOF_SIZE - 2))
+    {
+        realm.close();
+        m_error = "logon proof refused";
+        return false;
+    }
+
+    m_stats.Add("AUTH_LOGON_PROOF", uint32(NowMicros() - sentUs));
+
+    Sha1Hash M2;
+    BigNumber clientA;
+    clientA.SetBinary(pkt.contents() + 1, 32);
+    BigNumber clientM;
+    clientM.SetBinary(pkt.contents() + 33, 20);
+    M2.UpdateBigNumbers(&clientA, &clientM, &K, NULL);
+    M2.Finalize();
+
+    if (memcmp(M2.GetDigest(), proof + 2, 20))
+    {
+        realm.close();
+        m_error = "server proof mismatch";
+        return false;
+    }
+
+    pkt.clear();
+    pkt << uint8(CMD_REALM_LIST);
+    pkt << uint32(0);
+
+    sentUs = NowMicros();
+    uint8 listHead[3];
+    if (!SendExact(realm, pkt) || !RecvExact(realm, listHead, sizeof(listHead)))
+    {
+        realm.close();
+        m_error = "no realm list";
+        return false;
+    }
+
+    uint16 listSize = listHead[1] | (listHead[2] << 8);
+    ByteBuffer list;
+    list.resize(listSize);
+    if (!listSize || !RecvExact(realm, const_cast<uint8*>(list.contents()), listSize))
+    {
+        realm.close();
+        m_error = "short realm list";
+        return false;
+    }
+
+    m_stats.Add("REALM_LIST", uint32(NowMicros() - sentUs));
+    realm.close();
+
+    try
+    {
+        uint16 realmCount;
+        list.read_skip<uint32>();
+        list >> realmCount;
+        if (!realmCount)
+        {
+            m_error = "empty realm list";
+            return false;
+        }
+
+        std::string name;
+        list.read_skip<uint8>();                            // icon
+        list.read_skip<uint8>();                            // lock
+        list.read_skip<uint8>();                            // flags
+        list >> name;
+        list >> worldAddress;
+    }
+    catch (ByteBufferException&)
+    {
+        m_error = "malformed realm list";
+        return false;
+    }
+
+    return true;
+}
+
+bool BotSession::ConnectWorld(std::string const& address)
+{
+    ACE_INET_Addr addr(address.c_str());
+    ACE_SOCK_Connector connector;
+    ACE_Time_Value timeout(CONNECT_TIMEOUT);
+
+    if (connector.connect(m_peer, addr, &timeout) == -1)
+    {
+        m_error = "world connect failed";
+        return false;
+    }
+
+    int nodelay = 1;
+    m_peer.set_option(ACE_IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    m_peer.enable(ACE_NONBLOCK);
+    return true;
+}
+
+ACE_HANDLE BotSession::get_handle() const
+{
+    return m_peer.get_handle();
+}
+
+int BotSession::handle_input(ACE_HANDLE)
+{
+    uint8 buf[4096];
+
+    for (;;)
+    {
+        ssize_t n = m_peer.recv(buf, sizeof(buf));
+        if (n > 0)
+        {
+            m_recvBuffer.insert(m_recvBuffer.end(), buf, buf + n);
+            continue;
+        }
+
+        if (n == 0)
+        {
+            if (m_error.empty())
+            {
+                m_error = "closed by server";
+            }
+            return -1;
+        }
+
+        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        {
+            break;
+        }
+
+        if (m_error.empty())
+        {
+            m_error = "world socket error";
+        }
+        return -1;
+    }
+
+    return ReadPackets() ? 0 : -1;
+}
+
+int BotSession::handle_close(ACE_HANDLE, ACE_Reactor_Mask)
+{
+    m_peer.close();
+    m_pending.clear();
+    m_state = BOT_STATE_CLOSED;
+    return 0;
+}
+
+bool BotSession::ReadPackets()
+{
+    size_t offset = 0;
+
+    while (m_state != BOT_STATE_CLOSED && offset < m_recvBuffer.size())
+    {
+        uint8* header = &m_recvBuffer[offset];
+        size_t available = m_recvBuffer.size() - offset;
+
+        // the first header byte tells whether the size takes two or three bytes
+        if (m_crypt.IsInitialized() && m_headerDecrypted == 0)
+        {
+            m_crypt.DecryptRecv(header, 1);
+            m_headerDecrypted = 1;
+        }
+
+        size_t headerSize = (header[0] & 0x80) ? 5 : 4;
+        if (available < headerSize)
+        {
+            break;
+        }
+
+        if (m_crypt.IsInitialized() && m_headerDecrypted < headerSize)
+        {
+            m_crypt.DecryptRecv(header + m_headerDecrypted, headerSize - m_headerDecrypted);
+            m_headerDecrypted = headerSize;
+        }
+
+        uint32 size = headerSize == 5
+                      ? ((header[0] & 0x7F) << 16) | (header[1] << 8) | header[2]
+                      : (header[0] << 8) | header[1];
+        uint16 opcode = header[headerSize - 2] | (header[headerSize - 1] << 8);
+
+        if (size < 2)
+        {
+            m_error = "malformed packet header";
+            return false;
+        }
+
+        if (available < headerSize + size - 2)
+        {
+            break;
+        }
+
+        WorldPacket packet(Opcodes(opcode), size - 2);
+        if (size > 2)
+        {
+            packet.append(header + headerSize, size - 2);
+        }
+
+        offset += headerSize + size - 2;
+        m_headerDecrypted = 0;
+
+        try
+        {
+            if (!HandlePacket(packet))
+            {
+                return false;
+            }
+        }
+        catch (ByteBufferException&)
+        {
+            m_error = "malformed packet";
+            return false;
+        }
+    }
+
+    m_recvBuffer.erase(m_recvBuffer.begin(), m_recvBuffer.begin() + offset);
+    return true;
+}
+
+void BotSession::SendPacket(WorldPacket const& packet)
+{
+    if (m_peer.get_handle() == ACE_INVALID_HANDLE)
+    {
+        return;
+    }
+
+    // ClientPktHeader: big endian size including the opcode, 32 bit opcode
+    uint16 size = uint16(packet.size() + 4);
+    uint32 opcode = packet.GetOpcode();
+    uint8 header[6] = { uint8(size >> 8), uint8(size), uint8(opcode), uint8(opcode >> 8), uint8(opcode >> 16), uint8(opcode >> 24) };
+
+    if (m_crypt.IsInitialized())
+    {
+        m_crypt.EncryptSend(header, sizeof(header));
+    }
+
+    iovec iov[2];
+    iov[0].iov_base = reinterpret_cast<char*>(header);
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = reinterpret_cast<char*>(const_cast<uint8*>(packet.contents()));
+    iov[1].iov_len = packet.size();
+
+    if (m_peer.sendv_n(iov, packet.size() ? 2 : 1) == -1)
+    {
+        Fail("world send failed");
+    }
+}
+
+void BotSession::SendRequest(WorldPacket const& packet)
+{
+    m_pending.push_back(PendingRequest(packet.GetOpcode(), NowMicros()));
+    SendPacket(packet);
+}
+
+void BotSession::CompleteRequest(uint16 requestOpcode)
+{
+    for (PendingQueue::iterator itr = m_pending.begin(); itr != m_pending.end(); ++itr)
+    {
+        if (itr->opcode == requestOpcode)
+        {
+            m_stats.Add(RequestName(requestOpcode), uint32(NowMicros() - itr->sentUs));
+            m_pending.erase(itr);
+            return;
+        }
+    }
+}
+
+bool BotSession::HandlePacket(WorldPacket& packet)
+{
+    switch (packet.GetOpcode())
+    {
+        case MSG_WOW_CONNECTION:
+        {
+            WorldPacket data(MSG_WOW_CONNECTION, 48);
+            data << std::string("D OF WARCRAFT CONNECTION - CLIENT TO SERVER");
+            // the greeting goes out with the client header cut in half, it is
+            // the two size bytes followed by "WORL" read as the 32 bit opcode
+            uint8 greeting[] = { 0x00, 0x30, 'W', 'O', 'R', 'L' };
+            iovec iov[2];
+            iov[0].iov_base = reinterpret_cast<char*>(greeting);
+            iov[0].iov_len = sizeof(greeting);
+            iov[1].iov_base = reinterpret_cast<char*>(const_cast<uint8*>(data.contents()));
+            iov[1].iov_len = data.size();
+            if (m_peer.sendv_n(iov, 2) == -1)
+            {
+                m_error = "world send failed";
+                return false;
+            }
+            return true;
+        }
+        case SMSG_AUTH_CHALLENGE:
+            return HandleAuthChallenge(packet);
+        case SMSG_AUTH_RESPONSE:
+            return HandleAuthResponse(packet);
+        case SMSG_CHAR_ENUM:
+            return HandleCharEnum(packet);
+        case SMSG_CHAR_CREATE:
+            return HandleCharCreate(packet);
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(packet);
+            return true;
+        case SMSG_TIME_SYNC_REQ:
+        {
+            uint32 counter;
+            packet >> counter;
+            WorldPacket data(CMSG_TIME_SYNC_RESP, 8);
+            data << uint32(counter);
+            data << uint32(m_nowMs);
+            SendPacket(data);
+            return true;
+        }
+        case SMSG_MESSAGECHAT:
+        {
+            uint8 type;
+            uint32 lang;
+            uint64 sender;
+            packet >> type >> lang >> sender;
+            if (type == CHAT_MSG_SAY && sender == m_guid.GetRawValue())
+            {
+                CompleteRequest(CMSG_MESSAGECHAT_SAY);
+            }
+            return true;
+        }
+        case SMSG_SPELL_GO:
+        {
+            if (packet.readPackGUID() == m_guid.GetRawValue())
+            {
+                CompleteRequest(CMSG_CAST_SPELL);
+            }
+            return true;
+        }
+        case SMSG_CAST_FAILED:
+            CompleteRequest(CMSG_CAST_SPELL);
+            return true;
+        case SMSG_AUCTION_LIST_RESULT:
+            CompleteRequest(CMSG_AUCTION_LIST_ITEMS);
+            return true;
+        case SMSG_PONG:
+            CompleteRequest(CMSG_PING);
+            return true;
+        default:
+            return true;
+    }
+}
+
+bool BotSession::HandleAuthChallenge(WorldPacket& packet)
+{
+    if (m_state != BOT_STATE_AUTH_CHALLENGE)
+    {
+        m_error = "unexpected SMSG_AUTH_CHALLENGE";
+        return false;
+    }
+
+    uint32 serverSeed;
+    packet.read_skip(8 * 4);
+    packet >> serverSeed;
+
+    uint32 clientSeed = uint32(rand32());
+    uint32 t = 0;
+
+    Sha1Hash sha;
+    sha.UpdateData(m_account);
+    sha.UpdateData((uint8*)&t, 4);
+    sha.UpdateData((uint8*)&clientSeed, 4);
+    sha.UpdateData((uint8*)&serverSeed, 4);
+    sha.UpdateBigNumbers(&K, NULL);
+    sha.Finalize();
+    uint8 const* d = sha.GetDigest();
+
+    // same field order WorldSocket::HandleAuthSession reads
+    WorldPacket data(CMSG_AUTH_SESSION, 80 + m_account.size());
+    data << uint32(0) << uint32(0) << uint8(0);
+    data << d[10] << d[18] << d[12] << d[5];
+    data << uint64(0);
+    data << d[15] << d[9] << d[19] << d[4] << d[7] << d[16] << d[3];
+    data << uint16(CLIENT_BUILD);
+    data << d[8];
+    data << uint32(0) << uint8(0);
+    data << d[17] << d[6] << d[0] << d[1] << d[11];
+    data << uint32(clientSeed);
+    data << d[2];
+    data << uint32(0);
+    data << d[14] << d[13];
+    data << uint32(0);                                      // addon data size
+    data.WriteBit(0);
+    data.WriteBits(m_account.size(), 12);
+    data.FlushBits();
+    data.append(m_account.c_str(), m_account.size());
+
+    SendRequest(data);
+
+    // the server switches its crypt on as soon as it accepts the session
+    m_crypt.InitClient(&K);
+    m_state = BOT_STATE_AUTH_RESPONSE;
+    return true;
+}
+
+bool BotSession::HandleAuthResponse(WorldPacket& packet)
+{
+    bool queued = packet.ReadBit();
+    if (queued)
+    {
+        packet.ReadBit();
+    }
+
+    if (packet.ReadBit())
+    {
+        packet.read_skip(4 + 1 + 4 + 1 + 4 + 1);            // expansion and billing fields
+    }
+
+    uint8 code;
+    packet >> code;
+
+    CompleteRequest(CMSG_AUTH_SESSION);
+
+    if (code == AUTH_WAIT_QUEUE)
+    {
+        return true;
+    }
+
+    if (code != AUTH_OK)
+    {
+        m_error = "world auth refused";
+        return false;
+    }
+
+    m_state = BOT_STATE_CHAR_ENUM;
+    SendRequest(WorldPacket(CMSG_CHAR_ENUM, 0));
+    return true;
+}
+
+bool BotSession::HandleCharEnum(WorldPacket& packet)
+{
+    CompleteRequest(CMSG_CHAR_ENUM);
+
+    packet.ReadBits(23);
+    packet.ReadBit();
+    uint32 count = packet.ReadBits(17);
+
+    if (!count)
+    {
+        SendCharCreate();
+        return true;
+    }
+
+    // bit part of every character comes first, see Player::BuildEnumData
+    std::vector<ObjectGuid> guids(count);
+    std::vector<ObjectGuid> guildGuids(count);
+    std::vector<uint32> nameLengths(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        packet.ReadGuidMask<3>(guids[i]);
+        packet.ReadGuidMask<1, 7, 2>(guildGuids[i]);
+        nameLengths[i] = packet.ReadBits(7);
+        packet.ReadGuidMask<4, 7>(guids[i]);
+        packet.ReadGuidMask<3>(guildGuids[i]);
+        packet.ReadGuidMask<5>(guids[i]);
+        packet.ReadGuidMask<6>(guildGuids[i]);
+        packet.ReadGuidMask<1>(guids[i]);
+        packet.ReadGuidMask<5, 4>(guildGuids[i]);
+        packet.ReadBit();                                   // first login
+        packet.ReadGuidMask<0, 2, 6>(guids[i]);
+        packet.ReadGuidMask<0>(guildGuids[i]);
+    }
+
+    // only the first character is played, so only its byte part is read
+    ObjectGuid& guid = guids[0];
+    ObjectGuid& guildGuid = guildGuids[0];
+
+    packet.read_skip<uint8>();                              // class
+    packet.read_skip((19 + 4) * (1 + 4 + 4));               // equipment and bag display
+    packet.read_skip<uint32>();                             // pet family
+    packet.ReadGuidBytes<2>(guildGuid);
+    packet.read_skip<uint8>();                              // order
+    packet.read_skip<uint8>();                              // hair style
+    packet.ReadGuidBytes<3>(guildGuid);
+    packet.read_skip<uint32>();                             // pet display
+    packet.read_skip<uint32>();                             // character flags
+    packet.read_skip<uint8>();                              // hair color
+    packet.ReadGuidBytes<4>(guid);
+    packet.read_skip<uint32>();                             // map
+    packet.ReadGuidBytes<5>(guildGuid);
+    packet.read_skip<float>();                              // z
+    packet.ReadGuidBytes<6>(guildGuid);
+    packet.read_skip<uint32>();                             // pet level
+    packet.ReadGuidBytes<3>(guid);
+    packet.read_skip<float>();                              // y
+    packet.read_skip<uint32>();                             // customize flags
+    packet.read_skip<uint8>();                              // facial hair
+    packet.ReadGuidBytes<7>(guid);
+    packet.read_skip<uint8>();                              // gender
+    packet.read_skip(nameLengths[0]);
+    packet.read_skip<uint8>();                              // face
+    packet.ReadGuidBytes<0, 2>(guid);
+    packet.ReadGuidBytes<1, 7>(guildGuid);
+    packet.read_skip<float>();                              // x
+    packet.read_skip<uint8>();                              // skin
+    packet.read_skip<uint8>();                              // race
+    packet.read_skip<uint8>();                              // level
+    packet.ReadGuidBytes<6>(guid);
+    packet.ReadGuidBytes<4, 0>(guildGuid);
+    packet.ReadGuidBytes<5, 1>(guid);
+
+    m_guid = guid;
+    SendPlayerLogin();
+    return true;
+}
+
+bool BotSession::HandleCharCreate(WorldPacket& packet)
+{
+    uint8 code;
+    packet >> code;
+
+    CompleteRequest(CMSG_CHAR_CREATE);
+
+    if (code != CHAR_CREATE_SUCCESS)
+    {
+        m_error = "character create refused";
+        return false;
+    }
+
+    m_state = BOT_STATE_CHAR_ENUM;
+    SendRequest(WorldPacket(CMSG_CHAR_ENUM, 0));
+    return true;
+}
+
+void BotSession::HandleLoginVerifyWorld(WorldPacket& packet)
+{
+    packet >> m_mapId >> m_x >> m_y >> m_z >> m_o;
+
+    CompleteRequest(CMSG_PLAYER_LOGIN);
+
+    // spread the periodic actions so the bots of one worker do not fire together
+    m_state = BOT_STATE_IN_WORLD;
+    m_legStartMs = m_nowMs;
+    m_nextChatMs = m_nowMs + (m_index * 997) % CHAT_INTERVAL;
+    m_nextCastMs = m_nowMs + (m_index * 1499) % CAST_INTERVAL;
+    m_nextAuctionMs = m_nowMs + (m_index * 2003) % AUCTION_INTERVAL;
+    m_nextPingMs = m_nowMs + (m_index * 3001) % PING_INTERVAL;
+}
+
+void BotSession::SendCharCreate()
+{
+    WorldPacket data(CMSG_CHAR_CREATE, 20);
+    data << CharacterName(m_index);
+    data << uint8(1);                                       // human
+    data << uint8(1);                                       // warrior
+    data << uint8(0);                                       // gender
+    data << uint8(0) << uint8(0) << uint8(0) << uint8(0) << uint8(0);
+    data << uint8(0);                                       // outfit
+
+    m_state = BOT_STATE_CHAR_CREATE;
+    SendRequest(data);
+}
+
+void BotSession::SendPlayerLogin()
+{
+    WorldPacket data(CMSG_PLAYER_LOGIN, 9);
+    data.WriteGuidMask<2, 3, 0, 6, 4, 5, 1, 7>(m_guid);
+    data.WriteGuidBytes<2, 7, 0, 3, 5, 6, 1, 4>(m_guid);
+
+    m_state = BOT_STATE_LOGIN;
+    SendRequest(data);
+}
+
+void BotSession::Update(uint32 nowMs)
+{
+    m_nowMs = nowMs;
+
+    if (m_state == BOT_STATE_CLOSED)
+    {
+        return;
+    }
+
+    uint64 expireUs = NowMicros() - uint64(m_config.requestTimeout) * 1000;
+    while (!m_pending.empty() && m_pending.front().sentUs < expireUs)
+    {
+        m_stats.AddTimeout(RequestName(m_pending.front().opcode));
+        m_pending.pop_front();
+    }
+
+    if (m_state != BOT_STATE_IN_WORLD)
+    {
+        return;
+    }
+
+    UpdateMovement(nowMs);
+
+    if (nowMs >= m_nextChatMs)
+    {
+        SendChat();
+        m_nextChatMs = nowMs + CHAT_INTERVAL;
+    }
+
+    if (m_config.spellId && nowMs >= m_nextCastMs)
+    {
+        SendCastSpell();
+        m_nextCastMs = nowMs + CAST_INTERVAL;
+    }
+
+    if (m_config.auctioneer && nowMs >= m_nextAuctionMs)
+    {
+        SendAuctionList();
+        m_nextAuctionMs = nowMs + AUCTION_INTERVAL;
+    }
+
+    if (nowMs >= m_nextPingMs)
+    {
+        SendPing();
+        m_nextPingMs = nowMs + PING_INTERVAL;
+    }
+}
+
+void BotSession::UpdateMovement(uint32 nowMs)
+{
+    if (!m_moving)
+    {
+        if (nowMs - m_legStartMs >= PAUSE_DURATION)
+        {
+            m_moving = true;
+            m_legStartMs = nowMs;
+            m_lastMoveMs = nowMs;
+            SendMovement(CMSG_MOVE_START_FORWARD);
+        }
+        return;
+    }
+
+    if (nowMs - m_lastMoveMs < HEARTBEAT_INTERVAL && nowMs - m_legStartMs < WALK_DURATION)
+    {
+        return;
+    }
+
+    float distance = BOT_RUN_SPEED * (nowMs - m_lastMoveMs) / 1000.0f;
+    m_x += distance * cos(m_o);
+    m_y += distance * sin(m_o);
+    m_lastMoveMs = nowMs;
+
+    if (nowMs - m_legStartMs < WALK_DURATION)
+    {
+        SendMovement(MSG_MOVE_HEARTBEAT);
+        return;
+    }
+
+    // end of the leg, stop and turn around for the walk back
+    m_moving = false;
+    m_legStartMs = nowMs;
+    SendMovement(CMSG_MOVE_STOP);
+
+    m_o += M_PI_F;
+    if (m_o > 2 * M_PI_F)
+    {
+        m_o -= 2 * M_PI_F;
+    }
+    SendMovement(CMSG_MOVE_SET_FACING);
+}
+
+void BotSession::SendMovement(uint16 opcode)
+{
+    MovementStatusElements* sequence = GetMovementStatusElementsSequence(opcode);
+    if (!sequence)
+    {
+        return;
+    }
+
+    // mirrors MovementInfo::Write for a unit that is not on a transport, not falling and not following a spline
+    uint32 moveFlags = m_moving ? BOT_MOVEFLAG_FORWARD : 0;
+    WorldPacket data(Opcodes(opcode), 64);
+
+    for (uint32 i = 0; i < MSE_COUNT; ++i)
+    {
+        MovementStatusElements element = sequence[i];
+
+        if (element == MSEEnd)
+        {
+            break;
+        }
+
+        if (element >= MSEGuidBit0 && element <= MSEGuidBit7)
+        {
+            data.WriteBit(m_guid[element - MSEGuidBit0]);
+            continue;
+        }
+
+        if (element >= MSEGuidByte0 && element <= MSEGuidByte7)
+        {
+            if (m_guid[element - MSEGuidByte0])
+            {
+                data << uint8(m_guid[element - MSEGuidByte0] ^ 1);
+            }
+            continue;
+        }
+
+        switch (element)
+        {
+            case MSEHasMovementFlags:
+                data.WriteBit(!moveFlags);
+                break;
+            case MSEHasMovementFlags2:
+                data.WriteBit(true);
+                break;
+            case MSEFlags:
+                if (moveFlags)
+                {
+                    data.WriteBits(moveFlags, 30);
+                }
+                break;
+            case MSETimestamp:
+                data << uint32(m_nowMs);
+                break;
+            case MSEHasPitch:
+            case MSEHasSplineElevation:
+                data.WriteBit(true);
+                break;
+            case MSEHasTimestamp:
+            case MSEHasOrientation:
+            case MSEHasUnknownBit:
+            case MSEHasFallData:
+            case MSEHasTransportData:
+            case MSEHasSpline:
+                data.WriteBit(false);
+                break;
+            case MSEPositionX:
+                data << float(m_x);
+                break;
+            case MSEPositionY:
+                data << float(m_y);
+                break;
+            case MSEPositionZ:
+                data << float(m_z);
+                break;
+            case MSEPositionO:
+                data << float(m_o);
+                break;
+            case MSEMovementCounter:
+                data << uint32(0);
+                break;
+            default:
+                // transport, fall, pitch and spline fields are absent for a bot walking on the ground
+                break;
+        }
+    }
+
+    SendPacket(data);
+}
+
+void BotSession::SendChat()
+{
+    std::string text = "load test message";
+
+    WorldPacket data(CMSG_MESSAGECHAT_SAY, 4 + 2 + text.size());
+    data << uint32(LANG_COMMON);
+    data.WriteBits(text.size(), 9);
+    data.FlushBits();
+    data.append(text.c_str(), text.size());
+
+    SendRequest(data);
+}
+
+void BotSession::SendCastSpell()
+{
+    WorldPacket data(CMSG_CAST_SPELL, 14);
+    data << uint8(++m_castCount);
+    data << uint32(m_config.spellId);
+    data << uint32(0);                                      // glyph index
+    data << uint8(0);                                       // cast flags
+    data << uint32(0);                                      // target mask, self
+
+    SendRequest(data);
+}
+
+void BotSession::SendAuctionList()
+{
+    WorldPacket data(CMSG_AUCTION_LIST_ITEMS, 40);
+    data << uint64(m_config.auctioneer);
+    data << uint32(0);                                      // list from
+    data << std::string();                                  // searched name
+    data << uint8(0) << uint8(0);                           // level range
+    data << uint32(0xFFFFFFFF);                             // slot
+    data << uint32(0xFFFFFFFF);                             // main category
+    data << uint32(0xFFFFFFFF);                             // sub category
+    data << uint32(0xFFFFFFFF);                             // quality
+    data << uint8(0) << uint8(0) << uint8(0);               // usable, full list, unk
+    data << uint8(0);                                       // sort count
+
+    SendRequest(data);
+}
+
+void BotSession::SendPing()
+{
+    WorldPacket data(CMSG_PING, 8);
+    data << uint32(++m_pingCounter);
+    data << uint32(0);                                      // latency
+
+    SendRequest(data);
+}
@@ -0,0 +1,233 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef MANGOS_H_BOTSESSION
+#define MANGOS_H_BOTSESSION
+
+#include "Common.h"
+#include "Auth/AuthCrypt.h"
+#include "Auth/BigNumber.h"
+#include "ObjectGuid.h"
+#include "WorldPacket.h"
+
+#include <ace/Event_Handler.h>
+#include <ace/SOCK_Stream.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+class LatencyStats;
+
+/**
+ * @brief Settings shared by every bot of a run
+ *
+ */
+struct BotConfig
+{
+    BotConfig() : realmPort(3724), spellId(0), auctioneer(0), requestTimeout(10000) {}
+
+    std::string realmHost; /**< TODO */
+    uint16 realmPort; /**< TODO */
+    std::string worldAddress; /**< "host:port", empty to use the first realm of the realm list */
+    std::string password; /**< empty when every account uses its own name as password */
+    uint32 spellId; /**< spell cast on self by the bots, 0 to skip casting */
+    uint64 auctioneer; /**< auctioneer guid used for browsing, 0 to skip the auction house */
+    uint32 requestTimeout; /**< ms before an unanswered request counts as a timeout */
+};
+
+/**
+ * @brief One headless client: logs on to realmd, enters the world and plays a short script
+ *
+ * The realm logon is done with blocking reads, everything after it runs on the
+ * reactor of the worker that owns the session. Update() must be called from
+ * that same worker, the session is never touched by two threads.
+ */
+class BotSession : public ACE_Event_Handler
+{
+    public:
+        /**
+         * @brief
+         *
+         */
+        enum State
+        {
+            BOT_STATE_NEW,
+            BOT_STATE_AUTH_CHALLENGE,                           // waiting for SMSG_AUTH_CHALLENGE
+            BOT_STATE_AUTH_RESPONSE,                            // waiting for SMSG_AUTH_RESPONSE
+            BOT_STATE_CHAR_ENUM,
+            BOT_STATE_CHAR_CREATE,
+            BOT_STATE_LOGIN,                                    // waiting for SMSG_LOGIN_VERIFY_WORLD
+            BOT_STATE_IN_WORLD,
+            BOT_STATE_CLOSED
+        };
+
+        /**
+         * @brief
+         *
+         * @param config
+         * @param index account number, the account is named <prefix><index>
+         * @param account
+         * @param stats latency samples of the owning worker
+         */
+        BotSession(BotConfig const& config, uint32 index, std::string const& account, LatencyStats& stats);
+        /**
+         * @brief
+         *
+         */
+        ~BotSession();
+
+        /**
+         * @brief Log on to realmd, connect to the world server and register with the reactor
+         *
+         * @param reactor
+         * @return bool false if the session is already closed
+         */
+        bool Open(ACE_Reactor* reactor);
+        /**
+         * @brief Drop the world connection
+         *
+         */
+        void Close();
+        /**
+         * @brief Run the scripted actions that are due and expire old requests
+         *
+         * @param nowMs milliseconds since the start of the run
+         */
+        void Update(uint32 nowMs);
+
+        /**
+         * @brief
+         *
+         * @return State
+         */
+        State GetState() const { return m_state; }
+
+        /**
+         * @brief Why the session was closed, empty while it is running
+         *
+         * @return std::string
+         */
+        std::string const& GetError() const { return m_error; }
+
+        /**
+         * @brief
+         *
+         * @return ACE_HANDLE
+         */
+        ACE_HANDLE get_handle() const override;
+        /**
+         * @brief
+         *
+         * @param
+         * @return int
+         */
+        int handle_input(ACE_HANDLE = ACE_INVALID_HANDLE) override;
+        /**
+         * @brief
+         *
+         * @param
+         * @param
+         * @return int
+         */
+        int handle_close(ACE_HANDLE = ACE_INVALID_HANDLE, ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK) override;
+
+    private:
+        /**
+         * @brief A request sent to the server that still waits for its answer
+         *
+         */
+        struct PendingRequest
+        {
+            PendingRequest(uint16 opcode, uint64 sentUs) : opcode(opcode), sentUs(sentUs) {}
+
+            uint16 opcode; /**< TODO */
+            uint64 sentUs; /**< TODO */
+        };
+
+        typedef std::deque<PendingRequest> PendingQueue;
+
+        void Fail(char const* reason);
+        bool RealmLogon(std::string& worldAddress);
+        bool ConnectWorld(std::string const& address);
+
+        void SendPacket(WorldPacket const& packet);
+        void SendRequest(WorldPacket const& packet);
+        void CompleteRequest(uint16 requestOpcode);
+        bool ReadPackets();
+        bool HandlePacket(WorldPacket& packet);
+
+        bool HandleAuthChallenge(WorldPacket& packet);
+        bool HandleAuthResponse(WorldPacket& packet);
+        bool HandleCharEnum(WorldPacket& packet);
+        bool HandleCharCreate(WorldPacket& packet);
+        void HandleLoginVerifyWorld(WorldPacket& packet);
+
+        void SendCharCreate();
+        void SendPlayerLogin();
+        void SendMovement(uint16 opcode);
+        void SendChat();
+        void SendCastSpell();
+        void SendAuctionList();
+        void SendPing();
+        void UpdateMovement(uint32 nowMs);
+
+        BotConfig const& m_config; /**< TODO */
+        uint32 m_index; /**< TODO */
+        std::string m_account; /**< upper case, as realmd stores it */
+        LatencyStats& m_stats; /**< TODO */
+        State m_state; /**< TODO */
+        std::string m_error; /**< TODO */
+
+        ACE_SOCK_Stream m_peer; /**< world connection, realmd is only used during Open() */
+        BigNumber K; /**< session key from the realm logon */
+        AuthCrypt m_crypt; /**< TODO */
+        std::vector<uint8> m_recvBuffer; /**< bytes read but not parsed yet */
+        size_t m_headerDecrypted; /**< bytes of the next header already run through m_crypt */
+
+        ObjectGuid m_guid; /**< TODO */
+        uint32 m_mapId; /**< TODO */
+        float m_x, m_y, m_z, m_o; /**< TODO */
+        bool m_moving; /**< TODO */
+        uint32 m_legStartMs; /**< when the current walk or pause started */
+        uint32 m_lastMoveMs; /**< TODO */
+
+        uint32 m_nextChatMs; /**< TODO */
+        uint32 m_nextCastMs; /**< TODO */
+        uint32 m_nextAuctionMs; /**< TODO */
+        uint32 m_nextPingMs; /**< TODO */
+        uint8 m_castCount; /**< TODO */
+        uint32 m_pingCounter; /**< TODO */
+        uint32 m_nowMs; /**< time of the last Update() */
+
+        PendingQueue m_pending; /**< requests in send order */
+};
+
+#endif
+/// @}
@@ -0,0 +1,88 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup loadbot
+*/
+
+#include "BotStats.h"
+
+#include <algorithm>
+
+namespace
+{
+    /**
+     * @brief Nearest rank percentile of an already sorted sample set
+     *
+     * @param sorted
+     * @param percent
+     * @return uint32
+     */
+    uint32 Percentile(std::vector<uint32> const& sorted, uint32 percent)
+    {
+        if (sorted.empty())
+        {
+            return 0;
+        }
+
+        size_t rank = (sorted.size() * percent + 99) / 100;
+        return sorted[rank ? rank - 1 : 0];
+    }
+}
+
+void LatencyStats::Add(std::string const& name, uint32 micros)
+{
+    m_samples[name].micros.push_back(micros);
+}
+
+void LatencyStats::AddTimeout(std::string const& name)
+{
+    ++m_samples[name].timeouts;
+}
+
+void LatencyStats::Merge(LatencyStats const& other)
+{
+    for (SamplesMap::const_iterator itr = other.m_samples.begin(); itr != other.m_samples.end(); ++itr)
+    {
+        Samples& samples = m_samples[itr->first];
+        samples.micros.insert(samples.micros.end(), itr->second.micros.begin(), itr->second.micros.end());
+        samples.timeouts += itr->second.timeouts;
+    }
+}
+
+void LatencyStats::Report(FILE* out) const
+{
+    fprintf(out, "%-28s %9s %8s %10s %10s %10s %10s\n", "request", "count", "timeout", "p50 ms", "p90 ms", "p99 ms", "max ms");
+
+    for (SamplesMap::const_iterator itr = m_samples.begin(); itr != m_samples.end(); ++itr)
+    {
+        std::vector<uint32> sorted = itr->second.micros;
+        std::sort(sorted.begin(), sorted.end());
+
+        fprintf(out, "%-28s %9u %8u %10.2f %10.2f %10.2f %10.2f\n", itr->first.c_str(),
+                uint32(sorted.size()), itr->second.timeouts,
+                Percentile(sorted, 50) / 1000.0, Percentile(sorted, 90) / 1000.0,
+                Percentile(sorted, 99) / 1000.0, (sorted.empty() ? 0 : sorted.back()) / 1000.0);
+    }
+}
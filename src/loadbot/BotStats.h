@@ -0,0 +1,96 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef MANGOS_H_BOTSTATS
+#define MANGOS_H_BOTSTATS
+
+#include "Common.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Round trip times of the requests sent by the bots, keyed by request name
+ *
+ * Every worker thread fills its own instance, they are merged once the run is over
+ * so recording a sample never takes a lock.
+ */
+class LatencyStats
+{
+    public:
+        /**
+         * @brief Record one answered request
+         *
+         * @param name request name, usually the opcode name
+         * @param micros time between sending the request and reading the answer
+         */
+        void Add(std::string const& name, uint32 micros);
+
+        /**
+         * @brief Record a request that did not get an answer in time
+         *
+         * @param name
+         */
+        void AddTimeout(std::string const& name);
+
+        /**
+         * @brief Add the samples of another worker to this one
+         *
+         * @param other
+         */
+        void Merge(LatencyStats const& other);
+
+        /**
+         * @brief Print count, timeouts and p50/p90/p99/max per request
+         *
+         * @param out
+         */
+        void Report(FILE* out) const;
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        struct Samples
+        {
+            Samples() : timeouts(0) {}
+
+            std::vector<uint32> micros; /**< TODO */
+            uint32 timeouts; /**< TODO */
+        };
+
+        typedef std::map<std::string, Samples> SamplesMap;
+
+        SamplesMap m_samples; /**< TODO */
+};
+
+#endif
+/// @}
@@ -0,0 +1,348 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup loadbot
+    \brief Load test driver: runs many headless bot sessions against a realmd and mangosd pair.
+
+    The accounts <prefix>1 .. <prefix>N must exist, by default the password of
+    each account is its own name. A character is created for accounts that have
+    none. Sessions are spread over worker threads, each worker owns a reactor
+    and opens its share of the sessions at the configured ramp rate.
+
+    Once the duration is over the round trip times of every request type are
+    printed as percentiles, followed by the reasons sessions were dropped.
+*/
+
+#include "Common.h"
+#include "BotSession.h"
+#include "BotStats.h"
+
+#include <ace/ACE.h>
+#include <ace/Dev_Poll_Reactor.h>
+#include <ace/Get_Opt.h>
+#include <ace/Reactor.h>
+#include <ace/Select_Reactor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const uint32 UPDATE_INTERVAL = 100;                     // ms between two script updates of a worker
+    const uint32 STATUS_INTERVAL = 5;                       // seconds between two progress lines
+
+    /**
+     * @brief Run settings taken from the command line
+     *
+     */
+    struct RunOptions
+    {
+        RunOptions() : sessions(100), accountPrefix("BOT"), threads(4), rampPerSecond(50), duration(60) {}
+
+        uint32 sessions; /**< TODO */
+        std::string accountPrefix; /**< TODO */
+        uint32 threads; /**< TODO */
+        uint32 rampPerSecond; /**< TODO */
+        uint32 duration; /**< seconds, counted from the start of the run */
+    };
+
+    /**
+     * @brief One thread with its own reactor and every n-th session of the run
+     *
+     */
+    class BotWorker
+    {
+        public:
+            BotWorker(BotConfig const& config, RunOptions const& options, uint32 id)
+                : m_config(config), m_options(options), m_id(id), m_inWorld(0), m_closed(0)
+            {
+            }
+
+            ~BotWorker()
+            {
+                for (size_t i = 0; i < m_sessions.size(); ++i)
+                {
+                    delete m_sessions[i];
+                }
+            }
+
+            void Run()
+            {
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+                ACE_Reactor reactor(new ACE_Dev_Poll_Reactor(ACE::max_handles(), 1), 1);
+#else
+                ACE_Reactor reactor(new ACE_Select_Reactor(), 1);
+#endif
+
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                uint32 durationMs = m_options.duration * 1000;
+                uint32 lastUpdateMs = 0;
+
+                for (;;)
+                {
+                    uint32 nowMs = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+                    if (nowMs >= durationMs)
+                    {
+                        break;
+                    }
+
+                    // open sessions at this worker's share of the ramp rate, the realm logon blocks
+                    uint64 due = uint64(nowMs) * m_options.rampPerSecond / 1000 + 1;
+                    uint32 index = m_id + 1 + uint32(m_sessions.size()) * m_options.threads;
+                    while (index <= m_options.sessions && m_sessions.size() * m_options.threads + m_id < due)
+                    {
+                        char account[64];
+                        snprintf(account, sizeof(account), "%s%u", m_options.accountPrefix.c_str(), index);
+
+                        BotSession* session = new BotSession(m_config, index, account, m_stats);
+                        session->Open(&reactor);
+                        m_sessions.push_back(session);
+
+                        index += m_options.threads;
+                    }
+
+                    ACE_Time_Value timeout(0, 10000);
+                    reactor.handle_events(timeout);
+
+                    if (nowMs - lastUpdateMs >= UPDATE_INTERVAL)
+                    {
+                        lastUpdateMs = nowMs;
+                        UpdateSessions(nowMs);
+                    }
+                }
+
+                for (size_t i = 0; i < m_sessions.size(); ++i)
+                {
+                    if (m_sessions[i]->GetState() != BotSession::BOT_STATE_CLOSED)
+                    {
+                        m_sessions[i]->Close();
+                    }
+                    else
+                    {
+                        ++m_errors[m_sessions[i]->GetError()];
+                    }
+                }
+            }
+
+            LatencyStats const& GetStats() const { return m_stats; }
+            std::map<std::string, uint32> const& GetErrors() const { return m_errors; }
+            uint32 GetInWorld() const { return m_inWorld; }
+            uint32 GetClosed() const { return m_closed; }
+
+        private:
+            void UpdateSessions(uint32 nowMs)
+            {
+                uint32 inWorld = 0;
+                uint32 closed = 0;
+
+                for (size_t i = 0; i < m_sessions.size(); ++i)
+                {
+                    BotSession* session = m_sessions[i];
+                    session->Update(nowMs);
+
+                    if (session->GetState() == BotSession::BOT_STATE_IN_WORLD)
+                    {
+                        ++inWorld;
+                    }
+                    else if (session->GetState() == BotSession::BOT_STATE_CLOSED)
+                    {
+                        ++closed;
+                    }
+                }
+
+                m_inWorld = inWorld;
+                m_closed = closed;
+            }
+
+            BotConfig const& m_config; /**< TODO */
+            RunOptions const& m_options; /**< TODO */
+            uint32 m_id; /**< TODO */
+            std::vector<BotSession*> m_sessions; /**< TODO */
+            LatencyStats m_stats; /**< TODO */
+            std::map<std::string, uint32> m_errors; /**< close reason and number of sessions */
+            std::atomic<uint32> m_inWorld; /**< read by the main thread for the progress line */
+            std::atomic<uint32> m_closed; /**< TODO */
+    };
+
+    void usage(char const* prog)
+    {
+        printf("Usage: %s [<options>]\n"
+               "    -r host:port    realmd address (default 127.0.0.1:3724)\n"
+               "    -w host:port    world server address, overrides the realm list\n"
+               "    -n sessions     number of bots (default 100)\n"
+               "    -a prefix       account name prefix, bots use <prefix>1 .. <prefix>N (default BOT)\n"
+               "    -p password     password of every bot account (default: the account name)\n"
+               "    -t threads      worker threads (default 4)\n"
+               "    -R rate         sessions opened per second (default 50)\n"
+               "    -d seconds      length of the run (default 60)\n"
+               "    -s spell        spell id cast on self every 20s (default off)\n"
+               "    -A guid         auctioneer guid browsed every 30s (default off)\n",
+               prog);
+    }
+
+    bool ParseAddress(char const* arg, std::string& host, uint16& port)
+    {
+        std::string address = arg;
+        std::string::size_type colon = address.rfind(':');
+        if (colon == std::string::npos)
+        {
+            host = address;
+            return true;
+        }
+
+        host = address.substr(0, colon);
+        port = uint16(atoi(address.c_str() + colon + 1));
+        return port != 0;
+    }
+}
+
+/// Run the bots and print the latency report
+extern int main(int argc, char** argv)
+{
+    BotConfig config;
+    config.realmHost = "127.0.0.1";
+    RunOptions options;
+
+    ACE_Get_Opt cmd_opts(argc, argv, ":r:w:n:a:p:t:R:d:s:A:h");
+
+    int option;
+    while ((option = cmd_opts()) != EOF)
+    {
+        switch (option)
+        {
+            case 'r':
+                if (!ParseAddress(cmd_opts.opt_arg(), config.realmHost, config.realmPort))
+                {
+                    printf("Invalid realmd address %s\n", cmd_opts.opt_arg());
+                    return 1;
+                }
+                break;
+            case 'w':
+                config.worldAddress = cmd_opts.opt_arg();
+                break;
+            case 'n':
+                options.sessions = uint32(atoi(cmd_opts.opt_arg()));
+                break;
+            case 'a':
+                options.accountPrefix = cmd_opts.opt_arg();
+                break;
+            case 'p':
+                config.password = cmd_opts.opt_arg();
+                break;
+            case 't':
+                options.threads = std::max(1, atoi(cmd_opts.opt_arg()));
+                break;
+            case 'R':
+                options.rampPerSecond = std::max(1, atoi(cmd_opts.opt_arg()));
+                break;
+            case 'd':
+                options.duration = uint32(atoi(cmd_opts.opt_arg()));
+                break;
+            case 's':
+                config.spellId = uint32(atoi(cmd_opts.opt_arg()));
+                break;
+            case 'A':
+                config.auctioneer = strtoull(cmd_opts.opt_arg(), NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return option == 'h' ? 0 : 1;
+        }
+    }
+
+    // the ramp rate is split evenly, every worker opens its own share
+    options.rampPerSecond = std::max(options.rampPerSecond / options.threads, 1u) * options.threads;
+
+    printf("%u sessions on %u threads, %u per second, %u seconds against %s:%u\n", options.sessions, options.threads,
+           options.rampPerSecond, options.duration, config.realmHost.c_str(), config.realmPort);
+
+    std::vector<BotWorker*> workers;
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < options.threads; ++i)
+    {
+        workers.push_back(new BotWorker(config, options, i));
+    }
+
+    for (uint32 i = 0; i < options.threads; ++i)
+    {
+        threads.push_back(std::thread(&BotWorker::Run, workers[i]));
+    }
+
+    for (uint32 elapsed = STATUS_INTERVAL; elapsed < options.duration; elapsed += STATUS_INTERVAL)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(STATUS_INTERVAL));
+
+        uint32 inWorld = 0;
+        uint32 closed = 0;
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            inWorld += workers[i]->GetInWorld();
+            closed += workers[i]->GetClosed();
+        }
+
+        printf("%5us: %u in world, %u closed\n", elapsed, inWorld, closed);
+        fflush(stdout);
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+
+    LatencyStats total;
+    std::map<std::string, uint32> errors;
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        total.Merge(workers[i]->GetStats());
+
+        std::map<std::string, uint32> const& workerErrors = workers[i]->GetErrors();
+        for (std::map<std::string, uint32>::const_iterator itr = workerErrors.begin(); itr != workerErrors.end(); ++itr)
+        {
+            errors[itr->first] += itr->second;
+        }
+
+        delete workers[i];
+    }
+
+    printf("\n");
+    total.Report(stdout);
+
+    if (!errors.empty())
+    {
+        printf("\nclosed sessions:\n");
+        for (std::map<std::string, uint32>::const_iterator itr = errors.begin(); itr != errors.end(); ++itr)
+        {
+            printf("%8u  %s\n", itr->second, itr->first.c_str());
+        }
+    }
+
+    return 0;
+}
@@ -48,13 +48,13 @@ struct ElunaCreatureAI : ScriptedAI
         {
             for (auto& point : movepoints)
             {
-                if (!sEluna->MovementInform(me, point.first, point.second))
+                if (!me->GetEluna()->MovementInform(me, point.first, point.second))
                     ScriptedAI::MovementInform(point.first, point.second);
             }
             movepoints.clear();
         }
 
-        if (!sEluna->UpdateAI(me, diff))
+        if (!me->GetEluna()->UpdateAI(me, diff))
         {
 #ifdef TRINITY
             if (!me->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_NPC))
@@ -70,42 +70,42 @@ struct ElunaCreatureAI : ScriptedAI
     //Called at creature aggro either by MoveInLOS or Attack Start
     void EnterCombat(Unit* target) override
     {
-        if (!sEluna->EnterCombat(me, target))
+        if (!me->GetEluna()->EnterCombat(me, target))
             ScriptedAI::EnterCombat(target);
     }
 
     // Called at any Damage from any attacker (before damage apply)
     void DamageTaken(Unit* attacker, uint32& damage) override
     {
-        if (!sEluna->DamageTaken(me, attacker, damage))
+        if (!me->GetEluna()->DamageTaken(me, attacker, damage))
             ScriptedAI::DamageTaken(attacker, damage);
     }
 
     //Called at creature death
     void JustDied(Unit* killer) override
     {
-        if (!sEluna->JustDied(me, killer))
+        if (!me->GetEluna()->JustDied(me, killer))
             ScriptedAI::JustDied(killer);
     }
 
     //Called at creature killing another unit
     void KilledUnit(Unit* victim) override
     {
-        if (!sEluna->KilledUnit(me, victim))
+        if (!me->GetEluna()->KilledUnit(me, victim))
             ScriptedAI::KilledUnit(victim);
     }
 
     // Called when the creature summon successfully other creature
     void JustSummoned(Creature* summon) override
     {
-        if (!sEluna->JustSummoned(me, summon))
+        if (!me->GetEluna()->JustSummoned(me, summon))
             ScriptedAI::JustSummoned(summon);
     }
 
     // Called when a summoned creature is despawned
     void SummonedCreatureDespawn(Creature* summon) override
     {
-        if (!sEluna->SummonedCreatureDespawn(me, summon))
+        if (!me->GetEluna()->SummonedCreatureDespawn(me, summon))
             ScriptedAI::SummonedCreatureDespawn(summon);
     }
 
@@ -120,7 +120,7 @@ struct ElunaCreatureAI : ScriptedAI
     // Called before EnterCombat even before the creature is in combat.
     void AttackStart(Unit* target) override
     {
-        if (!sEluna->AttackStart(me, target))
+        if (!me->GetEluna()->AttackStart(me, target))
             ScriptedAI::AttackStart(target);
     }
 
@@ -128,14 +128,14 @@ struct ElunaCreatureAI : ScriptedAI
     // Called for reaction at stopping attack at no attackers or targets
     void EnterEvadeMode(EvadeReason /*why*/) override
     {
-        if (!sEluna->EnterEvadeMode(me))
+        if (!me->GetEluna()->EnterEvadeMode(me))
             ScriptedAI::EnterEvadeMode();
     }
 #else
     // Called for reaction at stopping attack at no attackers or targets
     void EnterEvadeMode() override
     {
-        if (!sEluna->EnterEvadeMode(me))
+        if (!me->GetEluna()->EnterEvadeMode(me))
             ScriptedAI::EnterEvadeMode();
     }
 #endif
@@ -143,28 +143,28 @@ struct ElunaCreatureAI : ScriptedAI
     // Called when creature is spawned or respawned (for reseting variables)
     void JustRespawned() override
     {
-        if (!sEluna->JustRespawned(me))
+        if (!me->GetEluna()->JustRespawned(me))
             ScriptedAI::JustRespawned();
     }
 
     // Called at reaching home after evade
     void JustReachedHome() override
     {
-        if (!sEluna->JustReachedHome(me))
+        if (!me->GetEluna()->JustReachedHome(me))
             ScriptedAI::JustReachedHome();
     }
 
     // Called at text emote receive from player
     void ReceiveEmote(Player* player, uint32 emoteId) override
     {
-        if (!sEluna->ReceiveEmote(me, player, emoteId))
+        if (!me->GetEluna()->ReceiveEmote(me, player, emoteId))
             ScriptedAI::ReceiveEmote(player, emoteId);
     }
 
     // called when the corpse of this creature gets removed
     void CorpseRemoved(uint32& respawnDelay) override
     {
-        if (!sEluna->CorpseRemoved(me, respawnDelay))
+        if (!me->GetEluna()->CorpseRemoved(me, respawnDelay))
             ScriptedAI::CorpseRemoved(respawnDelay);
     }
 
@@ -178,21 +178,21 @@ struct ElunaCreatureAI : ScriptedAI
 
     void MoveInLineOfSight(Unit* who) override
     {
-        if (!sEluna->MoveInLineOfSight(me, who))
+        if (!me->GetEluna()->MoveInLineOfSight(me, who))
             ScriptedAI::MoveInLineOfSight(who);
     }
 
     // Called when hit by a spell
     void SpellHit(Unit* caster, SpellInfo const* spell) override
     {
-        if (!sEluna->SpellHit(me, caster, spell))
+        if (!me->GetEluna()->SpellHit(me, caster, spell))
             ScriptedAI::SpellHit(caster, spell);
     }
 
     // Called when spell hits a target
     void SpellHitTarget(Unit* target, SpellInfo const* spell) override
     {
-        if (!sEluna->SpellHitTarget(me, target, spell))
+        if (!me->GetEluna()->SpellHitTarget(me, target, spell))
             ScriptedAI::SpellHitTarget(target, spell);
     }
 
@@ -201,27 +201,27 @@ struct ElunaCreatureAI : ScriptedAI
     // Called when the creature is summoned successfully by other creature
     void IsSummonedBy(Unit* summoner) override
     {
-        if (!sEluna->OnSummoned(me, summoner))
+        if (!me->GetEluna()->OnSummoned(me, summoner))
             ScriptedAI::IsSummonedBy(summoner);
     }
 
     void SummonedCreatureDies(Creature* summon, Unit* killer) override
     {
-        if (!sEluna->SummonedCreatureDies(me, summon, killer))
+        if (!me->GetEluna()->SummonedCreatureDies(me, summon, killer))
             ScriptedAI::SummonedCreatureDies(summon, killer);
     }
 
     // Called when owner takes damage
     void OwnerAttackedBy(Unit* attacker) override
     {
-        if (!sEluna->OwnerAttackedBy(me, attacker))
+        if (!me->GetEluna()->OwnerAttackedBy(me, attacker))
             ScriptedAI::OwnerAttackedBy(attacker);
     }
 
     // Called when owner attacks something
     void OwnerAttacked(Unit* target) override
     {
-        if (!sEluna->OwnerAttacked(me, target))
+        if (!me->GetEluna()->OwnerAttacked(me, target))
             ScriptedAI::OwnerAttacked(target);
     }
 #endif
@@ -8,6 +8,7 @@
 #define GLOBALMETHODS_H
 
 #include "BindingMap.h"
+#include "lmarshal.h"
 
 /***
  * These functions can be used anywhere at any time, including at start-up.
@@ -1203,6 +1204,73 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Returns the [Map] the running Lua state belongs to.
+     *
+     * With `Eluna.MapStates` enabled every map runs the scripts in its own state and
+     * only sees the hooks of its own objects. Returns nil for the global state.
+     *
+     * @return [Map] map
+     */
+    int GetStateMap(lua_State* L)
+    {
+        Eluna::Push(L, Eluna::GetEluna(L)->GetBoundMap());
+        return 1;
+    }
+
+    /**
+     * Stores a value that every Lua state can read with [Global:GetSharedData].
+     *
+     * Lua globals are not shared between map states, this is the channel to pass data between them.
+     * The value is copied, tables are copied deeply. Passing nil removes the key.
+     *
+     * @param string key
+     * @param nil/boolean/number/string/table value
+     */
+    int SetSharedData(lua_State* L)
+    {
+        std::string key = Eluna::CHECKVAL<std::string>(L, 1);
+
+        if (lua_isnoneornil(L, 2))
+        {
+            Eluna::SetSharedData(key, std::string());
+            return 0;
+        }
+
+        lua_pushcfunction(L, mar_encode);
+        lua_pushvalue(L, 2);
+        lua_call(L, 1, 1);
+
+        size_t length;
+        const char* data = lua_tolstring(L, -1, &length);
+        Eluna::SetSharedData(key, std::string(data, length));
+        lua_pop(L, 1);
+        return 0;
+    }
+
+    /**
+     * Returns a copy of the value stored with [Global:SetSharedData], or nil.
+     *
+     * @param string key
+     * @return nil/boolean/number/string/table value
+     */
+    int GetSharedData(lua_State* L)
+    {
+        std::string key = Eluna::CHECKVAL<std::string>(L, 1);
+
+        std::string data;
+        if (!Eluna::GetSharedData(key, data))
+        {
+            Eluna::Push(L);
+            return 1;
+        }
+
+        lua_pushcfunction(L, mar_decode);
+        lua_pushlstring(L, data.c_str(), data.length());
+        lua_call(L, 1, 1);
+        return 1;
+    }
+
     /**
      * Sends a message to all [Player]s online.
      *
@@ -57,13 +57,17 @@ std::string Eluna::lua_requirepath;
 Eluna* Eluna::GEluna = NULL;
 bool Eluna::reload = false;
 bool Eluna::initialized = false;
-Eluna::LockType Eluna::lock;
+Eluna::LockType Eluna::globalLock;
+bool Eluna::mapStates = false;
+uint32 Eluna::reloadGeneration = 0;
+std::unordered_map<std::string, std::string> Eluna::sharedData;
+std::mutex Eluna::sharedDataLock;
 
 extern void RegisterFunctions(Eluna* E);
 
 void Eluna::Initialize()
 {
-    LOCK_ELUNA;
+    Guard guard(globalLock);
     ASSERT(!IsInitialized());
 
 #ifdef TRINITY
@@ -74,6 +78,8 @@ void Eluna::Initialize()
 
     LoadScriptPaths();
 
+    mapStates = eConfigMgr->GetBoolDefault("Eluna.MapStates", false);
+
     // Must be before creating GEluna
     // This is checked on Eluna creation
     initialized = true;
@@ -84,7 +90,7 @@ void Eluna::Initialize()
 
 void Eluna::Uninitialize()
 {
-    LOCK_ELUNA;
+    Guard guard(globalLock);
     ASSERT(IsInitialized());
 
     delete GEluna;
@@ -93,6 +99,11 @@ void Eluna::Uninitialize()
     lua_scripts.clear();
     lua_extensions.clear();
 
+    {
+        std::lock_guard<std::mutex> sharedGuard(sharedDataLock);
+        sharedData.clear();
+    }
+
     initialized = false;
 }
 
@@ -137,25 +148,16 @@ public:
 
 void Eluna::_ReloadEluna()
 {
-    LOCK_ELUNA;
+    Guard guard(globalLock);
     ASSERT(IsInitialized());
 
     eWorld->SendServerMessage(SERVER_MSG_STRING, "Reloading Eluna...");
 
-    // Remove all timed events
-    sEluna->eventMgr->SetStates(LUAEVENT_STATE_ERASE);
-
-    // Close lua
-    sEluna->CloseLua();
-
-    // Reload script paths
+    // Reload script paths, map states pick them up on their next update
     LoadScriptPaths();
+    ++reloadGeneration;
 
-    // Open new lua and libaraies
-    sEluna->OpenLua();
-
-    // Run scripts from laoded paths
-    sEluna->RunScripts();
+    sEluna->ReloadState();
 
 #ifdef TRINITY
     // Re initialize creature AI restoring C++ AI or applying lua AI
@@ -170,7 +172,73 @@ void Eluna::_ReloadEluna()
     reload = false;
 }
 
-Eluna::Eluna() :
+void Eluna::ReloadState()
+{
+    LOCK_ELUNA;
+
+    // Remove all timed events
+    eventMgr->SetStates(LUAEVENT_STATE_ERASE);
+
+    // Close lua
+    CloseLua();
+
+    // Open new lua and libaraies
+    OpenLua();
+
+    // Run scripts from laoded paths
+    RunScripts();
+}
+
+Eluna* Eluna::CreateMapState(Map* map)
+{
+    if (!UseMapStates())
+        return NULL;
+
+    Eluna* E = new Eluna(map);
+    E->RunScripts();
+    return E;
+}
+
+void Eluna::DestroyMapState(Eluna* E)
+{
+    delete E;
+}
+
+void Eluna::UpdateMapState(uint32 diff)
+{
+    if (loadedGeneration != reloadGeneration)
+        ReloadState();
+
+    eventMgr->globalProcessor->Update(diff);
+}
+
+void Eluna::SetSharedData(const std::string& key, const std::string& value)
+{
+    std::lock_guard<std::mutex> guard(sharedDataLock);
+
+    if (value.empty())
+        sharedData.erase(key);
+    else
+        sharedData[key] = value;
+}
+
+bool Eluna::GetSharedData(const std::string& key, std::string& value)
+{
+    std::lock_guard<std::mutex> guard(sharedDataLock);
+
+    std::unordered_map<std::string, std::string>::const_iterator itr = sharedData.find(key);
+    if (itr == sharedData.end())
+        return false;
+
+    value = itr->second;
+    return true;
+}
+
+Eluna::Eluna(Map* map) :
+boundMap(map),
+self(this),
+loadedGeneration(reloadGeneration),
+
 event_level(0),
 push_counter(0),
 enabled(false),
@@ -202,11 +270,9 @@ CreatureUniqueBindings(NULL)
 
     OpenLua();
 
-    // Replace this with map insert if making multithread version
-
     // Set event manager. Must be after setting sEluna
-    // on multithread have a map of state pointers and here insert this pointer to the map and then save a pointer of that pointer to the EventMgr
-    eventMgr = new EventMgr(&Eluna::GEluna);
+    // A map state is not stored in GEluna, its events go to the state itself
+    eventMgr = new EventMgr(boundMap ? &self : &Eluna::GEluna);
 }
 
 Eluna::~Eluna()
@@ -236,6 +302,8 @@ void Eluna::CloseLua()
 
 void Eluna::OpenLua()
 {
+    loadedGeneration = reloadGeneration;
+
     enabled = eConfigMgr->GetBoolDefault("Eluna.Enabled", true);
     if (!IsEnabled())
     {
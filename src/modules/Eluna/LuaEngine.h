@@ -113,7 +113,8 @@ struct LuaScript
 
 #define ELUNA_OBJECT_STORE  "Eluna Object Store"
 #define ELUNA_STATE_PTR     "Eluna State Ptr"
-#define LOCK_ELUNA Eluna::Guard __guard(Eluna::GetLock())
+#define LOCK_ELUNA Eluna::Guard __guard(GetLock())
+#define LOCK_ELUNA_STATE(E) Eluna::Guard __guard((E)->GetLock())
 
 #ifndef TRINITY
 #define TC_GAME_API
@@ -129,7 +130,24 @@ public:
 private:
     static bool reload;
     static bool initialized;
-    static LockType lock;
+    static LockType globalLock;
+
+    // Create an independent state for every map, see CreateMapState
+    static bool mapStates;
+    // Increased on every reload, map states reload when theirs is older
+    static uint32 reloadGeneration;
+
+    // Values shared by all states, stored marshalled
+    static std::unordered_map<std::string, std::string> sharedData;
+    static std::mutex sharedDataLock;
+
+    // Serializes the hooks of this state only
+    LockType lock;
+    // Map the state belongs to, NULL for the global state
+    Map* boundMap;
+    // Target of the event manager of a map state
+    Eluna* self;
+    uint32 loadedGeneration;
 
     // Lua script locations
     static ScriptList lua_scripts;
@@ -151,7 +169,7 @@ private:
     // Map from map ID -> Lua table ref
     std::unordered_map<uint32, int> continentDataRefs;
 
-    Eluna();
+    Eluna(Map* map = NULL);
     ~Eluna();
 
     // Prevent copy
@@ -168,6 +186,7 @@ private:
     // Use ReloadEluna() to make eluna reload
     // This is called on world update to reload eluna
     static void _ReloadEluna();
+    void ReloadState();
     static void LoadScriptPaths();
     static void GetScripts(std::string path);
     static void AddScriptPath(std::string filename, const std::string& fullpath);
@@ -245,9 +264,21 @@ public:
     static void Initialize();
     static void Uninitialize();
     // This function is used to make eluna reload
-    static void ReloadEluna() { LOCK_ELUNA; reload = true; }
-    static LockType& GetLock() { return lock; };
+    static void ReloadEluna() { Guard guard(globalLock); reload = true; }
+    LockType& GetLock() { return lock; };
     static bool IsInitialized() { return initialized; }
+
+    // Returns a new state with all scripts run for the map, or NULL when map states are disabled
+    static Eluna* CreateMapState(Map* map);
+    static void DestroyMapState(Eluna* E);
+    static bool UseMapStates() { return mapStates; }
+    // Reloads a map state after a reload of the global state and runs its global timed events
+    void UpdateMapState(uint32 diff);
+    Map* GetBoundMap() const { return boundMap; }
+
+    // Marshalled values visible to every state, an empty value removes the key
+    static void SetSharedData(const std::string& key, const std::string& value);
+    static bool GetSharedData(const std::string& key, std::string& value);
     // Never returns nullptr
     static Eluna* GetEluna(lua_State* L)
     {
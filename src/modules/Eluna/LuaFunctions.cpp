@@ -104,6 +104,8 @@ luaL_Reg GlobalMethods[] =
     { "bit_and", &LuaGlobalFunctions::bit_and },
     { "GetItemLink", &LuaGlobalFunctions::GetItemLink },
     { "GetMapById", &LuaGlobalFunctions::GetMapById },
+    { "GetStateMap", &LuaGlobalFunctions::GetStateMap },
+    { "GetSharedData", &LuaGlobalFunctions::GetSharedData },
     { "GetCurrTime", &LuaGlobalFunctions::GetCurrTime },
     { "GetTimeDiff", &LuaGlobalFunctions::GetTimeDiff },
     { "PrintInfo", &LuaGlobalFunctions::PrintInfo },
@@ -118,6 +120,7 @@ luaL_Reg GlobalMethods[] =
 
     // Other
     { "ReloadEluna", &LuaGlobalFunctions::ReloadEluna },
+    { "SetSharedData", &LuaGlobalFunctions::SetSharedData },
     { "SendWorldMessage", &LuaGlobalFunctions::SendWorldMessage },
     { "WorldDBQuery", &LuaGlobalFunctions::WorldDBQuery },
     { "WorldDBExecute", &LuaGlobalFunctions::WorldDBExecute },
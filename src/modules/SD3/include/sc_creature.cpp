@@ -636,7 +636,8 @@ void ScriptedAI::DoResetThreat()
         return;
     }
 
-    ThreatList const& tList = m_creature->GetThreatManager().getThreatList();
+    // copy, dropping the threat can change the list
+    ThreatList tList = m_creature->GetThreatManager().getThreatList();
     for (ThreatList::const_iterator itr = tList.begin(); itr != tList.end(); ++itr)
     {
         Unit* pUnit = m_creature->GetMap()->GetUnit((*itr)->getUnitGuid());
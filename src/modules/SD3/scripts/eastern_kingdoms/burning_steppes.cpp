@@ -664,7 +664,8 @@ struct npc_klinfran_the_crazed : public CreatureScript
                 if (creature_the_cleaner)
                 {
                     DoScriptText(SAY_THE_CLEANER_AGGRO, creature_the_cleaner);
-                    ThreatList const& tList = m_creature->GetThreatManager().getThreatList();
+                    // copy, the attacks below can change the list
+                    ThreatList tList = m_creature->GetThreatManager().getThreatList();
                     for (auto itr : tList)
                     {
                         if (Unit* pUnit = m_creature->GetMap()->GetUnit(itr->getUnitGuid()))
@@ -621,7 +621,8 @@ struct npc_simone_the_seductressAI : public ScriptedAI
             Creature* pCleaner = m_creature->SummonCreature(NPC_THE_CLEANER, m_creature->GetPositionX(), m_creature->GetPositionY(), m_creature->GetPositionZ(), m_creature->GetAngle(m_creature), TEMPSPAWN_CORPSE_DESPAWN, 20 * MINUTE * IN_MILLISECONDS);
             if (pCleaner)
             {
-                ThreatList const& SimonetList = m_creature->GetThreatManager().getThreatList();
+                // copy, the attacks below can change the list
+                ThreatList SimonetList = m_creature->GetThreatManager().getThreatList();
 
                 for (auto itr : SimonetList)
                 {
@@ -636,7 +637,8 @@ struct npc_simone_the_seductressAI : public ScriptedAI
 
                 if (Creature* pPrecious = m_creature->GetMap()->GetCreature(m_preciousGuid))
                 {
-                    ThreatList const& PrecioustList = pPrecious->GetThreatManager().getThreatList();
+                    // copy, the attacks below can change the list
+                    ThreatList PrecioustList = pPrecious->GetThreatManager().getThreatList();
 
                     for (auto itr : PrecioustList)
                     {
@@ -189,7 +189,8 @@ struct boss_hodir : public CreatureScript
                 if (!m_bEventFinished)
                 {
                     // Inform the faction helpers that the fight is over
-                    ThreatList const& threatList = m_creature->GetThreatManager().getThreatList();
+                    // copy, evading the helpers removes them from the list
+                    ThreatList threatList = m_creature->GetThreatManager().getThreatList();
                     for (ThreatList::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     {
                         // only check creatures
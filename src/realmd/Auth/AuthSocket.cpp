@@ -33,6 +33,8 @@
 #include "Realm/RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthWorkerPool.h"
+#include "LogonSRP6.h"
 #include "Patch/PatchHandler.h"
 
 #include <openssl/md5.h>
@@ -141,22 +143,37 @@ typedef struct AuthHandler
 #endif
 
 
+typedef std::map<uint32, AuthSocket*> AuthSocketMap;
+
+static AuthSocketMap s_connections;                         // only touched on the reactor thread
+static uint32 s_nextConnectionId = 0;
+
 /// Constructor - set the N and g values for SRP6
-AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE)
+AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE), _taskPending(false)
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
+    LogonSRP6::InitParameters(N, g);
+
+    _connectionId = ++s_nextConnectionId;
+    s_connections[_connectionId] = this;
 }
 
 /// Close patch file descriptor before leaving
 AuthSocket::~AuthSocket()
 {
+    s_connections.erase(_connectionId);
+
     if (patch_ != ACE_INVALID_HANDLE)
     {
         ACE_OS::close(patch_);
     }
 }
 
+AuthSocket* AuthSocket::FindConnection(uint32 connectionId)
+{
+    AuthSocketMap::const_iterator itr = s_connections.find(connectionId);
+    return itr != s_connections.end() ? itr->second : NULL;
+}
+
 /// Accept the connection and set the s random value for SRP6
 void AuthSocket::OnAccept()
 {
@@ -183,6 +200,12 @@ void AuthSocket::OnRead()
 
     while (1)
     {
+        ///- Keep further commands buffered until the pending logon task replies
+        if (_taskPending)
+        {
+            return;
+        }
+
         if (!recv_soft((char*)&_cmd, 1))
         {
             return;
@@ -221,40 +244,6 @@ void AuthSocket::OnRead()
     }
 }
 
-/// Make the SRP6 calculation from hash in dB
-void AuthSocket::_SetVSFields(const std::string& rI)
-{
-    s.SetRand(s_BYTE_SIZE * 8);
-
-    BigNumber I;
-    I.SetHexStr(rI.c_str());
-
-    // In case of leading zeros in the rI hash, restore them
-    uint8 mDigest[SHA_DIGEST_LENGTH];
-    memset(mDigest, 0, SHA_DIGEST_LENGTH);
-    if (I.GetNumBytes() <= SHA_DIGEST_LENGTH)
-    {
-        memcpy(mDigest, I.AsByteArray(), I.GetNumBytes());
-    }
-
-    std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
-
-    Sha1Hash sha;
-    sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
-    sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
-    sha.Finalize();
-    BigNumber x;
-    x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
-    // No SQL injection (username escaped)
-    const char* v_hex, *s_hex;
-    v_hex = v.AsHexStr();
-    s_hex = s.AsHexStr();
-    LoginDatabase.PExecute("UPDATE `account` SET `v` = '%s', `s` = '%s' WHERE `username` = '%s'", v_hex, s_hex, _safelogin.c_str());
-    OPENSSL_free((void*)v_hex);
-    OPENSSL_free((void*)s_hex);
-}
-
 void AuthSocket::SendProof(Sha1Hash sha)
 {
     switch (_build)
@@ -297,6 +286,356 @@ void AuthSocket::SendProof(Sha1Hash sha)
     }
 }
 
+/**
+ * @brief Database lookups and SRP6 setup for a logon challenge
+ *
+ * Everything the worker needs is copied out of the socket up front, the
+ * socket itself is only looked up again in Complete().
+ */
+class LogonChallengeTask : public AuthTask
+{
+    public:
+        LogonChallengeTask(AuthSocket& socket, std::string const& address, uint8 const* country)
+            : m_connectionId(socket._connectionId), m_login(socket._login), m_safelogin(socket._safelogin),
+              m_address(address), N(socket.N), g(socket.g), m_result(WOW_FAIL_UNKNOWN_ACCOUNT), m_secLevel(SEC_PLAYER)
+        {
+            memcpy(m_country, country, 4);
+        }
+
+        void Execute() override
+        {
+            ///- Verify that this IP is not in the ip_banned table
+            // No SQL injection possible (paste the IP address as passed by the socket)
+            std::string address = m_address;
+            LoginDatabase.escape_string(address);
+            QueryResult* result = LoginDatabase.PQuery("SELECT `unbandate` FROM `ip_banned` WHERE "
+                                  //    permanent                    still banned
+                                  "(`unbandate` = `bandate` OR `unbandate` > UNIX_TIMESTAMP()) AND `ip` = '%s'", address.c_str());
+            if (result)
+            {
+                m_result = WOW_FAIL_BANNED;
+                BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
+                delete result;
+                return;
+            }
+
+            ///- Get the account details from the account table
+            // No SQL injection (escaped user name)
+            result = LoginDatabase.PQuery("SELECT `sha_pass_hash`,`id`,`locked`,`last_ip`,`gmlevel`,`v`,`s` FROM `account` WHERE `username` = '%s'", m_safelogin.c_str());
+            if (!result)                                    // no account
+            {
+                m_result = WOW_FAIL_UNKNOWN_ACCOUNT;
+                return;
+            }
+
+            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+            if ((*result)[2].GetUInt8() == 1)               // if ip is locked
+            {
+                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", m_login.c_str(), (*result)[3].GetString());
+                DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
+                if (strcmp((*result)[3].GetString(), m_address.c_str()))
+                {
+                    DEBUG_LOG("[AuthChallenge] Account IP differs");
+#if defined(CLASSIC)
+                    m_result = WOW_FAIL_DB_BUSY;
+#else
+                    m_result = WOW_FAIL_LOCKED_ENFORCED;
+#endif
+                    delete result;
+                    return;
+                }
+
+                DEBUG_LOG("[AuthChallenge] Account IP matches");
+            }
+            else
+            {
+                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", m_login.c_str());
+            }
+
+            ///- If the account is banned, reject the logon attempt
+            QueryResult* banresult = LoginDatabase.PQuery("SELECT `bandate`,`unbandate` FROM `account_banned` WHERE "
+                                     "`id` = %u AND `active` = 1 AND (`unbandate` > UNIX_TIMESTAMP() OR `unbandate` = `bandate`)", (*result)[1].GetUInt32());
+            if (banresult)
+            {
+                if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
+                {
+                    m_result = WOW_FAIL_BANNED;
+                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", m_login.c_str());
+                }
+                else
+                {
+                    m_result = WOW_FAIL_SUSPENDED;
+                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", m_login.c_str());
+                }
+
+                delete banresult;
+                delete result;
+                return;
+            }
+
+            ///- Get the password from the account table, upper it, and make the SRP6 calculation
+            std::string rI = (*result)[0].GetCppString();
+
+            ///- Don't calculate (v, s) if there are already some in the database
+            std::string databaseV = (*result)[5].GetCppString();
+            std::string databaseS = (*result)[6].GetCppString();
+
+            DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+            // multiply with 2, bytes are stored as hexstring
+            if (databaseV.size() != AuthSocket::s_BYTE_SIZE * 2 || databaseS.size() != AuthSocket::s_BYTE_SIZE * 2)
+            {
+                LogonSRP6::MakeVerifier(rI, N, g, s, v);
+
+                // No SQL injection (username escaped)
+                const char* v_hex, *s_hex;
+                v_hex = v.AsHexStr();
+                s_hex = s.AsHexStr();
+                LoginDatabase.PExecute("UPDATE `account` SET `v` = '%s', `s` = '%s' WHERE `username` = '%s'", v_hex, s_hex, m_safelogin.c_str());
+                OPENSSL_free((void*)v_hex);
+                OPENSSL_free((void*)s_hex);
+            }
+            else
+            {
+                s.SetHexStr(databaseS.c_str());
+                v.SetHexStr(databaseV.c_str());
+            }
+
+            LogonSRP6::MakeServerEphemeral(N, g, v, b, B);
+
+            m_secLevel = (*result)[4].GetUInt8();
+            m_result = WOW_SUCCESS;
+            delete result;
+        }
+
+        void Complete() override
+        {
+            AuthSocket* socket = AuthSocket::FindConnection(m_connectionId);
+            if (!socket)
+            {
+                return;
+            }
+
+            ByteBuffer pkt;
+            pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+            pkt << (uint8) 0x00;
+            pkt << uint8(m_result);
+
+            if (m_result == WOW_SUCCESS)
+            {
+                socket->s = s;
+                socket->v = v;
+                socket->b = b;
+                socket->B = B;
+
+                BigNumber unk3;
+                unk3.SetRand(16 * 8);
+
+                ///- Fill the response packet with the result
+                // B may be calculated < 32B so we force minimal length to 32B
+                pkt.append(B.AsByteArray(32), 32);          // 32 bytes
+                pkt << uint8(1);
+                pkt.append(g.AsByteArray(), 1);
+                pkt << uint8(32);
+                pkt.append(N.AsByteArray(32), 32);
+                pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
+                pkt.append(unk3.AsByteArray(16), 16);
+                uint8 securityFlags = 0;
+                pkt << uint8(securityFlags);                // security flags (0x0...0x04)
+
+                if (securityFlags & 0x01)                   // PIN input
+                {
+                    pkt << uint32(0);
+                    pkt << uint64(0) << uint64(0);          // 16 bytes hash?
+                }
+
+                if (securityFlags & 0x02)                   // Matrix input
+                {
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint64(0);
+                }
+
+                if (securityFlags & 0x04)                   // Security token input
+                {
+                    pkt << uint8(1);
+                }
+
+                socket->_accountSecurityLevel = m_secLevel <= SEC_ADMINISTRATOR ? AccountTypes(m_secLevel) : SEC_ADMINISTRATOR;
+
+                socket->_localizationName.resize(4);
+                for (int i = 0; i < 4; ++i)
+                {
+                    socket->_localizationName[i] = m_country[4 - i - 1];
+                }
+
+                BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", m_login.c_str(), m_country[3], m_country[2], m_country[1], m_country[0], GetLocaleByName(socket->_localizationName));
+
+                socket->_status = AuthSocket::STATUS_LOGON_PROOF;
+            }
+
+            socket->send((char const*)pkt.contents(), pkt.size());
+
+            ///- Resume with whatever the client sent while we were busy
+            socket->_taskPending = false;
+            socket->OnRead();
+        }
+
+    private:
+        uint32 m_connectionId; /**< TODO */
+        std::string m_login; /**< TODO */
+        std::string m_safelogin; /**< TODO */
+        std::string m_address; /**< TODO */
+        uint8 m_country[4]; /**< TODO */
+
+        BigNumber N, g, s, v, b, B; /**< TODO */
+
+        AuthResult m_result; /**< TODO */
+        uint8 m_secLevel; /**< TODO */
+};
+
+/**
+ * @brief SRP6 proof check and account bookkeeping for a logon proof
+ *
+ */
+class LogonProofTask : public AuthTask
+{
+    public:
+        LogonProofTask(AuthSocket& socket, sAuthLogonProof_C const& lp)
+            : m_connectionId(socket._connectionId), m_login(socket._login), m_safelogin(socket._safelogin),
+              m_address(socket.get_remote_address()), m_os(socket._os), m_locale(GetLocaleByName(socket._localizationName)),
+              N(socket.N), g(socket.g), s(socket.s), v(socket.v), b(socket.b), B(socket.B),
+              m_result(LogonSRP6::PROOF_WRONG_PASSWORD)
+        {
+            memcpy(m_A, lp.A, sizeof(m_A));
+            memcpy(m_M1, lp.M1, sizeof(m_M1));
+
+            // Config is not safe to read from the worker threads
+            m_maxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
+            m_wrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+            m_wrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+        }
+
+        void Execute() override
+        {
+            m_result = LogonSRP6::CheckClientProof(m_login, N, g, s, v, b, B, m_A, m_M1, K, m_M2);
+
+            if (m_result == LogonSRP6::PROOF_OK)
+            {
+                BASIC_LOG("User '%s' successfully authenticated", m_login.c_str());
+
+                ///- Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
+                // No SQL injection (escaped user name) and IP address as received by socket
+                const char* K_hex = K.AsHexStr();
+                LoginDatabase.PExecute("UPDATE `account` SET `sessionkey` = '%s', `last_ip` = '%s', `last_login` = NOW(), `locale` = '%u', `os` = '%s', `failed_logins` = 0 WHERE `username` = '%s'", K_hex, m_address.c_str(), m_locale, m_os.c_str(), m_safelogin.c_str());
+                OPENSSL_free((void*)K_hex);
+                return;
+            }
+
+            if (m_result != LogonSRP6::PROOF_WRONG_PASSWORD)
+            {
+                return;
+            }
+
+            BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", m_login.c_str());
+
+            if (m_maxWrongPassCount > 0)
+            {
+                // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
+                LoginDatabase.PExecute("UPDATE `account` SET `failed_logins` = `failed_logins` + 1 WHERE `username` = '%s'", m_safelogin.c_str());
+
+                if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT `id`, `failed_logins` FROM `account` WHERE `username` = '%s'", m_safelogin.c_str()))
+                {
+                    Field* fields = loginfail->Fetch();
+                    uint32 failed_logins = fields[1].GetUInt32();
+
+                    if (failed_logins >= m_maxWrongPassCount)
+                    {
+                        if (m_wrongPassBanType)
+                        {
+                            uint32 acc_id = fields[0].GetUInt32();
+                            LoginDatabase.PExecute("INSERT INTO `account_banned` VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                                   acc_id, m_wrongPassBanTime);
+                            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                                      m_login.c_str(), m_wrongPassBanTime, failed_logins);
+                        }
+                        else
+                        {
+                            std::string current_ip = m_address;
+                            LoginDatabase.escape_string(current_ip);
+                            LoginDatabase.PExecute("INSERT INTO `ip_banned` VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                                   current_ip.c_str(), m_wrongPassBanTime);
+                            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                                      current_ip.c_str(), m_wrongPassBanTime, m_login.c_str(), failed_logins);
+                        }
+                    }
+                    delete loginfail;
+                }
+            }
+        }
+
+        void Complete() override
+        {
+            AuthSocket* socket = AuthSocket::FindConnection(m_connectionId);
+            if (!socket)
+            {
+                return;
+            }
+
+            socket->_taskPending = false;
+
+            switch (m_result)
+            {
+                case LogonSRP6::PROOF_OK:
+                    socket->K = K;
+                    socket->SendProof(m_M2);
+
+                    ///- Set _status to authenticated
+                    socket->_status = AuthSocket::STATUS_AUTHED;
+                    break;
+                case LogonSRP6::PROOF_WRONG_PASSWORD:
+                    if (socket->_build > 6005)              // > 1.12.2
+                    {
+                        char data[4] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
+                        socket->send(data, sizeof(data));
+                    }
+                    else
+                    {
+                        // 1.x not react incorrectly at 4-byte message use 3 as real error
+                        char data[2] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT};
+                        socket->send(data, sizeof(data));
+                    }
+                    break;
+                default:
+                    // bad client ephemeral, leave the session closed without a reply
+                    return;
+            }
+
+            socket->OnRead();
+        }
+
+    private:
+        uint32 m_connectionId; /**< TODO */
+        std::string m_login; /**< TODO */
+        std::string m_safelogin; /**< TODO */
+        std::string m_address; /**< TODO */
+        std::string m_os; /**< TODO */
+        uint32 m_locale; /**< TODO */
+
+        BigNumber N, g, s, v, b, B, K; /**< TODO */
+        uint8 m_A[32]; /**< TODO */
+        uint8 m_M1[20]; /**< TODO */
+        Sha1Hash m_M2; /**< TODO */
+
+        uint32 m_maxWrongPassCount; /**< TODO */
+        uint32 m_wrongPassBanTime; /**< TODO */
+        bool m_wrongPassBanType; /**< TODO */
+
+        LogonSRP6::ProofResult m_result; /**< TODO */
+};
+
 /// Logon Challenge command handler
 bool AuthSocket::_HandleLogonChallenge()
 {
@@ -347,8 +686,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
     _os = (const char*)ch->os;
@@ -369,163 +706,9 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
-    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
-    pkt << (uint8) 0x00;
-
-    ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
-    std::string address = get_remote_address();
-    LoginDatabase.escape_string(address);
-    QueryResult* result = LoginDatabase.PQuery("SELECT `unbandate` FROM `ip_banned` WHERE "
-                          //    permanent                    still banned
-                          "(`unbandate` = `bandate` OR `unbandate` > UNIX_TIMESTAMP()) AND `ip` = '%s'", address.c_str());
-    if (result)
-    {
-        pkt << (uint8)WOW_FAIL_BANNED;
-        BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", get_remote_address().c_str());
-        delete result;
-    }
-    else
-    {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
-
-        result = LoginDatabase.PQuery("SELECT `sha_pass_hash`,`id`,`locked`,`last_ip`,`gmlevel`,`v`,`s` FROM `account` WHERE `username` = '%s'", _safelogin.c_str());
-        if (result)
-        {
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if ((*result)[2].GetUInt8() == 1)               // if ip is locked
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[3].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", get_remote_address().c_str());
-                if (strcmp((*result)[3].GetString(), get_remote_address().c_str()))
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-#if defined(CLASSIC)
-                    pkt << (uint8)WOW_FAIL_DB_BUSY;
-#else
-                    pkt << (uint8)WOW_FAIL_LOCKED_ENFORCED;
-#endif
-                    locked = true;
-                }
-                else
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
-                }
-            }
-            else
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
-            }
-
-            if (!locked)
-            {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT `bandate`,`unbandate` FROM `account_banned` WHERE "
-                                         "`id` = %u AND `active` = 1 AND (`unbandate` > UNIX_TIMESTAMP() OR `unbandate` = `bandate`)", (*result)[1].GetUInt32());
-                if (banresult)
-                {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << (uint8) WOW_FAIL_BANNED;
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
-                    }
-                    else
-                    {
-                        pkt << (uint8) WOW_FAIL_SUSPENDED;
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
-                    }
-
-                    delete banresult;
-                }
-                else
-                {
-                    ///- Get the password from the account table, upper it, and make the SRP6 calculation
-                    std::string rI = (*result)[0].GetCppString();
-
-                    ///- Don't calculate (v, s) if there are already some in the database
-                    std::string databaseV = (*result)[5].GetCppString();
-                    std::string databaseS = (*result)[6].GetCppString();
-
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                    // multiply with 2, bytes are stored as hexstring
-                    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
-                    {
-                        _SetVSFields(rI);
-                    }
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
-
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
-
-                    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
-
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
-
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
-
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(g.AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(unk3.AsByteArray(16), 16);
-                    uint8 securityFlags = 0;
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if (securityFlags & 0x01)               // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if (securityFlags & 0x02)               // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & 0x04)               // Security token input
-                    {
-                        pkt << uint8(1);
-                    }
-
-                    uint8 secLevel = (*result)[4].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        _localizationName[i] = ch->country[4 - i - 1];
-                    }
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
-
-                    _status = STATUS_LOGON_PROOF;
-                }
-            }
-            delete result;
-        }
-        else                                                // no account
-        {
-            pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
-        }
-    }
-    send((char const*)pkt.contents(), pkt.size());
+    ///- Ban checks, account lookup and SRP6 setup may block, hand them to the worker pool
+    _taskPending = true;
+    sAuthWorkerPool.Schedule(new LogonChallengeTask(*this, get_remote_address(), ch->country));
     return true;
 }
 
@@ -611,155 +794,8 @@ bool AuthSocket::_HandleLogonProof()
     /// </ul>
 
     ///- Continue the SRP6 calculation based on data received from the client
-    BigNumber A;
-
-    A.SetBinary(lp.A, 32);
-
-    // SRP safeguard: abort if A==0
-    if ((A % N).isZero())
-    {
-        return false;
-    }
-
-    Sha1Hash sha;
-    sha.UpdateBigNumbers(&A, &B, NULL);
-    sha.Finalize();
-    BigNumber u;
-    u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
-
-    uint8 t[32];
-    uint8 t1[16];
-    uint8 vK[40];
-    memcpy(t, S.AsByteArray(32), 32);
-    for (int i = 0; i < 16; ++i)
-    {
-        t1[i] = t[i * 2];
-    }
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        vK[i * 2] = sha.GetDigest()[i];
-    }
-    for (int i = 0; i < 16; ++i)
-    {
-        t1[i] = t[i * 2 + 1];
-    }
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        vK[i * 2 + 1] = sha.GetDigest()[i];
-    }
-    K.SetBinary(vK, 40);
-
-    uint8 hash[20];
-
-    sha.Initialize();
-    sha.UpdateBigNumbers(&N, NULL);
-    sha.Finalize();
-    memcpy(hash, sha.GetDigest(), 20);
-    sha.Initialize();
-    sha.UpdateBigNumbers(&g, NULL);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        hash[i] ^= sha.GetDigest()[i];
-    }
-    BigNumber t3;
-    t3.SetBinary(hash, 20);
-
-    sha.Initialize();
-    sha.UpdateData(_login);
-    sha.Finalize();
-    uint8 t4[SHA_DIGEST_LENGTH];
-    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
-
-    sha.Initialize();
-    sha.UpdateBigNumbers(&t3, NULL);
-    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
-    sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
-    sha.Finalize();
-    BigNumber M;
-    M.SetBinary(sha.GetDigest(), 20);
-
-    ///- Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
-    {
-        BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
-
-        ///- Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
-        // No SQL injection (escaped user name) and IP address as received by socket
-        const char* K_hex = K.AsHexStr();
-        LoginDatabase.PExecute("UPDATE `account` SET `sessionkey` = '%s', `last_ip` = '%s', `last_login` = NOW(), `locale` = '%u', `os` = '%s', `failed_logins` = 0 WHERE `username` = '%s'", K_hex, get_remote_address().c_str(), GetLocaleByName(_localizationName), _os.c_str(), _safelogin.c_str());
-        OPENSSL_free((void*)K_hex);
-
-        ///- Finish SRP6 and send the final result to the client
-        sha.Initialize();
-        sha.UpdateBigNumbers(&A, &M, &K, NULL);
-        sha.Finalize();
-
-        SendProof(sha);
-
-        ///- Set _status to authenticated
-        _status = STATUS_AUTHED;
-    }
-    else
-    {
-        if (_build > 6005)                                  // > 1.12.2
-        {
-            char data[4] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
-            send(data, sizeof(data));
-        }
-        else
-        {
-            // 1.x not react incorrectly at 4-byte message use 3 as real error
-            char data[2] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT};
-            send(data, sizeof(data));
-        }
-        BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
-
-        uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
-        if (MaxWrongPassCount > 0)
-        {
-            // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
-            LoginDatabase.PExecute("UPDATE `account` SET `failed_logins` = `failed_logins` + 1 WHERE `username` = '%s'", _safelogin.c_str());
-
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT `id`, `failed_logins` FROM `account` WHERE `username` = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
-
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO `account_banned` VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = get_remote_address();
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO `ip_banned` VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
-        }
-    }
+    _taskPending = true;
+    sAuthWorkerPool.Schedule(new LogonProofTask(*this, lp));
     return true;
 }
 
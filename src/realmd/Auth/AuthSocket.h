@@ -137,13 +137,17 @@ class AuthSocket: public BufferedSocket
         bool _HandleXferAccept();
 
         /**
-         * @brief
+         * @brief Look up a live socket from a logon task completing on the reactor thread
          *
-         * @param rI
+         * @param connectionId
+         * @return AuthSocket NULL if the client disconnected meanwhile
          */
-        void _SetVSFields(const std::string& rI);
+        static AuthSocket* FindConnection(uint32 connectionId);
 
     private:
+        friend class LogonChallengeTask;
+        friend class LogonProofTask;
+
         enum eStatus
         {
             STATUS_CHALLENGE,
@@ -171,6 +175,9 @@ class AuthSocket: public BufferedSocket
 
         ACE_HANDLE patch_; /**< TODO */
 
+        uint32 _connectionId; /**< TODO */
+        bool _taskPending; /**< input is left buffered until the running logon task completes */
+
         /**
          * @brief
          *
@@ -0,0 +1,176 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthWorkerPool.h"
+
+#include <ace/Reactor.h>
+
+AuthWorkerPool::AuthWorkerPool() : m_reactor(NULL), m_stopping(false)
+{
+}
+
+AuthWorkerPool::~AuthWorkerPool()
+{
+    Stop();
+}
+
+AuthWorkerPool& AuthWorkerPool::Instance()
+{
+    static AuthWorkerPool pool;
+    return pool;
+}
+
+void AuthWorkerPool::Start(ACE_Reactor* reactor, uint32 threads, std::function<void()> threadStart, std::function<void()> threadEnd)
+{
+    m_reactor = reactor;
+    m_threadStart = threadStart;
+    m_threadEnd = threadEnd;
+    m_stopping = false;
+
+    for (uint32 i = 0; i < threads; ++i)
+    {
+        m_workers.push_back(std::thread(&AuthWorkerPool::WorkerLoop, this));
+    }
+}
+
+void AuthWorkerPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_stopping = true;
+    }
+    m_queueWakeup.notify_all();
+
+    for (std::vector<std::thread>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+        itr->join();
+    }
+    m_workers.clear();
+
+    if (m_reactor)
+    {
+        m_reactor->purge_pending_notifications(this);
+        m_reactor = NULL;
+    }
+
+    // sockets are gone by now, nothing left to reply to
+    for (std::deque<AuthTask*>::iterator itr = m_queue.begin(); itr != m_queue.end(); ++itr)
+    {
+        delete *itr;
+    }
+    m_queue.clear();
+
+    for (std::vector<AuthTask*>::iterator itr = m_done.begin(); itr != m_done.end(); ++itr)
+    {
+        delete *itr;
+    }
+    m_done.clear();
+}
+
+void AuthWorkerPool::Schedule(AuthTask* task)
+{
+    if (m_workers.empty())
+    {
+        task->Execute();
+        task->Complete();
+        delete task;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_queue.push_back(task);
+    }
+    m_queueWakeup.notify_one();
+}
+
+int AuthWorkerPool::handle_exception(ACE_HANDLE)
+{
+    std::vector<AuthTask*> done;
+    {
+        std::lock_guard<std::mutex> guard(m_doneLock);
+        done.swap(m_done);
+    }
+
+    for (std::vector<AuthTask*>::iterator itr = done.begin(); itr != done.end(); ++itr)
+    {
+        (*itr)->Complete();
+        delete *itr;
+    }
+
+    return 0;
+}
+
+void AuthWorkerPool::WorkerLoop()
+{
+    if (m_threadStart)
+    {
+        m_threadStart();
+    }
+
+    while (true)
+    {
+        AuthTask* task;
+        {
+            std::unique_lock<std::mutex> guard(m_queueLock);
+            while (!m_stopping && m_queue.empty())
+            {
+                m_queueWakeup.wait(guard);
+            }
+
+            if (m_stopping)
+            {
+                break;
+            }
+
+            task = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        task->Execute();
+
+        ///- Only the first completion since the last drain needs to wake the reactor
+        bool wakeReactor;
+        {
+            std::lock_guard<std::mutex> guard(m_doneLock);
+            wakeReactor = m_done.empty();
+            m_done.push_back(task);
+        }
+
+        if (wakeReactor)
+        {
+            m_reactor->notify(this, ACE_Event_Handler::EXCEPT_MASK);
+        }
+    }
+
+    if (m_threadEnd)
+    {
+        m_threadEnd();
+    }
+}
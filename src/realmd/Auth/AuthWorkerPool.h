@@ -0,0 +1,164 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef MANGOS_H_AUTHWORKERPOOL
+#define MANGOS_H_AUTHWORKERPOOL
+
+#include "Common.h"
+
+#include <ace/Event_Handler.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ACE_Reactor;
+
+/**
+ * @brief A unit of logon work split between a worker thread and the reactor
+ *
+ * Execute() runs on a worker thread and may block on the login database or
+ * spend time in BigNumber math. Complete() runs afterwards on the reactor
+ * thread and is the only place allowed to touch sockets.
+ */
+class AuthTask
+{
+    public:
+        /**
+         * @brief
+         *
+         */
+        virtual ~AuthTask() {}
+
+        /**
+         * @brief Blocking part of the task, called on a worker thread
+         *
+         */
+        virtual void Execute() = 0;
+        /**
+         * @brief Reply part of the task, called on the reactor thread
+         *
+         */
+        virtual void Complete() = 0;
+};
+
+/**
+ * @brief Fixed set of threads running AuthTask::Execute() off the reactor thread
+ *
+ * Finished tasks are queued and handed back to the reactor with a single
+ * notify, so a burst of completions costs one wakeup. With no threads
+ * configured tasks run inline, which keeps the old synchronous behaviour.
+ */
+class AuthWorkerPool : public ACE_Event_Handler
+{
+    public:
+        /**
+         * @brief
+         *
+         */
+        AuthWorkerPool();
+        /**
+         * @brief
+         *
+         */
+        ~AuthWorkerPool();
+
+        /**
+         * @brief
+         *
+         * @return AuthWorkerPool
+         */
+        static AuthWorkerPool& Instance();
+
+        /**
+         * @brief Spawn the worker threads
+         *
+         * @param reactor reactor which runs AuthTask::Complete()
+         * @param threads number of workers, 0 runs every task inline
+         * @param threadStart called on each worker before its first task, e.g. to attach a database connection
+         * @param threadEnd called on each worker when it exits
+         */
+        void Start(ACE_Reactor* reactor, uint32 threads, std::function<void()> threadStart = std::function<void()>(),
+                   std::function<void()> threadEnd = std::function<void()>());
+        /**
+         * @brief Join the workers and drop every task that did not complete
+         *
+         */
+        void Stop();
+
+        /**
+         * @brief Queue a task, the pool owns it from now on
+         *
+         * @param task
+         */
+        void Schedule(AuthTask* task);
+
+        /**
+         * @brief
+         *
+         * @return uint32
+         */
+        uint32 GetThreadCount() const { return uint32(m_workers.size()); }
+
+        /**
+         * @brief Drain the completed queue, called by the reactor after notify()
+         *
+         * @param ACE_HANDLE
+         * @return int
+         */
+        int handle_exception(ACE_HANDLE) override;
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        void WorkerLoop();
+
+        ACE_Reactor* m_reactor; /**< TODO */
+        std::vector<std::thread> m_workers; /**< TODO */
+        std::function<void()> m_threadStart; /**< TODO */
+        std::function<void()> m_threadEnd; /**< TODO */
+
+        std::mutex m_queueLock; /**< TODO */
+        std::condition_variable m_queueWakeup; /**< TODO */
+        std::deque<AuthTask*> m_queue; /**< TODO */
+        bool m_stopping; /**< TODO */
+
+        std::mutex m_doneLock; /**< TODO */
+        std::vector<AuthTask*> m_done; /**< TODO */
+};
+
+#define sAuthWorkerPool AuthWorkerPool::Instance()
+
+#endif
+/// @}
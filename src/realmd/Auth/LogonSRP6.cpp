@@ -0,0 +1,219 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "LogonSRP6.h"
+
+#include <algorithm>
+
+namespace LogonSRP6
+{
+    void InitParameters(BigNumber& N, BigNumber& g)
+    {
+        N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+        g.SetDword(7);
+    }
+
+    void MakeVerifier(std::string const& rI, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& v)
+    {
+        s.SetRand(SALT_BYTE_SIZE * 8);
+
+        BigNumber I;
+        I.SetHexStr(rI.c_str());
+
+        // In case of leading zeros in the rI hash, restore them
+        uint8 mDigest[SHA_DIGEST_LENGTH];
+        memset(mDigest, 0, SHA_DIGEST_LENGTH);
+        if (I.GetNumBytes() <= SHA_DIGEST_LENGTH)
+        {
+            memcpy(mDigest, I.AsByteArray(), I.GetNumBytes());
+        }
+
+        std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
+
+        Sha1Hash sha;
+        sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
+        sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+        v = g.ModExp(x, N);
+    }
+
+    void MakeServerEphemeral(BigNumber& N, BigNumber& g, BigNumber& v, BigNumber& b, BigNumber& B)
+    {
+        b.SetRand(19 * 8);
+        BigNumber gmod = g.ModExp(b, N);
+        B = ((v * 3) + gmod) % N;
+
+        MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
+    }
+
+    void MakeSessionKey(BigNumber& A, BigNumber& N, BigNumber& v, BigNumber& b, BigNumber& B, BigNumber& K)
+    {
+        Sha1Hash sha;
+        sha.UpdateBigNumbers(&A, &B, NULL);
+        sha.Finalize();
+        BigNumber u;
+        u.SetBinary(sha.GetDigest(), 20);
+        BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+
+        InterleaveSessionKey(S, K);
+    }
+
+    void InterleaveSessionKey(BigNumber& S, BigNumber& K)
+    {
+        Sha1Hash sha;
+        uint8 t[32];
+        uint8 t1[16];
+        uint8 vK[40];
+        memcpy(t, S.AsByteArray(32), 32);
+        for (int i = 0; i < 16; ++i)
+        {
+            t1[i] = t[i * 2];
+        }
+        sha.Initialize();
+        sha.UpdateData(t1, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+        {
+            vK[i * 2] = sha.GetDigest()[i];
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            t1[i] = t[i * 2 + 1];
+        }
+        sha.Initialize();
+        sha.UpdateData(t1, 16);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+        {
+            vK[i * 2 + 1] = sha.GetDigest()[i];
+        }
+        K.SetBinary(vK, 40);
+    }
+
+    void MakeClientProof(std::string const& login, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& A, BigNumber& B, BigNumber& K, BigNumber& M)
+    {
+        uint8 hash[20];
+
+        Sha1Hash sha;
+        sha.UpdateBigNumbers(&N, NULL);
+        sha.Finalize();
+        memcpy(hash, sha.GetDigest(), 20);
+        sha.Initialize();
+        sha.UpdateBigNumbers(&g, NULL);
+        sha.Finalize();
+        for (int i = 0; i < 20; ++i)
+        {
+            hash[i] ^= sha.GetDigest()[i];
+        }
+        BigNumber t3;
+        t3.SetBinary(hash, 20);
+
+        sha.Initialize();
+        sha.UpdateData(login);
+        sha.Finalize();
+        uint8 t4[SHA_DIGEST_LENGTH];
+        memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&t3, NULL);
+        sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+        sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
+        sha.Finalize();
+        M.SetBinary(sha.GetDigest(), 20);
+    }
+
+    void MakeClientSession(std::string const& login, uint8 const* passDigest, BigNumber& N, BigNumber& g, BigNumber& s,
+                           BigNumber& B, BigNumber& A, BigNumber& K, BigNumber& M1)
+    {
+        BigNumber a;
+        a.SetRand(19 * 8);
+        A = g.ModExp(a, N);
+
+        Sha1Hash sha;
+        sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
+        sha.UpdateData(passDigest, SHA_DIGEST_LENGTH);
+        sha.Finalize();
+        BigNumber x;
+        x.SetBinary(sha.GetDigest(), sha.GetLength());
+
+        sha.Initialize();
+        sha.UpdateBigNumbers(&A, &B, NULL);
+        sha.Finalize();
+        BigNumber u;
+        u.SetBinary(sha.GetDigest(), 20);
+
+        // S = (B - 3 * g^x) ^ (a + u * x) mod N, kept non-negative
+        BigNumber base = ((B + N) - ((g.ModExp(x, N) * 3) % N)) % N;
+        BigNumber S = base.ModExp(a + (u * x), N);
+
+        InterleaveSessionKey(S, K);
+        MakeClientProof(login, N, g, s, A, B, K, M1);
+    }
+
+    void PackBytes(BigNumber& bn, uint8* out, int size)
+    {
+        memset(out, 0, size);
+        memcpy(out, bn.AsByteArray(), std::min(bn.GetNumBytes(), size));
+    }
+
+    ProofResult CheckClientProof(std::string const& login, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& v,
+                                 BigNumber& b, BigNumber& B, uint8 const* A, uint8 const* M1, BigNumber& K, Sha1Hash& M2)
+    {
+        BigNumber bnA;
+        bnA.SetBinary(A, 32);
+
+        // SRP safeguard: abort if A==0
+        if ((bnA % N).isZero())
+        {
+            return PROOF_BAD_EPHEMERAL;
+        }
+
+        MakeSessionKey(bnA, N, v, b, B, K);
+
+        BigNumber M;
+        MakeClientProof(login, N, g, s, bnA, B, K, M);
+
+        ///- Check if SRP6 results match (password is correct)
+        // M drops trailing zero bytes of the digest, compare the full 20 bytes
+        uint8 proof[20];
+        PackBytes(M, proof, sizeof(proof));
+        if (memcmp(proof, M1, sizeof(proof)))
+        {
+            return PROOF_WRONG_PASSWORD;
+        }
+
+        ///- Finish SRP6, the caller sends this back to the client
+        M2.Initialize();
+        M2.UpdateBigNumbers(&bnA, &M, &K, NULL);
+        M2.Finalize();
+        return PROOF_OK;
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef MANGOS_H_LOGONSRP6
+#define MANGOS_H_LOGONSRP6
+
+#include "Common.h"
+#include "Auth/BigNumber.h"
+#include "Auth/Sha1.h"
+
+/**
+ * @brief Server side SRP6 steps of the logon handshake.
+ *
+ * None of these touch the socket or the database, so they can be run on the
+ * auth worker threads and reused by the logon benchmark.
+ */
+namespace LogonSRP6
+{
+    const int SALT_BYTE_SIZE = 32; /**< TODO */
+
+    /**
+     * @brief Result of checking the client logon proof
+     *
+     */
+    enum ProofResult
+    {
+        PROOF_OK,
+        PROOF_BAD_EPHEMERAL,                                // A % N == 0, drop the connection
+        PROOF_WRONG_PASSWORD
+    };
+
+    /**
+     * @brief Set the N and g values used by every logon
+     *
+     * @param N
+     * @param g
+     */
+    void InitParameters(BigNumber& N, BigNumber& g);
+
+    /**
+     * @brief Generate a random salt and compute the verifier from the stored password hash
+     *
+     * @param rI sha_pass_hash as stored in the account table
+     * @param N
+     * @param g
+     * @param s receives the new salt
+     * @param v receives the verifier
+     */
+    void MakeVerifier(std::string const& rI, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& v);
+
+    /**
+     * @brief Generate the server private value b and public ephemeral B
+     *
+     * @param N
+     * @param g
+     * @param v
+     * @param b
+     * @param B
+     */
+    void MakeServerEphemeral(BigNumber& N, BigNumber& g, BigNumber& v, BigNumber& b, BigNumber& B);
+
+    /**
+     * @brief Compute the session key from the client ephemeral
+     *
+     * @param A
+     * @param N
+     * @param v
+     * @param b
+     * @param B
+     * @param K receives the 40 byte session key
+     */
+    void MakeSessionKey(BigNumber& A, BigNumber& N, BigNumber& v, BigNumber& b, BigNumber& B, BigNumber& K);
+
+    /**
+     * @brief Derive the 40 byte session key from the shared secret S
+     *
+     * @param S
+     * @param K
+     */
+    void InterleaveSessionKey(BigNumber& S, BigNumber& K);
+
+    /**
+     * @brief Compute the M1 proof both sides are expected to agree on
+     *
+     * @param login
+     * @param N
+     * @param g
+     * @param s
+     * @param A
+     * @param B
+     * @param K
+     * @param M receives the proof
+     */
+    void MakeClientProof(std::string const& login, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& A, BigNumber& B, BigNumber& K, BigNumber& M);
+
+    /**
+     * @brief Client half of the handshake, as done by the game client
+     *
+     * Used by the load test tools, the server never calls this.
+     *
+     * @param login
+     * @param passDigest SHA1 of "LOGIN:PASSWORD", 20 bytes
+     * @param N
+     * @param g
+     * @param s salt sent by the server
+     * @param B server public ephemeral
+     * @param A receives the client public ephemeral
+     * @param K receives the session key
+     * @param M1 receives the client proof
+     */
+    void MakeClientSession(std::string const& login, uint8 const* passDigest, BigNumber& N, BigNumber& g, BigNumber& s,
+                           BigNumber& B, BigNumber& A, BigNumber& K, BigNumber& M1);
+
+    /**
+     * @brief Write a number zero padded to size bytes, the way it goes on the wire
+     *
+     * AsByteArray(minSize) pads on the wrong end for short values.
+     *
+     * @param bn
+     * @param out
+     * @param size
+     */
+    void PackBytes(BigNumber& bn, uint8* out, int size);
+
+    /**
+     * @brief Verify the client logon proof and build the server proof
+     *
+     * @param login
+     * @param N
+     * @param g
+     * @param s
+     * @param v
+     * @param b
+     * @param B
+     * @param A 32 bytes as received from the client
+     * @param M1 20 bytes as received from the client
+     * @param K receives the session key
+     * @param M2 receives the server proof, only valid for PROOF_OK
+     * @return ProofResult
+     */
+    ProofResult CheckClientProof(std::string const& login, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& v,
+                                 BigNumber& b, BigNumber& B, uint8 const* A, uint8 const* M1, BigNumber& K, Sha1Hash& M2);
+}
+
+#endif
+/// @}
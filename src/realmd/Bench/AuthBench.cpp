@@ -0,0 +1,379 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+/** \file
+    \ingroup realmd
+    \brief Drives simulated logons through AuthWorkerPool against an in-memory account table.
+
+    Every logon runs the server challenge, a simulated client proof and the
+    server proof check, each as an AuthTask. Database round trips are replaced
+    by a configurable sleep so the effect of moving them off the reactor thread
+    shows up without a MySQL server.
+
+    Usage: realmd-bench [logons=5000] [db latency us=500] [max workers=8] [in flight=256]
+*/
+
+#include "Common.h"
+#include "Auth/AuthWorkerPool.h"
+#include "Auth/LogonSRP6.h"
+
+#include <ace/Reactor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+namespace
+{
+    /**
+     * @brief Stand-in for the account table, each access pays the configured latency
+     *
+     */
+    class StandInAccountDB
+    {
+        public:
+            StandInAccountDB(uint32 accounts, uint32 latencyUs) : m_latency(latencyUs)
+            {
+                for (uint32 i = 0; i < accounts; ++i)
+                {
+                    std::string login = AccountName(i);
+
+                    Sha1Hash sha;
+                    sha.UpdateData(login + ":" + login);
+                    sha.Finalize();
+
+                    // sha_pass_hash is the digest written out byte by byte
+                    Account& account = m_accounts[login];
+                    char hex[SHA_DIGEST_LENGTH * 2 + 1];
+                    for (int j = 0; j < SHA_DIGEST_LENGTH; ++j)
+                    {
+                        snprintf(&hex[j * 2], 3, "%02X", sha.GetDigest()[j]);
+                    }
+                    account.passHash = hex;
+                    memcpy(account.digest, sha.GetDigest(), SHA_DIGEST_LENGTH);
+                }
+            }
+
+            static std::string AccountName(uint32 index)
+            {
+                char name[32];
+                snprintf(name, sizeof(name), "BENCH%u", index);
+                return name;
+            }
+
+            /**
+             * @brief Fetch the stored verifier, creating it like the first real logon would
+             *
+             * @param login
+             * @param N
+             * @param g
+             * @param s
+             * @param v
+             */
+            void LoadVerifier(std::string const& login, BigNumber& N, BigNumber& g, BigNumber& s, BigNumber& v)
+            {
+                Wait(3);                                    // ip_banned, account, account_banned
+
+                std::string passHash;
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    Account& account = m_accounts[login];
+                    if (!account.s.empty())
+                    {
+                        s.SetHexStr(account.s.c_str());
+                        v.SetHexStr(account.v.c_str());
+                        return;
+                    }
+                    passHash = account.passHash;
+                }
+
+                LogonSRP6::MakeVerifier(passHash, N, g, s, v);
+                Wait(1);                                    // UPDATE account SET v, s
+
+                const char* v_hex = v.AsHexStr();
+                const char* s_hex = s.AsHexStr();
+                {
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    Account& account = m_accounts[login];
+                    account.v = v_hex;
+                    account.s = s_hex;
+                }
+                OPENSSL_free((void*)v_hex);
+                OPENSSL_free((void*)s_hex);
+            }
+
+            /**
+             * @brief Password digest the simulated client logs in with
+             *
+             * @param login
+             * @return const uint8
+             */
+            uint8 const* GetPasswordDigest(std::string const& login)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                return m_accounts[login].digest;
+            }
+
+            void Wait(uint32 roundTrips) const
+            {
+                if (m_latency)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(m_latency * roundTrips));
+                }
+            }
+
+        private:
+            struct Account
+            {
+                std::string passHash;
+                uint8 digest[SHA_DIGEST_LENGTH];
+                std::string s;
+                std::string v;
+            };
+
+            std::mutex m_lock;
+            std::map<std::string, Account> m_accounts;
+            uint32 m_latency;
+    };
+
+    /**
+     * @brief State of one simulated logon, shared by its three tasks
+     *
+     */
+    struct BenchLogon
+    {
+        std::string login;
+        BigNumber s, v, b, B;
+        uint8 A[32];
+        uint8 M1[20];
+    };
+
+    /**
+     * @brief Owns the bookkeeping of one run, only touched on the reactor thread
+     *
+     */
+    struct BenchRun
+    {
+        StandInAccountDB* db;
+        BigNumber N, g;
+        uint32 accounts;
+        uint32 started;
+        uint32 finished;
+        uint32 failed;
+        uint32 total;
+        std::vector<AuthTask*> ready;
+
+        void StartLogon();
+    };
+
+    class ServerProofTask : public AuthTask
+    {
+        public:
+            ServerProofTask(BenchRun& run, BenchLogon* logon) : m_run(run), m_logon(logon), N(run.N), g(run.g), m_ok(false) {}
+            ~ServerProofTask() { delete m_logon; }
+
+            void Execute() override
+            {
+                BigNumber K;
+                Sha1Hash M2;
+                m_ok = LogonSRP6::CheckClientProof(m_logon->login, N, g, m_logon->s, m_logon->v, m_logon->b, m_logon->B,
+                                                   m_logon->A, m_logon->M1, K, M2) == LogonSRP6::PROOF_OK;
+                m_run.db->Wait(1);                          // UPDATE account SET sessionkey
+            }
+
+            void Complete() override
+            {
+                ++m_run.finished;
+                if (!m_ok)
+                {
+                    ++m_run.failed;
+                }
+
+                m_run.StartLogon();
+            }
+
+        private:
+            BenchRun& m_run;
+            BenchLogon* m_logon;
+            BigNumber N, g;
+            bool m_ok;
+    };
+
+    /**
+     * @brief The client half of the handshake, computed the way the game client does
+     *
+     */
+    class ClientProofTask : public AuthTask
+    {
+        public:
+            ClientProofTask(BenchRun& run, BenchLogon* logon) : m_run(run), m_logon(logon), N(run.N), g(run.g) {}
+            ~ClientProofTask() { delete m_logon; }
+
+            void Execute() override
+            {
+                BigNumber A, K, M;
+                LogonSRP6::MakeClientSession(m_logon->login, m_run.db->GetPasswordDigest(m_logon->login), N, g,
+                                             m_logon->s, m_logon->B, A, K, M);
+
+                LogonSRP6::PackBytes(A, m_logon->A, sizeof(m_logon->A));
+                LogonSRP6::PackBytes(M, m_logon->M1, sizeof(m_logon->M1));
+            }
+
+            void Complete() override
+            {
+                m_run.ready.push_back(new ServerProofTask(m_run, m_logon));
+                m_logon = NULL;
+            }
+
+        private:
+            BenchRun& m_run;
+            BenchLogon* m_logon;
+            BigNumber N, g;
+    };
+
+    class ServerChallengeTask : public AuthTask
+    {
+        public:
+            ServerChallengeTask(BenchRun& run, BenchLogon* logon) : m_run(run), m_logon(logon), N(run.N), g(run.g) {}
+            ~ServerChallengeTask() { delete m_logon; }
+
+            void Execute() override
+            {
+                m_run.db->LoadVerifier(m_logon->login, N, g, m_logon->s, m_logon->v);
+                LogonSRP6::MakeServerEphemeral(N, g, m_logon->v, m_logon->b, m_logon->B);
+            }
+
+            void Complete() override
+            {
+                m_run.ready.push_back(new ClientProofTask(m_run, m_logon));
+                m_logon = NULL;
+            }
+
+        private:
+            BenchRun& m_run;
+            BenchLogon* m_logon;
+            BigNumber N, g;
+    };
+
+    void BenchRun::StartLogon()
+    {
+        if (started >= total)
+        {
+            return;
+        }
+
+        BenchLogon* logon = new BenchLogon;
+        logon->login = StandInAccountDB::AccountName(started % accounts);
+        ++started;
+
+        ready.push_back(new ServerChallengeTask(*this, logon));
+    }
+
+    /**
+     * @brief Run one batch of logons and print its throughput
+     *
+     * @param workers
+     * @param logons
+     * @param inFlight
+     * @param latencyUs
+     */
+    void RunBench(uint32 workers, uint32 logons, uint32 inFlight, uint32 latencyUs)
+    {
+        // a fresh table each run so every run pays for the same verifier setups
+        uint32 accounts = std::max(1u, logons / 4);
+        StandInAccountDB db(accounts, latencyUs);
+
+        ACE_Reactor reactor;
+        AuthWorkerPool pool;
+
+        BenchRun run;
+        run.db = &db;
+        LogonSRP6::InitParameters(run.N, run.g);
+        run.accounts = accounts;
+        run.started = 0;
+        run.finished = 0;
+        run.failed = 0;
+        run.total = logons;
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+        pool.Start(&reactor, workers);
+
+        for (uint32 i = 0; i < inFlight; ++i)
+        {
+            run.StartLogon();
+        }
+
+        ///- Follow-up tasks are queued instead of scheduled from Complete() so the inline run does not recurse
+        while (run.finished < run.total)
+        {
+            std::vector<AuthTask*> ready;
+            ready.swap(run.ready);
+            for (std::vector<AuthTask*>::iterator itr = ready.begin(); itr != ready.end(); ++itr)
+            {
+                pool.Schedule(*itr);
+            }
+
+            if (workers && run.ready.empty())
+            {
+                ACE_Time_Value timeout(0, 10000);
+                reactor.handle_events(timeout);
+            }
+        }
+
+        pool.Stop();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        printf("%7u %8u %9.3f %11.1f %7u\n", workers, logons, seconds, logons / seconds, run.failed);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 logons = argc > 1 ? uint32(atoi(argv[1])) : 5000;
+    uint32 latencyUs = argc > 2 ? uint32(atoi(argv[2])) : 500;
+    uint32 maxWorkers = argc > 3 ? uint32(atoi(argv[3])) : 8;
+    uint32 inFlight = argc > 4 ? uint32(atoi(argv[4])) : 256;
+
+    if (!logons || !inFlight)
+    {
+        printf("Usage: %s [logons] [db latency us] [max workers] [in flight]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u logons, %u us per simulated query, %u in flight (simulated client math included)\n", logons, latencyUs, inFlight);
+    printf("workers   logons   seconds    logons/s  failed\n");
+
+    ///- 0 workers is the old behaviour, everything on the reactor thread
+    RunBench(0, logons, inFlight, latencyUs);
+    for (uint32 workers = 1; workers <= maxWorkers; workers *= 2)
+    {
+        RunBench(workers, logons, inFlight, latencyUs);
+    }
+
+    return 0;
+}
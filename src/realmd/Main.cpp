@@ -33,6 +33,7 @@
 #include "Config/Config.h"
 #include "Log.h"
 #include "Auth/AuthSocket.h"
+#include "Auth/AuthWorkerPool.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "Util.h"
@@ -287,6 +288,12 @@ extern int main(int argc, char** argv)
         return 1;
     }
 
+    ///- Start the threads running logon database lookups and SRP6 math off the reactor
+    uint32 authWorkers = sConfig.GetIntDefault("AuthWorkerThreads", 2);
+    sAuthWorkerPool.Start(ACE_Reactor::instance(), authWorkers,
+                          []() { LoginDatabase.ThreadStart(); }, []() { LoginDatabase.ThreadEnd(); });
+    sLog.outString("Auth worker threads: %u", authWorkers);
+
     ///- Catch termination signals
     HookSignals();
 
@@ -377,6 +384,9 @@ extern int main(int argc, char** argv)
 #endif
     }
 
+    ///- Join the logon workers before the database goes away
+    sAuthWorkerPool.Stop();
+
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -417,9 +427,11 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    ///- One synchronous connection per auth worker plus one for the reactor thread
+    int nConnections = sConfig.GetIntDefault("AuthWorkerThreads", 2) + 1;
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Can not connect to database");
         return false;
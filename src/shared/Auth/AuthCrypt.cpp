@@ -37,6 +37,16 @@ AuthCrypt::~AuthCrypt()
 }
 
 void AuthCrypt::Init(BigNumber* K)
+{
+    InitKeys(K, false);
+}
+
+void AuthCrypt::InitClient(BigNumber* K)
+{
+    InitKeys(K, true);
+}
+
+void AuthCrypt::InitKeys(BigNumber* K, bool clientSide)
 {
     uint8 ServerEncryptionKey[SEED_KEY_SIZE] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
 
@@ -49,9 +59,10 @@ void AuthCrypt::Init(BigNumber* K)
     uint8* decryptHash = clientDecryptHmac.ComputeHash(K);
 
     // SARC4 _serverDecrypt(encryptHash);
-    _clientDecrypt.Init(decryptHash);
-    _serverEncrypt.Init(encryptHash);
     // SARC4 _clientEncrypt(decryptHash);
+    // ARC4 is symmetric, a client decrypts with the server encryption key and the other way round
+    _clientDecrypt.Init(clientSide ? encryptHash : decryptHash);
+    _serverEncrypt.Init(clientSide ? decryptHash : encryptHash);
 
     uint8 syncBuf[1024];
 
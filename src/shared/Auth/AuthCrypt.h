@@ -54,6 +54,14 @@ class AuthCrypt
          *
          */
         void Init(BigNumber* K);
+        /**
+         * @brief Same keys with the directions swapped, for tools that talk to the server as a client
+         *
+         * EncryptSend() then encrypts client packets and DecryptRecv() decrypts server packets.
+         *
+         * @param K
+         */
+        void InitClient(BigNumber* K);
         /**
          * @brief
          *
@@ -77,6 +85,14 @@ class AuthCrypt
         bool IsInitialized() { return _initialized; }
 
     private:
+        /**
+         * @brief
+         *
+         * @param K
+         * @param clientSide
+         */
+        void InitKeys(BigNumber* K, bool clientSide);
+
         ARC4 _clientDecrypt;
         ARC4 _serverEncrypt;
         bool _initialized; /**< TODO */
@@ -27,6 +27,8 @@
 
 #include "Utilities/LinkedReference/RefManager.h"
 
+#include <vector>
+
 template<class OBJECT> class GridReference;
 
 template<class OBJECT>
@@ -88,5 +90,112 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
          * @return iterator
          */
         iterator rend() { return iterator(nullptr); }
+
+        /**
+         * @brief Number of objects in the contiguous slot storage, equals getSize()
+         *
+         * @return size_t
+         */
+        size_t getSlotCount() const { return m_slotRefs.size(); }
+        /**
+         * @brief Object stored in the given slot, slots are reordered by removals
+         *
+         * @param slot
+         * @return OBJECT
+         */
+        OBJECT* getSlotObject(size_t slot) const { return m_slotRefs[slot]->getSource(); }
+
+        /**
+         * @brief Calls worker(OBJECT*) for every object whose cached position lies
+         * within radius (2D) of the given point.
+         *
+         * Only the packed position arrays are read for the range test, so objects
+         * out of range are never dereferenced. The worker may relocate objects and
+         * add objects to or remove objects from this cell. Objects added meanwhile
+         * are visited as well. Removing the visited object is safe, but removing an
+         * object that was already visited moves an unvisited one into the visited
+         * slots, which is then skipped.
+         *
+         * @param x
+         * @param y
+         * @param radius
+         * @param worker
+         */
+        template<class WORKER>
+        void visitInRange(float x, float y, float radius, WORKER& worker)
+        {
+            float const radiusSq = radius * radius;
+            for (size_t i = 0; i < m_slotRefs.size();)
+            {
+                float dx = m_slotX[i] - x;
+                float dy = m_slotY[i] - y;
+                if (dx * dx + dy * dy <= radiusSq)
+                {
+                    GridReference<OBJECT>* ref = m_slotRefs[i];
+                    worker(ref->getSource());
+
+                    // the visited object left the cell, the last slot took its place
+                    if (i < m_slotRefs.size() && m_slotRefs[i] != ref)
+                    {
+                        continue;
+                    }
+                }
+                ++i;
+            }
+        }
+
+    private:
+        friend class GridReference<OBJECT>;
+
+        /**
+         * @brief Appends a linked reference to the slot storage
+         *
+         * @param ref
+         * @param x
+         * @param y
+         * @return size_t the slot of the reference
+         */
+        size_t addSlot(GridReference<OBJECT>* ref, float x, float y)
+        {
+            m_slotRefs.push_back(ref);
+            m_slotX.push_back(x);
+            m_slotY.push_back(y);
+            return m_slotRefs.size() - 1;
+        }
+        /**
+         * @brief Removes a slot by moving the last one into its place
+         *
+         * @param slot
+         */
+        void removeSlot(size_t slot)
+        {
+            size_t last = m_slotRefs.size() - 1;
+            if (slot != last)
+            {
+                m_slotRefs[slot] = m_slotRefs[last];
+                m_slotX[slot] = m_slotX[last];
+                m_slotY[slot] = m_slotY[last];
+                m_slotRefs[slot]->setSlot(slot);
+            }
+            m_slotRefs.pop_back();
+            m_slotX.pop_back();
+            m_slotY.pop_back();
+        }
+        /**
+         * @brief
+         *
+         * @param slot
+         * @param x
+         * @param y
+         */
+        void setSlotPosition(size_t slot, float x, float y)
+        {
+            m_slotX[slot] = x;
+            m_slotY[slot] = y;
+        }
+
+        std::vector<GridReference<OBJECT>*> m_slotRefs; /**< TODO */
+        std::vector<float> m_slotX; /**< cached positions, kept apart from the references for tight range scans */
+        std::vector<float> m_slotY; /**< TODO */
 };
 #endif
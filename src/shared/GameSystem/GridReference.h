@@ -29,6 +29,17 @@
 
 template<class OBJECT> class GridRefManager;
 
+template<class OBJECT>
+/**
+ * @brief Position a grid reference caches in its manager's slot storage
+ *
+ */
+struct GridRefPosition
+{
+    static float X(OBJECT const* obj) { return obj->GetPositionX(); }
+    static float Y(OBJECT const* obj) { return obj->GetPositionY(); }
+};
+
 template<class OBJECT>
 /**
  * @brief
@@ -47,6 +58,7 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             // called from link()
             this->getTarget()->insertFirst(this);
             this->getTarget()->incSize();
+            m_slot = this->getTarget()->addSlot(this, GridRefPosition<OBJECT>::X(this->getSource()), GridRefPosition<OBJECT>::Y(this->getSource()));
         }
 
         /**
@@ -59,6 +71,7 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             if (this->isValid())
             {
                 this->getTarget()->decSize();
+                this->getTarget()->removeSlot(m_slot);
             }
         }
 
@@ -68,7 +81,7 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
          */
         void sourceObjectDestroyLink() override
         {
-            // called from invalidate()
+            // called from invalidate(), only while the manager is destroyed so its slots are already gone
             this->getTarget()->decSize();
         }
 
@@ -78,7 +91,7 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
          *
          */
         GridReference()
-            : Reference<GridRefManager<OBJECT>, OBJECT>()
+            : Reference<GridRefManager<OBJECT>, OBJECT>(), m_slot(0)
         {
         }
 
@@ -100,6 +113,32 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
         {
             return (GridReference*)Reference<GridRefManager<OBJECT>, OBJECT>::next();
         }
+
+        /**
+         * @brief Refreshes the position cached in the cell's slot storage, call after the object moved
+         *
+         * @param x
+         * @param y
+         */
+        void UpdatePosition(float x, float y)
+        {
+            if (this->isValid())
+            {
+                this->getTarget()->setSlotPosition(m_slot, x, y);
+            }
+        }
+
+    private:
+        friend class GridRefManager<OBJECT>;
+
+        /**
+         * @brief
+         *
+         * @param slot
+         */
+        void setSlot(size_t slot) { m_slot = slot; }
+
+        size_t m_slot; /**< index in the target's slot storage while linked */
 };
 
 #endif
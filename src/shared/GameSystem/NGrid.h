@@ -132,6 +132,19 @@ typedef enum
     MAX_GRID_STATE = 4
 } grid_state_t;
 
+template<uint32 N, class ACTIVE_OBJECT, class WORLD_OBJECT_TYPES, class GRID_OBJECT_TYPES> class NGrid;
+
+template<uint32 N, class ACTIVE_OBJECT, class WORLD_OBJECT_TYPES, class GRID_OBJECT_TYPES>
+/**
+ * @brief Grids are linked into their map, which never range scans them
+ *
+ */
+struct GridRefPosition<NGrid<N, ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES> >
+{
+    static float X(NGrid<N, ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES> const* /*grid*/) { return 0.0f; }
+    static float Y(NGrid<N, ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES> const* /*grid*/) { return 0.0f; }
+};
+
 template
 <
 uint32 N,
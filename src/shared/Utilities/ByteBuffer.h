@@ -27,6 +27,7 @@
 
 #include "Common/Common.h"
 #include "Log/Log.h"
+#include "Utilities/ByteBufferPool.h"
 #include "Utilities/ByteConverter.h"
 #include "Utilities/Errors.h"
 
@@ -168,7 +169,7 @@ class ByteBuffer
         // constructor
         ByteBuffer(size_t res): _rpos(0), _wpos(0), _bitpos(8), _curbitval(0)
         {
-            _storage.reserve(res);
+            _storage.reserve(ByteBufferPool::GetBlockSize(res));
         }
 
         // copy constructor
@@ -956,7 +957,7 @@ class ByteBuffer
         {
             if (ressize > size())
             {
-                _storage.reserve(ressize);
+                _storage.reserve(ByteBufferPool::GetBlockSize(ressize));
             }
         }
 
@@ -1168,7 +1169,7 @@ class ByteBuffer
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
-        std::vector<uint8> _storage; /**< TODO */
+        std::vector<uint8, ByteBufferAllocator<uint8> > _storage; /**< drawn from the calling thread's ByteBufferPool cache */
 };
 
 template <typename T>
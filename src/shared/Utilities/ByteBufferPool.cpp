@@ -0,0 +1,244 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "ByteBufferPool.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <set>
+
+namespace
+{
+    // bytes one thread keeps per size class, small classes hold more blocks
+    const size_t CACHE_BYTES_PER_CLASS = 128 * 1024;
+    const uint32 MIN_CACHED_BLOCKS = 8;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    uint32 GetSizeClass(size_t size)
+    {
+        uint32 index = 0;
+        for (size_t block = ByteBufferPool::MIN_BLOCK_SIZE; block < size; block <<= 1)
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    // counters are only written by the owning thread, a plain load and store keeps them off the bus lock
+    void Add(std::atomic<uint64>& counter, int64 value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    class ThreadCache;
+
+    /**
+     * @brief Live thread caches and the counters of threads that already ended
+     *
+     */
+    struct Registry
+    {
+        Registry() : allocations(0), reused(0), oversized(0), released(0) {}
+
+        ACE_Thread_Mutex lock; /**< guards every member below */
+        std::set<ThreadCache*> caches; /**< caches of the threads still running */
+        uint64 allocations; /**< allocations of the ended threads */
+        uint64 reused; /**< reused blocks of the ended threads */
+        uint64 oversized; /**< oversized requests of the ended threads */
+        uint64 released; /**< released blocks of the ended threads */
+    };
+
+    // never destroyed, packets may still be freed while static objects are torn down
+    Registry& GetRegistry()
+    {
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+
+    /**
+     * @brief Free lists and counters of one thread
+     *
+     */
+    class ThreadCache
+    {
+        public:
+            ThreadCache() : allocations(0), reused(0), oversized(0), released(0), cachedBlocks(0), cachedBytes(0)
+            {
+                for (uint32 i = 0; i < ByteBufferPool::SIZE_CLASSES; ++i)
+                {
+                    m_free[i] = NULL;
+                    m_count[i] = 0;
+                    m_limit[i] = std::max(MIN_CACHED_BLOCKS, uint32(CACHE_BYTES_PER_CLASS / (ByteBufferPool::MIN_BLOCK_SIZE << i)));
+                }
+
+                Registry& registry = GetRegistry();
+                ACE_Guard<ACE_Thread_Mutex> guard(registry.lock);
+                registry.caches.insert(this);
+            }
+
+            ~ThreadCache()
+            {
+                for (uint32 i = 0; i < ByteBufferPool::SIZE_CLASSES; ++i)
+                {
+                    while (FreeBlock* block = m_free[i])
+                    {
+                        m_free[i] = block->next;
+                        free(block);
+                    }
+                }
+
+                Registry& registry = GetRegistry();
+                ACE_Guard<ACE_Thread_Mutex> guard(registry.lock);
+                registry.caches.erase(this);
+                registry.allocations += allocations.load(std::memory_order_relaxed);
+                registry.reused += reused.load(std::memory_order_relaxed);
+                registry.oversized += oversized.load(std::memory_order_relaxed);
+                registry.released += released.load(std::memory_order_relaxed);
+            }
+
+            void* Allocate(uint32 sizeClass)
+            {
+                Add(allocations, 1);
+
+                if (FreeBlock* block = m_free[sizeClass])
+                {
+                    m_free[sizeClass] = block->next;
+                    --m_count[sizeClass];
+                    Add(reused, 1);
+                    Add(cachedBlocks, -1);
+                    Add(cachedBytes, -int64(ByteBufferPool::MIN_BLOCK_SIZE << sizeClass));
+                    return block;
+                }
+
+                void* ptr = malloc(ByteBufferPool::MIN_BLOCK_SIZE << sizeClass);
+                if (!ptr)
+                {
+                    throw std::bad_alloc();
+                }
+                return ptr;
+            }
+
+            void Deallocate(void* ptr, uint32 sizeClass)
+            {
+                if (m_count[sizeClass] >= m_limit[sizeClass])
+                {
+                    free(ptr);
+                    Add(released, 1);
+                    return;
+                }
+
+                FreeBlock* block = static_cast<FreeBlock*>(ptr);
+                block->next = m_free[sizeClass];
+                m_free[sizeClass] = block;
+                ++m_count[sizeClass];
+                Add(cachedBlocks, 1);
+                Add(cachedBytes, int64(ByteBufferPool::MIN_BLOCK_SIZE << sizeClass));
+            }
+
+            std::atomic<uint64> allocations; /**< requests served from a size class */
+            std::atomic<uint64> reused; /**< of those, taken from a free list */
+            std::atomic<uint64> oversized; /**< requests larger than ByteBufferPool::MAX_BLOCK_SIZE */
+            std::atomic<uint64> released; /**< blocks freed because their free list was full */
+            std::atomic<uint64> cachedBlocks; /**< blocks held in the free lists */
+            std::atomic<uint64> cachedBytes; /**< bytes of the blocks held in the free lists */
+
+        private:
+            FreeBlock* m_free[ByteBufferPool::SIZE_CLASSES]; /**< head of the free list per size class */
+            uint32 m_count[ByteBufferPool::SIZE_CLASSES]; /**< blocks in each free list */
+            uint32 m_limit[ByteBufferPool::SIZE_CLASSES]; /**< most blocks each free list keeps */
+    };
+
+    ThreadCache& GetThreadCache()
+    {
+        static ACE_TSS<ThreadCache>* cache = new ACE_TSS<ThreadCache>();
+        return **cache;
+    }
+}
+
+void* ByteBufferPool::Allocate(size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        Add(GetThreadCache().oversized, 1);
+
+        void* ptr = malloc(size);
+        if (!ptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    return GetThreadCache().Allocate(GetSizeClass(size));
+}
+
+void ByteBufferPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    if (size > MAX_BLOCK_SIZE)
+    {
+        free(ptr);
+        return;
+    }
+
+    GetThreadCache().Deallocate(ptr, GetSizeClass(size));
+}
+
+void ByteBufferPool::GetStats(Stats& stats)
+{
+    Registry& registry = GetRegistry();
+    ACE_Guard<ACE_Thread_Mutex> guard(registry.lock);
+
+    stats.allocations = registry.allocations;
+    stats.reused = registry.reused;
+    stats.oversized = registry.oversized;
+    stats.released = registry.released;
+    stats.cachedBlocks = 0;
+    stats.cachedBytes = 0;
+    stats.threads = uint32(registry.caches.size());
+
+    for (std::set<ThreadCache*>::const_iterator itr = registry.caches.begin(); itr != registry.caches.end(); ++itr)
+    {
+        stats.allocations += (*itr)->allocations.load(std::memory_order_relaxed);
+        stats.reused += (*itr)->reused.load(std::memory_order_relaxed);
+        stats.oversized += (*itr)->oversized.load(std::memory_order_relaxed);
+        stats.released += (*itr)->released.load(std::memory_order_relaxed);
+        stats.cachedBlocks += (*itr)->cachedBlocks.load(std::memory_order_relaxed);
+        stats.cachedBytes += (*itr)->cachedBytes.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2022 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_BYTEBUFFERPOOL
+#define MANGOS_H_BYTEBUFFERPOOL
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+
+/**
+ * @brief Size class pool for packet storage
+ *
+ * Requests up to MAX_BLOCK_SIZE bytes are rounded up to a power of two and
+ * served from a free list of the calling thread, freed blocks go back to the
+ * free list of the thread that frees them. A packet built in a map thread and
+ * released by a network thread therefore refills the network thread cache;
+ * every list is capped and blocks beyond the cap are returned to the heap.
+ * Larger requests bypass the pool.
+ */
+class ByteBufferPool
+{
+    public:
+        static const size_t MIN_BLOCK_SIZE = 64;
+        static const size_t MAX_BLOCK_SIZE = 16384;
+        static const uint32 SIZE_CLASSES = 9;           // 64 .. 16384
+
+        /**
+         * @brief Counters summed over all threads since start
+         *
+         */
+        struct Stats
+        {
+            uint64 allocations; /**< requests served from a size class */
+            uint64 reused; /**< of those, taken from a free list */
+            uint64 oversized; /**< requests larger than MAX_BLOCK_SIZE */
+            uint64 released; /**< blocks handed back to the heap because a free list was full */
+            uint64 cachedBlocks; /**< blocks currently held in free lists */
+            uint64 cachedBytes; /**< bytes of the blocks currently held in free lists */
+            uint32 threads; /**< threads owning a cache */
+        };
+
+        /**
+         * @brief
+         *
+         * @param size
+         * @return void
+         */
+        static void* Allocate(size_t size);
+        /**
+         * @brief
+         *
+         * @param ptr
+         * @param size the size passed to Allocate
+         */
+        static void Deallocate(void* ptr, size_t size);
+
+        /**
+         * @brief Size of the block Allocate would hand out, reserving it avoids growing into the next class
+         *
+         * @param size
+         * @return size_t
+         */
+        static size_t GetBlockSize(size_t size)
+        {
+            if (!size || size > MAX_BLOCK_SIZE)
+            {
+                return size;
+            }
+
+            size_t block = MIN_BLOCK_SIZE;
+            while (block < size)
+            {
+                block <<= 1;
+            }
+            return block;
+        }
+
+        /**
+         * @brief
+         *
+         * @param stats
+         */
+        static void GetStats(Stats& stats);
+};
+
+/**
+ * @brief std allocator drawing from ByteBufferPool
+ *
+ */
+template<class T>
+class ByteBufferAllocator
+{
+    public:
+        typedef T value_type;
+
+        ByteBufferAllocator() {}
+        template<class U> ByteBufferAllocator(ByteBufferAllocator<U> const&) {}
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(ByteBufferPool::Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+            ByteBufferPool::Deallocate(ptr, n * sizeof(T));
+        }
+
+        template<class U> bool operator==(ByteBufferAllocator<U> const&) const { return true; }
+        template<class U> bool operator!=(ByteBufferAllocator<U> const&) const { return false; }
+};
+
+#endif
@@ -70,7 +70,7 @@ class WorldPacket : public ByteBuffer
         void Initialize(Opcodes opcode, size_t newres = 200)
         {
             clear();
-            _storage.reserve(newres);
+            _storage.reserve(ByteBufferPool::GetBlockSize(newres));
             m_opcode = opcode;
         }
 
@@ -22,6 +22,8 @@
  * and lore are copyrighted by Blizzard Entertainment, Inc.
  */
 
+#include <thread>
+
 #include <DetourNavMeshBuilder.h>
 #include <DetourCommon.h>
 
@@ -31,13 +33,16 @@
 #include "MapTree.h"
 #include "ModelInstance.h"
 
+#include "Utilities/Timer.h"
+
 using namespace VMAP;
 
 namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath,
+                           uint32 threads) :
         m_terrainBuilder(NULL),
         m_debugOutput(debugOutput),
         m_skipContinents(skipContinents),
@@ -46,7 +51,10 @@ namespace MMAP
         m_maxWalkableAngle(maxWalkableAngle),
         m_bigBaseUnit(bigBaseUnit),
         m_rcContext(NULL),
-        m_offMeshFilePath(offMeshFilePath)
+        m_offMeshFilePath(offMeshFilePath),
+        m_threads(threads ? threads : 1),
+        m_tilesDone(0),
+        m_tilesTotal(0)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -152,14 +160,17 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildAllMaps()
     {
+        vector<uint32> mapIDs;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
             {
-                buildMap(mapID);
+                mapIDs.push_back(mapID);
             }
         }
+
+        buildMaps(mapIDs);
     }
 
     /**************************************************************************/
@@ -180,16 +191,88 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
     {
-        printf("Building map %03u:\n", mapID);
+        buildMaps(vector<uint32>(1, mapID));
+    }
 
-        set<uint32>* tiles = getTileList(mapID);
+    /**************************************************************************/
+    void MapBuilder::buildMaps(const vector<uint32>& mapIDs)
+    {
+        // jobs own a mutex, so keep them at a stable address
+        vector<MapBuildJob*> jobs;
+        vector<TileJob> queue;
+
+        for (vector<uint32>::const_iterator it = mapIDs.begin(); it != mapIDs.end(); ++it)
+        {
+            MapBuildJob* job = new MapBuildJob();
+            job->mapID = *it;
+
+            if (!prepareMapJob(*job))
+            {
+                delete job;
+                continue;
+            }
+
+            jobs.push_back(job);
+            for (size_t i = 0; i < job->tiles.size(); ++i)
+            {
+                queue.push_back(TileJob(job, i));
+            }
+        }
+
+        if (queue.empty())
+        {
+            return;
+        }
+
+        m_tilesDone = 0;
+        m_tilesTotal = uint32(queue.size());
+
+        uint32 threadCount = m_threads;
+        if (threadCount > m_tilesTotal)
+        {
+            threadCount = m_tilesTotal;
+        }
+
+        printf("Building %u tiles of %u maps using %u threads\n", m_tilesTotal, uint32(jobs.size()), threadCount);
+        uint32 startTime = getMSTime();
+
+        // every worker, including this thread, takes the next unclaimed tile from the
+        // shared queue, so threads that get cheap tiles simply pick up more of them
+        std::atomic<size_t> cursor(0);
+        vector<std::thread> workers;
+        for (uint32 i = 1; i < threadCount; ++i)
+        {
+            workers.push_back(std::thread(&MapBuilder::tileWorker, this, &queue, &cursor));
+        }
+
+        tileWorker(&queue, &cursor);
+
+        for (vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            it->join();
+        }
+
+        for (vector<MapBuildJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it)
+        {
+            delete *it;
+        }
+
+        printf("Built %u tiles in %u s\n\n", m_tilesTotal, GetMSTimeDiffToNow(startTime) / IN_MILLISECONDS);
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::prepareMapJob(MapBuildJob& job)
+    {
+        printf("Building map %03u:\n", job.mapID);
+
+        set<uint32>* tiles = getTileList(job.mapID);
 
         // make sure we process maps which don't have tiles
         if (!tiles->size())
         {
             // convert coord bounds to grid bounds
             uint32 minX, minY, maxX, maxY;
-            getGridBounds(mapID, minX, minY, maxX, maxY);
+            getGridBounds(job.mapID, minX, minY, maxX, maxY);
 
             // add all tiles within bounds to tile list.
             for (uint32 i = minX; i <= maxX; ++i)
@@ -201,19 +284,19 @@ namespace MMAP
 
         if (!tiles->size())
         {
-            return;
+            return false;
         }
 
         // build navMesh
-        dtNavMesh* navMesh = NULL;
-        buildNavMesh(mapID, navMesh);
-        if (!navMesh)
+        buildNavMesh(job.mapID, job.navMesh);
+        if (!job.navMesh)
         {
             printf("Failed creating navmesh!              \n");
-            return;
+            return false;
         }
 
-        // now start building mmtiles for each tile
+        job.navMeshParams = *job.navMesh->getParams();
+
         printf("We have %u tiles.                          \n", (unsigned int)tiles->size());
         for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
         {
@@ -222,20 +305,102 @@ namespace MMAP
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
+            if (shouldSkipTile(job.mapID, tileX, tileY))
             {
                 continue;
             }
 
-            buildTile(mapID, tileX, tileY, navMesh);
+            job.tiles.push_back(*it);
         }
 
-        dtFreeNavMesh(navMesh);
+        if (job.tiles.empty())
+        {
+            dtFreeNavMesh(job.navMesh);
+            job.navMesh = NULL;
+            printf("Complete!                               \n\n");
+            return false;
+        }
+
+        job.results.resize(job.tiles.size());
+        return true;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::tileWorker(const vector<TileJob>* queue, std::atomic<size_t>* cursor)
+    {
+        for (size_t i = (*cursor)++; i < queue->size(); i = (*cursor)++)
+        {
+            MapBuildJob& job = *(*queue)[i].map;
+            size_t index = (*queue)[i].index;
+
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(job.tiles[index], tileX, tileY);
+
+            uint32 tileStartTime = getMSTime();
+
+            unsigned char* navData = NULL;
+            int navDataSize = 0;
+            buildTileData(job.mapID, tileX, tileY, job.navMeshParams, navData, navDataSize);
+
+            uint32 done = ++m_tilesDone;
+            printf("[%u/%u] Map %03u, tile [%02u,%02u] done in %u ms\n", done, m_tilesTotal,
+                   job.mapID, tileX, tileY, GetMSTimeDiffToNow(tileStartTime));
 
-        printf("Complete!                               \n\n");
+            commitTile(job, index, navData, navDataSize);
+        }
     }
+
+    /**************************************************************************/
+    void MapBuilder::commitTile(MapBuildJob& job, size_t index, unsigned char* navData, int navDataSize)
+    {
+        std::lock_guard<std::mutex> guard(job.commitLock);
+
+        TileBuildResult& result = job.results[index];
+        result.navData = navData;
+        result.navDataSize = navDataSize;
+        result.built = true;
+
+        // tiles are written in tile list order, the tile refs stored in the
+        // output depend on what was added to the navmesh before
+        while (job.nextCommit < job.results.size() && job.results[job.nextCommit].built)
+        {
+            TileBuildResult& next = job.results[job.nextCommit];
+            if (next.navData)
+            {
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(job.tiles[job.nextCommit], tileX, tileY);
+                saveMoveMapTile(job.mapID, tileX, tileY, next.navData, next.navDataSize, job.navMesh);
+                next.navData = NULL;
+            }
+
+            ++job.nextCommit;
+        }
+
+        if (job.nextCommit == job.results.size() && job.navMesh)
+        {
+            dtFreeNavMesh(job.navMesh);
+            job.navMesh = NULL;
+            printf("Map %03u complete!                        \n", job.mapID);
+        }
+    }
+
     /**************************************************************************/
     void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
+        unsigned char* navData = NULL;
+        int navDataSize = 0;
+        buildTileData(mapID, tileX, tileY, *navMesh->getParams(), navData, navDataSize);
+
+        if (navData)
+        {
+            saveMoveMapTile(mapID, tileX, tileY, navData, navDataSize, navMesh);
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::buildTileData(uint32 mapID, uint32 tileX, uint32 tileY,
+                                   const dtNavMeshParams& navMeshParams,
+                                   unsigned char*& navData, int& navDataSize)
     {
         printf("Building map %03u, tile [%02u,%02u]\n", mapID, tileX, tileY);
 
@@ -274,7 +439,7 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMeshParams, navData, navDataSize);
     }
 
     /**************************************************************************/
@@ -401,6 +566,7 @@ namespace MMAP
         if (!file)
         {
             dtFreeNavMesh(navMesh);
+            navMesh = NULL;
             char message[1024];
             sprintf(message, "Failed to open %s for writing!\n", fileName);
             perror(message);
@@ -415,7 +581,8 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                       MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+                                      const dtNavMeshParams& navMeshParams,
+                                      unsigned char*& navData, int& navDataSize)
     {
         // console output
         char tileString[10];
@@ -678,8 +845,8 @@ namespace MMAP
         params.walkableHeight = BASE_UNIT_DIM * config.walkableHeight;  // agent height
         params.walkableRadius = BASE_UNIT_DIM * config.walkableRadius;  // agent radius
         params.walkableClimb = BASE_UNIT_DIM * config.walkableClimb;    // keep less that walkableHeight (aka agent height)!
-        params.tileX = (((bmin[0] + bmax[0]) / 2) - navMesh->getParams()->orig[0]) / GRID_SIZE;
-        params.tileY = (((bmin[2] + bmax[2]) / 2) - navMesh->getParams()->orig[2]) / GRID_SIZE;
+        params.tileX = (((bmin[0] + bmax[0]) / 2) - navMeshParams.orig[0]) / GRID_SIZE;
+        params.tileY = (((bmin[2] + bmax[2]) / 2) - navMeshParams.orig[2]) / GRID_SIZE;
         rcVcopy(params.bmin, bmin);
         rcVcopy(params.bmax, bmax);
         params.cs = config.cs;
@@ -688,8 +855,8 @@ namespace MMAP
         params.buildBvTree = true;
 
         // will hold final navmesh
-        unsigned char* navData = NULL;
-        int navDataSize = 0;
+        navData = NULL;
+        navDataSize = 0;
 
         do
         {
@@ -731,44 +898,10 @@ namespace MMAP
             if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
             {
                 printf(" Failed building navmesh tile - %s           \n", tileString);
+                navData = NULL;
+                navDataSize = 0;
                 continue;
             }
-
-            dtTileRef tileRef = 0;
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
-            if (!tileRef || dtStatusFailed(dtResult))
-            {
-                printf(" Failed adding tile %s to navmesh !           \n", tileString);
-                continue;
-            }
-
-            // file output
-            char fileName[255];
-            sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
-            FILE* file = fopen(fileName, "wb");
-            if (!file)
-            {
-                char message[1024];
-                sprintf(message, "Failed to open %s for writing!\n", fileName);
-                perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
-                continue;
-            }
-
-            // write header
-            MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
-            header.size = uint32(navDataSize);
-            fwrite(&header, sizeof(MmapTileHeader), 1, file);
-
-            // write data
-            fwrite(navData, sizeof(unsigned char), navDataSize, file);
-            fclose(file);
-
-            // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
         }
         while (0);
 
@@ -787,6 +920,52 @@ namespace MMAP
         }
     }
 
+    /**************************************************************************/
+    void MapBuilder::saveMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+                                     unsigned char* navData, int navDataSize,
+                                     dtNavMesh* navMesh)
+    {
+        char tileString[10];
+        sprintf(tileString, "[%02i,%02i]: ", tileX, tileY);
+
+        dtTileRef tileRef = 0;
+        // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
+        // is removed via removeTile()
+        dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+        if (!tileRef || dtStatusFailed(dtResult))
+        {
+            printf(" Failed adding tile %s to navmesh !           \n", tileString);
+            dtFree(navData);
+            return;
+        }
+
+        // file output
+        char fileName[255];
+        sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "Failed to open %s for writing!\n", fileName);
+            perror(message);
+            navMesh->removeTile(tileRef, NULL, NULL);
+            return;
+        }
+
+        // write header
+        MmapTileHeader header;
+        header.usesLiquids = m_terrainBuilder->usesLiquids();
+        header.size = uint32(navDataSize);
+        fwrite(&header, sizeof(MmapTileHeader), 1, file);
+
+        // write data
+        fwrite(navData, sizeof(unsigned char), navDataSize, file);
+        fclose(file);
+
+        // now that tile is written to disk, we can unload it
+        navMesh->removeTile(tileRef, NULL, NULL);
+    }
+
     /**************************************************************************/
     void MapBuilder::getTileBounds(uint32 tileX, uint32 tileY, float* verts, int vertCount, float* bmin, float* bmax)
     {
@@ -28,6 +28,8 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <mutex>
+#include <atomic>
 
 #include <Recast.h>
 #include <DetourNavMesh.h>
@@ -80,6 +82,51 @@ namespace MMAP
         rcPolyMeshDetail* dmesh; /**< TODO */
     };
 
+    /**
+     * @brief navmesh data of one built tile, waiting to be written in serial order
+     *
+     */
+    struct TileBuildResult
+    {
+        TileBuildResult() : navData(NULL), navDataSize(0), built(false) {}
+
+        unsigned char* navData; /**< NULL if the tile produced no navmesh */
+        int navDataSize; /**< TODO */
+        bool built; /**< set once a worker has finished with the tile */
+    };
+
+    /**
+     * @brief per map state shared by the tile workers
+     *
+     * Tiles may finish in any order, but they are added to the navmesh and
+     * written to disk strictly in the order of the tile list, so the output
+     * is the same as a single threaded build.
+     */
+    struct MapBuildJob
+    {
+        MapBuildJob() : mapID(0), navMesh(NULL), nextCommit(0) {}
+
+        uint32 mapID; /**< TODO */
+        dtNavMesh* navMesh; /**< TODO */
+        dtNavMeshParams navMeshParams; /**< copy of the navmesh params, read by workers */
+        vector<uint32> tiles; /**< packed tile ids to build, in serial build order */
+        vector<TileBuildResult> results; /**< TODO */
+        size_t nextCommit; /**< index of the next tile to write */
+        std::mutex commitLock; /**< guards results, nextCommit and navMesh */
+    };
+
+    /**
+     * @brief a single entry of the tile queue
+     *
+     */
+    struct TileJob
+    {
+        TileJob(MapBuildJob* job, size_t idx) : map(job), index(idx) {}
+
+        MapBuildJob* map; /**< TODO */
+        size_t index; /**< index into MapBuildJob::tiles */
+    };
+
     /**
      * @brief
      *
@@ -98,6 +145,7 @@ namespace MMAP
              * @param debugOutput
              * @param bigBaseUnit
              * @param offMeshFilePath
+             * @param threads number of tile worker threads
              */
             MapBuilder(float maxWalkableAngle   = 60.f,
                        bool skipLiquid          = false,
@@ -106,7 +154,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debugOutput         = false,
                        bool bigBaseUnit         = false,
-                       const char* offMeshFilePath = nullptr);
+                       const char* offMeshFilePath = nullptr,
+                       uint32 threads           = 1);
 
             /**
              * @brief
@@ -160,6 +209,39 @@ namespace MMAP
              */
             set<uint32>* getTileList(uint32 mapID);
 
+            /**
+             * @brief builds the tiles of all given maps, spread over the worker threads
+             *
+             * @param mapIDs
+             */
+            void buildMaps(const vector<uint32>& mapIDs);
+
+            /**
+             * @brief creates the navmesh of a map and queues its tiles
+             *
+             * @param job
+             * @return bool false if there is nothing to build
+             */
+            bool prepareMapJob(MapBuildJob& job);
+
+            /**
+             * @brief worker loop, takes tiles from the queue until it is empty
+             *
+             * @param queue
+             * @param cursor
+             */
+            void tileWorker(const vector<TileJob>* queue, std::atomic<size_t>* cursor);
+
+            /**
+             * @brief stores a built tile and writes every tile that is now next in order
+             *
+             * @param job
+             * @param index
+             * @param navData
+             * @param navDataSize
+             */
+            void commitTile(MapBuildJob& job, size_t index, unsigned char* navData, int navDataSize);
+
             /**
              * @brief
              *
@@ -168,6 +250,20 @@ namespace MMAP
              */
             void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
+            /**
+             * @brief loads the terrain and model data of a tile and builds its navmesh data
+             *
+             * @param mapID
+             * @param tileX
+             * @param tileY
+             * @param navMeshParams
+             * @param navData NULL if no navmesh was built
+             * @param navDataSize
+             */
+            void buildTileData(uint32 mapID, uint32 tileX, uint32 tileY,
+                               const dtNavMeshParams& navMeshParams,
+                               unsigned char*& navData, int& navDataSize);
+
             /**
              * @brief move map building
              *
@@ -177,7 +273,9 @@ namespace MMAP
              * @param meshData
              * @param bmin[]
              * @param bmax[]
-             * @param navMesh
+             * @param navMeshParams
+             * @param navData
+             * @param navDataSize
              */
             void buildMoveMapTile(uint32 mapID,
                                   uint32 tileX,
@@ -185,7 +283,26 @@ namespace MMAP
                                   MeshData& meshData,
                                   float bmin[3],
                                   float bmax[3],
-                                  dtNavMesh* navMesh);
+                                  const dtNavMeshParams& navMeshParams,
+                                  unsigned char*& navData,
+                                  int& navDataSize);
+
+            /**
+             * @brief adds the tile to the navmesh and writes it to disk, takes ownership of navData
+             *
+             * @param mapID
+             * @param tileX
+             * @param tileY
+             * @param navData
+             * @param navDataSize
+             * @param navMesh
+             */
+            void saveMoveMapTile(uint32 mapID,
+                                 uint32 tileX,
+                                 uint32 tileY,
+                                 unsigned char* navData,
+                                 int navDataSize,
+                                 dtNavMesh* navMesh);
 
             /**
              * @brief
@@ -238,6 +355,10 @@ namespace MMAP
             bool m_bigBaseUnit; /**< TODO */
 
             rcContext* m_rcContext; /**< build performance - not really used for now */
+
+            uint32 m_threads; /**< number of tile worker threads */
+            std::atomic<uint32> m_tilesDone; /**< progress of the current build */
+            uint32 m_tilesTotal; /**< TODO */
     };
 }
 
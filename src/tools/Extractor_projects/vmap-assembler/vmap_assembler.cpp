@@ -24,26 +24,50 @@
 
 #include "TileAssembler.h"
 #include <string>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 
 //=======================================================
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    uint32 threads = 1;
+    bool checkOutput = false;
+
+    if (argc < 3)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [--threads #] [--checkOutput]" << std::endl;
         return 1;
     }
 
+    for (int i = 3; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            int threadCount = atoi(argv[++i]);
+            threads = threadCount > 0 ? uint32(threadCount) : std::thread::hardware_concurrency();
+        }
+        else if (strcmp(argv[i], "--checkOutput") == 0)
+        {
+            checkOutput = true;
+        }
+        else
+        {
+            std::cout << "unknown option " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
     std::string src = argv[1];
     std::string dest = argv[2];
 
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
-    std::cout << "Create TileAssembler " << std::endl;
+    std::cout << "Create TileAssembler using " << threads << " threads" << std::endl;
 
-    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
+    VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest, threads);
+    ta->setCheckOutput(checkOutput);
 
     std::cout << "Convert to World2 " << std::endl;
 